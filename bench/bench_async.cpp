@@ -0,0 +1,124 @@
+/**
+ * @file bench_async.cpp
+ * @brief Load test of QueryExecutor: tail latency of short queries mixed with long ones
+ *
+ * Usage: bench_async [scale] [threads] [seconds]
+ * Builds an R-MAT graph with 2^scale vertices (default 2^16, edge factor 8)
+ * and replays an open-loop workload for the given time (default 2 s) on an
+ * executor with the given number of threads (default: hardware threads):
+ * - a short query every 200 us: the distance from a vertex to one of its neighbors;
+ * - every 500 ms, one full-graph BFS per thread, enough to occupy every thread.
+ * Latency is measured from submission to completion. The workload runs
+ * three times:
+ * - "blocking": queries never yield, like Graph::bfs() on a thread pool;
+ * - "yield": queries yield every 16 vertices;
+ * - "deadline": yield, and the long queries also get a 20 ms deadline.
+ */
+
+#include <algorithm>
+#include <latch>
+#include <string>
+#include <thread>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/async.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// Fire-and-forget coroutine that records when its query completes
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+template<typename T>
+static Detached timeQuery(Query<T> query, Clock::time_point start, double& latencyUs,
+                          QueryStatus& status, std::latch& done) {
+    auto res = co_await query;
+    latencyUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    status = res.status;
+    done.count_down();
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<std::size_t>(p * v.size()))];
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 16);
+    const std::size_t threads = bench::arg(argc, argv, 2, graphlib::hardwareThreads());
+    const std::size_t seconds = bench::arg(argc, argv, 3, 2);
+
+    bench::Reporter rep("async");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("threads", static_cast<double>(threads));
+    rep.param("seconds", static_cast<double>(seconds));
+
+    const Graph<int> g = bench::toGraph(bench::rmat(static_cast<unsigned>(scale), 8, 1));
+    const auto n = static_cast<std::uint64_t>(1) << scale;
+    rep.once("long_query/alone", [&] { bench::keep(g.bfs(0).size()); });
+
+    // Short queries: a vertex and its first neighbor
+    graphlib::Xoshiro256 pick(3);
+    std::vector<std::pair<int, int>> pairs;
+    while (pairs.size() < 4096) {
+        const int u = static_cast<int>(graphlib::boundedRandom(pick, n));
+        if (g.degree(u) > 0) pairs.emplace_back(u, *g.neighbors(u).begin());
+    }
+
+    const auto shortEvery = std::chrono::microseconds(200);
+    const auto longEvery = std::chrono::milliseconds(500);
+    const std::size_t shortCount = seconds * 5000;
+    const std::size_t longCount = seconds * 2 * threads;
+
+    struct Mode {
+        const char* name;
+        std::size_t yieldEvery;
+        bool deadline;
+    };
+    for (const Mode mode : {Mode{"blocking", 0, false}, Mode{"yield", 16, false}, Mode{"deadline", 16, true}}) {
+        QueryExecutor exec({.threads = threads, .queueCapacity = 1 << 16, .yieldEvery = mode.yieldEvery});
+        std::vector<double> shortUs(shortCount), longUs(longCount);
+        std::vector<QueryStatus> shortStatus(shortCount), longStatus(longCount);
+        std::latch done(static_cast<std::ptrdiff_t>(shortCount + longCount));
+        graphlib::Xoshiro256 rng(7);
+
+        const auto begin = Clock::now();
+        std::size_t longSent = 0;
+        for (std::size_t i = 0; i < shortCount; i++) {
+            const auto at = begin + i * shortEvery;
+            while (longSent < longCount && begin + (longSent / threads) * longEvery <= at) {
+                QueryOptions opts;
+                if (mode.deadline) opts.deadline = Clock::now() + std::chrono::milliseconds(20);
+                const int source = static_cast<int>(graphlib::boundedRandom(rng, n));
+                timeQuery(exec.bfs(g, source, 0, opts), Clock::now(), longUs[longSent], longStatus[longSent], done);
+                longSent++;
+            }
+            std::this_thread::sleep_until(at);
+            const auto [u, v] = pairs[i % pairs.size()];
+            timeQuery(exec.distance(g, u, v), Clock::now(), shortUs[i], shortStatus[i], done);
+        }
+        done.wait();
+
+        const std::string prefix = std::string(mode.name) + "/";
+        rep.metric(prefix + "short_p50", percentile(shortUs, 0.50), "us");
+        rep.metric(prefix + "short_p99", percentile(shortUs, 0.99), "us");
+        rep.metric(prefix + "short_max", percentile(shortUs, 1.0), "us");
+        rep.metric(prefix + "long_p50", percentile(longUs, 0.50), "us");
+        rep.metric(prefix + "long_deadline_exceeded",
+                   static_cast<double>(std::count(longStatus.begin(), longStatus.end(), QueryStatus::DeadlineExceeded)),
+                   "queries");
+        rep.metric(prefix + "short_not_ok",
+                   static_cast<double>(std::count_if(shortStatus.begin(), shortStatus.end(),
+                                                     [](QueryStatus s) { return s != QueryStatus::Ok; })),
+                   "queries");
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file bench_bitmatrix.cpp
+ * @brief Adjacency bit matrix versus the hash-set Graph on small dense graphs
+ *
+ * Usage: bench_bitmatrix [vertices] [density percent]
+ * Builds a random graph on n vertices (default 1024) where each pair is an
+ * edge with the given probability (default 50%), in both backends, then
+ * times construction, containsEdge, degree, common neighbors, triangle
+ * counting and BFS. Results are named "<backend>/<operation>", plus
+ * "speedup/<operation>".
+ */
+
+#include <algorithm>
+#include <string>
+#include "bench/harness.hpp"
+#include "graphlib.hpp"
+#include "graphlib/bitmatrix.hpp"
+#include "graphlib/random.hpp"
+
+using Id = BitMatrixGraph::Id;
+
+// Triangles u < v < w of a hash-set graph, scanning the smaller neighbor set of each edge
+static std::uint64_t hashTriangles(const Graph<int>& g) {
+    std::uint64_t total = 0;
+    for (int u : g) {
+        for (int v : g.neighbors(u)) {
+            if (v <= u) continue;
+            const auto& a = g.neighbors(u);
+            const auto& b = g.neighbors(v);
+            const auto& small = a.size() < b.size() ? a : b;
+            const auto& large = a.size() < b.size() ? b : a;
+            for (int w : small) total += w > v && large.contains(w);
+        }
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::arg(argc, argv, 1, 1024);
+    const std::size_t density = bench::arg(argc, argv, 2, 50);
+
+    bench::Reporter rep("bitmatrix");
+    rep.param("vertices", static_cast<double>(n));
+    rep.param("density_percent", static_cast<double>(density));
+
+    graphlib::Xoshiro256 rng(5);
+    std::vector<std::pair<Id, Id>> edges;
+    for (Id u = 0; u < n; u++) {
+        for (Id v = u + 1; v < n; v++) {
+            if (graphlib::boundedRandom(rng, 100) < density) edges.emplace_back(u, v);
+        }
+    }
+    std::shuffle(edges.begin(), edges.end(), rng);
+    rep.metric("edges", static_cast<double>(edges.size()), "edges");
+
+    Graph<int> hashed;
+    BitMatrixGraph matrix(n);
+    const double hashBuild = rep.once("hash/build", [&] {
+        for (const auto& [u, v] : edges) hashed.addEdge(static_cast<int>(u), static_cast<int>(v));
+    });
+    const double matrixBuild = rep.once("matrix/build", [&] {
+        for (const auto& [u, v] : edges) matrix.addEdge(u, v);
+    });
+    rep.metric("speedup/build", hashBuild / matrixBuild, "x");
+    rep.metric("hash/memory", static_cast<double>(hashed.memoryUsage().total()), "bytes");
+    rep.metric("matrix/memory", static_cast<double>(matrix.memoryUsage()), "bytes");
+
+    const std::size_t queries = 1 << 20;
+    std::vector<Id> probe(queries + 1);
+    for (auto& v : probe) v = static_cast<Id>(graphlib::boundedRandom(rng, n));
+    auto at = [&](std::size_t i) { return probe[i & (queries - 1)]; };
+    std::size_t sink = 0;
+
+    auto compare = [&](const std::string& name, std::size_t ops, auto&& hashFn, auto&& matrixFn) {
+        const double h = rep.run("hash/" + name, ops, hashFn);
+        const double m = rep.run("matrix/" + name, ops, matrixFn);
+        rep.metric("speedup/" + name, m / h, "x");
+    };
+    compare("containsEdge", queries,
+            [&](std::size_t i) { sink += hashed.containsEdge(static_cast<int>(at(i)), static_cast<int>(at(i + 1))); },
+            [&](std::size_t i) { sink += matrix.containsEdge(at(i), at(i + 1)); });
+    compare("degree", queries,
+            [&](std::size_t i) { sink += hashed.degree(static_cast<int>(at(i))); },
+            [&](std::size_t i) { sink += matrix.degree(at(i)); });
+    compare("commonNeighbors", queries / 16,
+            [&](std::size_t i) {
+                const auto& b = hashed.neighbors(static_cast<int>(at(i + 1)));
+                for (int w : hashed.neighbors(static_cast<int>(at(i)))) sink += b.contains(w);
+            },
+            [&](std::size_t i) { sink += matrix.commonNeighbors(at(i), at(i + 1)); });
+    compare("bfs", 16,
+            [&](std::size_t i) { sink += hashed.bfs(static_cast<int>(at(i))).size(); },
+            [&](std::size_t i) { sink += matrix.bfs(at(i)).size(); });
+
+    std::uint64_t hashCount = 0, matrixCount = 0;
+    const double hashTri = rep.once("hash/triangles", [&] { hashCount = hashTriangles(hashed); });
+    const double matrixTri = rep.once("matrix/triangles", [&] { matrixCount = matrix.countTriangles(); });
+    if (hashCount != matrixCount) return 1;
+    rep.metric("triangles", static_cast<double>(matrixCount), "triangles");
+    rep.metric("speedup/triangles", hashTri / matrixTri, "x");
+
+    bench::keep(sink);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file bench_centrality.cpp
+ * @brief Exact versus sampled betweenness: running time and accuracy
+ *
+ * Usage: bench_centrality [scale] [edge factor] [samples] [exact scale]
+ * Exact betweenness costs one BFS per vertex, out of reach on a 2^20-vertex
+ * graph, so accuracy is measured on an R-MAT graph with 2^exactScale
+ * vertices (default 2^14): exact and closeness time, then the sampled
+ * estimate with 64, 256 and 1024 sources, scored by the overlap of its top
+ * 100 vertices with the exact top 100 and by their mean relative error.
+ * On the large R-MAT graph (default 2^20 vertices, edgeFactor 8) the
+ * sampled estimate runs with `samples` and 4 * samples sources (default
+ * 64); the exact time is extrapolated from the time per source, and the two
+ * estimates are compared with each other.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/centrality.hpp"
+
+// Ids of the k largest values
+static std::vector<std::uint32_t> topIds(const std::vector<double>& values, std::size_t k) {
+    std::vector<std::uint32_t> ids(values.size());
+    for (std::uint32_t v = 0; v < ids.size(); v++) ids[v] = v;
+    k = std::min(k, ids.size());
+    std::partial_sort(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(k), ids.end(),
+                      [&](std::uint32_t a, std::uint32_t b) { return values[a] > values[b]; });
+    ids.resize(k);
+    return ids;
+}
+
+static double topOverlap(const std::vector<double>& a, const std::vector<double>& b, std::size_t k) {
+    auto x = topIds(a, k), y = topIds(b, k);
+    std::sort(x.begin(), x.end());
+    std::sort(y.begin(), y.end());
+    std::vector<std::uint32_t> common;
+    std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(common));
+    return static_cast<double>(common.size()) / static_cast<double>(std::max<std::size_t>(x.size(), 1));
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 20);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+    const std::size_t samples = bench::arg(argc, argv, 3, 64);
+    const std::size_t exactScale = bench::arg(argc, argv, 4, 14);
+
+    bench::Reporter rep("centrality");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+    rep.param("samples", static_cast<double>(samples));
+    rep.param("exact_scale", static_cast<double>(exactScale));
+    rep.param("threads", static_cast<double>(graphlib::hardwareThreads()));
+
+    const bench::EdgeList smallList = bench::rmat(static_cast<unsigned>(exactScale), edgeFactor, 1);
+    const auto small = CSRGraph<int>::fromEdgeList(smallList.n, smallList.edges);
+    std::vector<double> exact, closeness;
+    const double exactTime = rep.once("small/exact", [&] { exact = betweennessCentrality(small); });
+    rep.once("small/closeness", [&] { closeness = closenessCentrality(small); });
+    bench::keep(closeness);
+
+    const auto exactTop = topIds(exact, 100);
+    for (std::size_t k : {64, 256, 1024}) {
+        const std::string key = "small/sampled_" + std::to_string(k);
+        std::vector<double> approx;
+        const double t = rep.once(key + "/time", [&] { approx = approximateBetweenness(small, k, 1); });
+        rep.metric(key + "/speedup", exactTime / t, "x");
+        rep.metric(key + "/top100_overlap", topOverlap(exact, approx, 100), "ratio");
+        double error = 0;
+        for (std::uint32_t v : exactTop) error += std::abs(approx[v] - exact[v]) / exact[v];
+        rep.metric(key + "/top100_rel_error", error / static_cast<double>(exactTop.size()), "ratio");
+    }
+
+    const bench::EdgeList largeList = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+    const auto large = CSRGraph<int>::fromEdgeList(largeList.n, largeList.edges);
+    std::vector<double> coarse, fine;
+    const double coarseTime = rep.once("large/sampled_" + std::to_string(samples), [&] {
+        coarse = approximateBetweenness(large, samples, 1);
+    });
+    rep.once("large/sampled_" + std::to_string(4 * samples), [&] { fine = approximateBetweenness(large, 4 * samples, 2); });
+    const double perSource = coarseTime / static_cast<double>(std::max<std::size_t>(samples, 1));
+    rep.metric("large/time_per_source", perSource, "s");
+    rep.metric("large/exact_estimate", perSource * static_cast<double>(large.countVertices()), "s");
+    rep.metric("large/top100_overlap", topOverlap(coarse, fine, 100), "ratio");
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file bench_coloring.cpp
+ * @brief Greedy, Jones-Plassmann and Luby MIS: colors used and scaling across threads
+ *
+ * Usage: bench_coloring [scale] [edge factor]
+ * Runs on R-MAT and Erdos-Renyi graphs with 2^scale vertices (default 2^20)
+ * and edgeFactor * 2^scale edges (default 8), with 1, 2, 4, ... threads up
+ * to the number of hardware threads.
+ */
+
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/coloring.hpp"
+
+static void benchColoring(bench::Reporter& rep, const std::string& name, const bench::EdgeList& list) {
+    auto key = [&](const std::string& what) { return name + "/" + what; };
+    const auto g = CSRGraph<int>::fromEdgeList(list.n, list.edges);
+    auto colorsUsed = [](const std::vector<Color>& c) { return static_cast<double>(*std::max_element(c.begin(), c.end()) + 1); };
+
+    const std::pair<const char*, ColoringOrder> orders[] = {
+        {"natural", ColoringOrder::Natural}, {"largest_first", ColoringOrder::LargestFirst}, {"smallest_last", ColoringOrder::SmallestLast}};
+    for (const auto& [label, kind] : orders) {
+        std::vector<Color> colors;
+        rep.once(key(std::string("greedy/") + label), [&] { colors = greedyColoring(g, kind); });
+        rep.metric(key(std::string("greedy/") + label + "/colors"), colorsUsed(colors), "colors");
+    }
+
+    double coloringBase = 0, misBase = 0;
+    for (std::size_t threads = 1; threads <= graphlib::hardwareThreads(); threads *= 2) {
+        const std::string t = "/threads" + std::to_string(threads);
+        std::vector<Color> colors;
+        const double coloring = rep.once(key("jones_plassmann" + t), [&] { colors = parallelColoring(g, 1, threads); });
+        std::size_t size = 0;
+        const double mis = rep.once(key("luby_mis" + t), [&] { size = maximalIndependentSet(g, 1, threads).size(); });
+        if (threads == 1) {
+            coloringBase = coloring;
+            misBase = mis;
+            rep.metric(key("jones_plassmann/colors"), colorsUsed(colors), "colors");
+            rep.metric(key("luby_mis/size"), static_cast<double>(size), "vertices");
+        }
+        rep.metric(key("jones_plassmann" + t + "/speedup"), coloringBase / coloring, "x");
+        rep.metric(key("luby_mis" + t + "/speedup"), misBase / mis, "x");
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 20);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+
+    bench::Reporter rep("coloring");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+    rep.param("hardware_threads", static_cast<double>(graphlib::hardwareThreads()));
+
+    const std::size_t n = std::size_t{1} << scale;
+    benchColoring(rep, "rmat", bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1));
+    benchColoring(rep, "erdos_renyi", bench::erdosRenyi(n, n * edgeFactor, 1));
+    return 0;
+}
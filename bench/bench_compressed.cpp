@@ -0,0 +1,95 @@
+/**
+ * @file bench_compressed.cpp
+ * @brief Footprint and traversal throughput of CompressedGraph versus CSRGraph
+ *
+ * Usage: bench_compressed [scale] [edge factor]
+ * Builds R-MAT and Erdos-Renyi graphs with 2^scale vertices (default 2^20)
+ * and edgeFactor * 2^scale edges (default 16).
+ */
+
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/compressed.hpp"
+
+using Id = CSRGraph<int>::Id;
+
+// Same traversal as CompressedGraph::bfsById, on the uncompressed lists
+static std::size_t csrBfs(const CSRGraph<int>& g, Id source) {
+    std::vector<Id> order{source};
+    std::vector<bool> seen(g.countVertices(), false);
+    seen[source] = true;
+    for (std::size_t head = 0; head < order.size(); head++) {
+        for (Id w : g.neighbors(order[head])) {
+            if (!seen[w]) {
+                seen[w] = true;
+                order.push_back(w);
+            }
+        }
+    }
+    return order.size();
+}
+
+static void benchCompressed(bench::Reporter& rep, const std::string& name, const bench::EdgeList& list) {
+    auto key = [&](const std::string& what) { return name + "/" + what; };
+    const auto csr = CSRGraph<int>::fromEdgeList(list.n, list.edges);
+    std::optional<CompressedGraph<int>> built;
+    rep.once(key("compressed/build"), [&] { built.emplace(csr); });
+    const CompressedGraph<int>& cg = *built;
+
+    const double m = static_cast<double>(csr.countEdges());
+    const double csrAdjacency = static_cast<double>((csr.countVertices() + 1) * sizeof(std::size_t) + 2 * csr.countEdges() * sizeof(Id));
+    rep.metric(key("csr/bytes_per_edge"), csrAdjacency / m, "bytes");
+    rep.metric(key("compressed/bytes_per_edge"), cg.bytesPerEdge(), "bytes");
+    rep.metric(key("compression_ratio"), csrAdjacency / cg.adjacencyBytes(), "x");
+
+    graphlib::Xoshiro256 rng(3);
+    const std::size_t queries = 1 << 20;
+    std::vector<Id> probe(queries);
+    for (auto& v : probe) v = static_cast<Id>(graphlib::boundedRandom(rng, list.n));
+
+    // The vertex of maximum degree, the longest list containsEdge can search
+    Id hub = 0;
+    for (Id v = 1; v < csr.countVertices(); v++) {
+        if (csr.degree(v) > csr.degree(hub)) hub = v;
+    }
+    rep.metric(key("hub_degree"), static_cast<double>(csr.degree(hub)), "neighbors");
+
+    std::size_t sink = 0;
+    rep.run(key("csr/degree"), queries, [&](std::size_t i) { sink += csr.degree(probe[i]); });
+    rep.run(key("compressed/degree"), queries, [&](std::size_t i) { sink += cg.degree(probe[i]); });
+    rep.run(key("csr/containsEdge"), queries, [&](std::size_t i) { sink += csr.containsEdge(probe[i], probe[i ^ 1]); });
+    rep.run(key("compressed/containsEdge"), queries, [&](std::size_t i) { sink += cg.containsEdge(probe[i], probe[i ^ 1]); });
+    rep.run(key("csr/containsEdge/hub"), queries, [&](std::size_t i) { sink += csr.containsEdge(hub, probe[i]); });
+    rep.run(key("compressed/containsEdge/hub"), queries, [&](std::size_t i) { sink += cg.containsEdge(hub, probe[i]); });
+    rep.run(key("csr/neighbors"), queries, [&](std::size_t i) {
+        for (Id w : csr.neighbors(probe[i])) sink += w;
+    });
+    rep.run(key("compressed/neighbors"), queries, [&](std::size_t i) {
+        for (Id w : cg.neighbors(probe[i])) sink += w;
+    });
+    rep.run(key("compressed/forEachNeighbor"), queries, [&](std::size_t i) {
+        cg.forEachNeighbor(probe[i], [&](Id w) { sink += w; });
+    });
+
+    // Full traversals from a few sources; the first one also warms the caches
+    double csrRate = rep.run(key("csr/bfs"), 4, [&](std::size_t i) { sink += csrBfs(csr, probe[i]); });
+    double cgRate = rep.run(key("compressed/bfs"), 4, [&](std::size_t i) { sink += cg.bfsById(probe[i]).size(); });
+    rep.metric(key("csr/bfs_edges_per_sec"), 2 * m * csrRate, "1/s");
+    rep.metric(key("compressed/bfs_edges_per_sec"), 2 * m * cgRate, "1/s");
+    bench::keep(sink);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 20);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 16);
+    const std::size_t n = std::size_t{1} << scale;
+
+    bench::Reporter rep("compressed");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+
+    benchCompressed(rep, "rmat", bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1));
+    benchCompressed(rep, "erdos_renyi", bench::erdosRenyi(n, n * edgeFactor, 1));
+    return 0;
+}
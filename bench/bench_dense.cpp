@@ -0,0 +1,88 @@
+/**
+ * @file bench_dense.cpp
+ * @brief Per-operation throughput of DenseGraph versus Graph<int> on the same ids
+ *
+ * Usage: bench_dense [scale] [edge factor]
+ * Builds an R-MAT graph with 2^scale vertices (default 2^17, at most 2^20,
+ * the capacity of the DenseGraph) and edgeFactor * 2^scale edges (default
+ * 8) in both graphs, then times the same operations on each. Results are
+ * named "<graph>/<method>", plus "speedup/<method>".
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/dense.hpp"
+
+static constexpr std::size_t capacity = std::size_t{1} << 20;
+
+// Times every method on g and returns the throughput of each, in the order of `methods`
+template<typename G>
+static std::vector<double> benchGraph(bench::Reporter& rep, const std::string& name, G& g, const bench::EdgeList& list) {
+    const std::size_t n = list.n;
+    const std::size_t m = list.edges.size();
+    auto key = [&](const char* method) { return name + "/" + method; };
+
+    graphlib::Xoshiro256 rng(42);
+    const std::size_t queries = 1 << 20;
+    std::vector<int> probe(queries);
+    for (auto& v : probe) v = static_cast<int>(graphlib::boundedRandom(rng, n));
+    auto at = [&](std::size_t i) { return probe[i & (queries - 1)]; };
+    auto edgeAt = [&](std::size_t i) { return list.edges[(i * 0x9e3779b97f4a7c15ULL) % m]; };
+
+    std::vector<double> res;
+    std::size_t sink = 0;
+    res.push_back(rep.run(key("addVertex"), n, [&](std::size_t i) { g.addVertex(static_cast<int>(i)); }));
+    res.push_back(rep.run(key("addEdge"), m, [&](std::size_t i) {
+        g.addEdge(static_cast<int>(list.edges[i].first), static_cast<int>(list.edges[i].second));
+    }));
+    res.push_back(rep.run(key("containsVertex/hit"), queries, [&](std::size_t i) { sink += g.containsVertex(at(i)); }));
+    res.push_back(rep.run(key("containsVertex/miss"), queries, [&](std::size_t i) {
+        sink += g.containsVertex(static_cast<int>(n) + at(i));
+    }));
+    res.push_back(rep.run(key("containsEdge/hit"), queries, [&](std::size_t i) {
+        const auto [u, v] = edgeAt(i);
+        sink += g.containsEdge(static_cast<int>(u), static_cast<int>(v));
+    }));
+    res.push_back(rep.run(key("containsEdge/random"), queries, [&](std::size_t i) { sink += g.containsEdge(at(i), at(i + 1)); }));
+    res.push_back(rep.run(key("degree"), queries, [&](std::size_t i) { sink += g.degree(at(i)); }));
+    res.push_back(rep.run(key("neighbors"), queries, [&](std::size_t i) {
+        for (int w : g.neighbors(at(i))) sink += static_cast<std::size_t>(w);
+    }));
+    res.push_back(rep.run(key("countEdges"), 16, [&](std::size_t) { sink += g.countEdges(); }));
+    res.push_back(rep.run(key("bfs"), 8, [&](std::size_t i) { sink += g.bfs(at(i)).size(); }));
+    res.push_back(rep.run(key("distance"), 32, [&](std::size_t i) { sink += g.distance(at(2 * i), at(2 * i + 1)).value_or(-1); }));
+    res.push_back(rep.run(key("removeEdge"), m / 2, [&](std::size_t i) {
+        g.removeEdge(static_cast<int>(list.edges[i].first), static_cast<int>(list.edges[i].second));
+    }));
+    res.push_back(rep.run(key("removeVertex"), n / 2, [&](std::size_t i) { g.removeVertex(static_cast<int>(i)); }));
+    bench::keep(sink);
+    return res;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = std::min<std::size_t>(bench::arg(argc, argv, 1, 17), 20);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+
+    bench::Reporter rep("dense");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+    rep.param("capacity", static_cast<double>(capacity));
+
+    const auto list = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+
+    Graph<int> hashed;
+    const auto hashedOps = benchGraph(rep, "graph", hashed, list);
+    auto dense = std::make_unique<DenseGraph<capacity>>();
+    const auto denseOps = benchGraph(rep, "dense", *dense, list);
+
+    const char* methods[] = {"addVertex", "addEdge", "containsVertex/hit", "containsVertex/miss", "containsEdge/hit",
+                             "containsEdge/random", "degree", "neighbors", "countEdges", "bfs", "distance",
+                             "removeEdge", "removeVertex"};
+    for (std::size_t k = 0; k < hashedOps.size(); k++) {
+        rep.metric(std::string("speedup/") + methods[k], denseOps[k] / hashedOps[k], "x");
+    }
+    return 0;
+}
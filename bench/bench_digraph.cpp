@@ -0,0 +1,60 @@
+/**
+ * @file bench_digraph.cpp
+ * @brief Construction and traversals of DiGraph with and without the in-edge index
+ *
+ * Usage: bench_digraph [scale] [edge factor]
+ * Builds a directed R-MAT graph with 2^scale vertices (default 2^18) and
+ * edgeFactor * 2^scale edges (default 8). "bench_digraph 22 12" gives the
+ * 50M-edge configuration; it needs about 4 GB of memory.
+ */
+
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/digraph.hpp"
+
+template<bool InEdges>
+static void benchDiGraph(bench::Reporter& rep, const std::string& name, const bench::EdgeList& list) {
+    auto key = [&](const char* what) { return name + "/" + what; };
+    graphlib::Xoshiro256 rng(7);
+    const std::size_t queries = 1 << 20;
+    std::vector<int> probe(queries);
+    for (auto& v : probe) v = static_cast<int>(graphlib::boundedRandom(rng, list.n));
+    auto at = [&](std::size_t i) { return probe[i & (queries - 1)]; };
+
+    DiGraph<int, std::hash<int>, InEdges> g;
+    for (std::size_t v = 0; v < list.n; v++) g.addVertex(static_cast<int>(v));
+    rep.run(key("addEdge"), list.edges.size(), [&](std::size_t i) {
+        g.addEdge(static_cast<int>(list.edges[i].first), static_cast<int>(list.edges[i].second));
+    });
+
+    std::size_t sink = 0;
+    rep.run(key("containsEdge"), queries, [&](std::size_t i) { sink += g.containsEdge(at(i), at(i + 1)); });
+    rep.run(key("outNeighbors"), queries, [&](std::size_t i) {
+        for (int w : g.outNeighbors(at(i))) sink += w;
+    });
+    if constexpr (InEdges) {
+        rep.run(key("inNeighbors"), queries, [&](std::size_t i) {
+            for (int w : g.inNeighbors(at(i))) sink += w;
+        });
+    }
+    rep.run(key("bfs"), 4, [&](std::size_t i) { sink += g.bfs(at(i)).size(); });
+    rep.run(key("distance"), 16, [&](std::size_t i) { sink += g.distance(at(2 * i), at(2 * i + 1)).value_or(-1); });
+    rep.run(key("stronglyConnectedComponents"), 1, [&](std::size_t) { sink += g.stronglyConnectedComponents().size(); });
+    rep.run(key("removeVertex"), InEdges ? 1 << 14 : 16, [&](std::size_t i) { g.removeVertex(at(i)); });
+    bench::keep(sink);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 18);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+
+    bench::Reporter rep("digraph");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+
+    const auto list = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+    benchDiGraph<true>(rep, "in_out", list);
+    benchDiGraph<false>(rep, "out_only", list);
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file bench_distance_oracle.cpp
+ * @brief Build time, memory and query latency of the distance oracles versus Graph::distance
+ *
+ * Usage: bench_distance_oracle [vertices] [edges per new vertex] [landmarks]
+ * The graph is grown by preferential attachment (power-law degrees).
+ */
+
+#include <optional>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/distance_oracle.hpp"
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::arg(argc, argv, 1, 30000);
+    const std::size_t attach = bench::arg(argc, argv, 2, 4);
+    const std::size_t landmarks = bench::arg(argc, argv, 3, 16);
+
+    bench::Reporter rep("distance_oracle");
+    rep.param("vertices", static_cast<double>(n));
+    rep.param("attach", static_cast<double>(attach));
+    rep.param("landmarks", static_cast<double>(landmarks));
+
+    Graph<int> g = bench::toGraph(bench::barabasiAlbert(n, attach, 1));
+
+    std::optional<CSRGraph<int>> csr;
+    std::optional<LandmarkOracle<int>> oracle;
+    std::optional<PrunedLandmarkLabeling<int>> pll;
+    rep.once("csr/build", [&] { csr.emplace(g); });
+    rep.once("landmark/build", [&] { oracle.emplace(*csr, landmarks); });
+    rep.once("pll/build", [&] { pll.emplace(*csr); });
+    rep.metric("csr/memory", static_cast<double>(csr->memoryBytes()), "bytes");
+    rep.metric("landmark/memory", static_cast<double>(oracle->memoryBytes()), "bytes");
+    rep.metric("pll/memory", static_cast<double>(pll->memoryBytes()), "bytes");
+    rep.metric("pll/label_size", pll->averageLabelSize(), "entries/vertex");
+
+    graphlib::Xoshiro256 rng(2);
+    const std::size_t queries = 1 << 16;
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& p : pairs) {
+        p = {static_cast<int>(graphlib::boundedRandom(rng, n)), static_cast<int>(graphlib::boundedRandom(rng, n))};
+    }
+
+    long long checksum = 0;
+    rep.run("graph/distance", 200, [&](std::size_t i) {
+        const auto& [u, v] = pairs[i];
+        checksum += g.distance(u, v).value_or(-1);
+    });
+    rep.run("landmark/approxDistance", 10 * queries, [&](std::size_t i) {
+        const auto& [u, v] = pairs[i % queries];
+        checksum += oracle->approxDistance(u, v)->upper.value_or(-1);
+    });
+    rep.run("pll/distance", 10 * queries, [&](std::size_t i) {
+        const auto& [u, v] = pairs[i % queries];
+        checksum += pll->distance(u, v).value_or(-1);
+    });
+    bench::keep(checksum);
+
+    double stretch = 0;
+    for (const auto& [u, v] : pairs) {
+        if (u != v) stretch += static_cast<double>(*oracle->approxDistance(u, v)->upper) / *pll->distance(u, v);
+    }
+    rep.metric("landmark/mean_stretch", stretch / queries, "x");
+    return 0;
+}
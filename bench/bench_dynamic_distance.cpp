@@ -0,0 +1,50 @@
+/**
+ * @file bench_dynamic_distance.cpp
+ * @brief Update latency of DynamicDistance versus recomputing with a full BFS
+ *
+ * Usage: bench_dynamic_distance [vertices] [edges] [updates]
+ */
+
+#include <optional>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/dynamic_distance.hpp"
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::arg(argc, argv, 1, 200000);
+    const std::size_t m = bench::arg(argc, argv, 2, 1000000);
+    const std::size_t updates = bench::arg(argc, argv, 3, 20000);
+
+    bench::Reporter rep("dynamic_distance");
+    rep.param("vertices", static_cast<double>(n));
+    rep.param("edges", static_cast<double>(m));
+    rep.param("updates", static_cast<double>(updates));
+
+    Graph<int> g = bench::toGraph(bench::erdosRenyi(n, m, 1));
+    graphlib::Xoshiro256 rng(2);
+    auto pick = [&] { return static_cast<int>(graphlib::boundedRandom(rng, n)); };
+
+    std::optional<DynamicDistance<int>> dd;
+    double rebuild = rep.once("full_rebuild", [&] { dd.emplace(g, 0); });
+
+    // Half insertions of random edges, half deletions of existing ones
+    double rate = rep.run("incremental_update", updates, [&](std::size_t i) {
+        if (i % 2 == 0) {
+            g.addEdge(pick(), pick());
+        } else {
+            int u = pick();
+            const auto& nbrs = g.neighbors(u);
+            if (!nbrs.empty()) g.removeEdge(u, *nbrs.begin());
+        }
+    });
+    rep.metric("speedup_vs_rebuild", rebuild * rate, "x");
+
+    // Sanity check against a fresh BFS on a few vertices
+    for (int v = 0; v < 100; v++) {
+        if (dd->distanceFromSource(v) != g.distance(0, v)) {
+            std::cerr << "MISMATCH at vertex " << v << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
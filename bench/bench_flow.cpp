@@ -0,0 +1,77 @@
+/**
+ * @file bench_flow.cpp
+ * @brief Max-flow / min-cut on large synthetic grids and random graphs
+ *
+ * Usage: bench_flow [grid side] [random vertices] [random edge factor]
+ * - grid: a side x side grid (default 400 x 400) with random capacities
+ *   in [1, 100], plus a source linked to the whole left column and a sink
+ *   linked to the whole right column;
+ * - random: Erdos-Renyi with n vertices (default 2^20) and edgeFactor * n
+ *   edges (default 8), capacities in [1, 100], between two random vertices
+ *   of degree >= edgeFactor.
+ * Push-relabel and Dinic are timed on the same network and must agree.
+ */
+
+#include <memory>
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/flow.hpp"
+
+using Cap = std::int64_t;
+
+static Cap randomCapacity(int u, int v) {
+    const auto a = static_cast<std::uint64_t>(std::min(u, v)), b = static_cast<std::uint64_t>(std::max(u, v));
+    return 1 + static_cast<Cap>(graphlib::hashMix(a * 0x9e3779b97f4a7c15ULL + b) % 100);
+}
+
+// Times both algorithms and the cut from s to t; returns false if they disagree
+static bool runBoth(bench::Reporter& rep, const std::string& name, const Graph<int>& g, int s, int t,
+                    const auto& capacity) {
+    std::unique_ptr<FlowNetwork<int>> net;
+    rep.once(name + "/build", [&] { net = std::make_unique<FlowNetwork<int>>(g, capacity); });
+    Cap pushRelabel = 0, dinic = 0;
+    const double prTime = rep.once(name + "/push_relabel", [&] { pushRelabel = net->maxFlow(s, t); });
+    const double dinicTime = rep.once(name + "/dinic", [&] { dinic = net->maxFlow(s, t, FlowAlgorithm::Dinic); });
+    MinCut<int, Cap> cut;
+    rep.once(name + "/min_cut", [&] { cut = net->minCut(s, t); });
+    rep.metric(name + "/flow", static_cast<double>(pushRelabel), "capacity");
+    rep.metric(name + "/cut_edges", static_cast<double>(cut.edges.size()), "edges");
+    rep.metric(name + "/speedup_push_relabel", dinicTime / prTime, "x");
+    return pushRelabel == dinic && cut.value == dinic;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t side = bench::arg(argc, argv, 1, 400);
+    const std::size_t n = bench::arg(argc, argv, 2, std::size_t{1} << 20);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 3, 8);
+
+    bench::Reporter rep("flow");
+    rep.param("grid_side", static_cast<double>(side));
+    rep.param("random_vertices", static_cast<double>(n));
+    rep.param("random_edge_factor", static_cast<double>(edgeFactor));
+
+    // Grid with a super source on the left column and a super sink on the right one
+    Graph<int> grid = bench::toGraph(bench::grid2d(side, side));
+    const int source = static_cast<int>(side * side), sink = source + 1;
+    for (std::size_t y = 0; y < side; y++) {
+        grid.addEdge(source, static_cast<int>(y * side));
+        grid.addEdge(sink, static_cast<int>(y * side + side - 1));
+    }
+    auto gridCapacity = [&](int u, int v) {
+        return (u >= source || v >= source) ? Cap{1} << 40 : randomCapacity(u, v);
+    };
+    if (!runBoth(rep, "grid", grid, source, sink, gridCapacity)) return 1;
+
+    const Graph<int> random = bench::toGraph(bench::erdosRenyi(n, edgeFactor * n, 1));
+    graphlib::Xoshiro256 rng(9);
+    auto pick = [&] {
+        for (;;) {
+            const int v = static_cast<int>(graphlib::boundedRandom(rng, n));
+            if (random.containsVertex(v) && random.degree(v) >= edgeFactor) return v;
+        }
+    };
+    const int s = pick(), t = pick();
+    if (!runBoth(rep, "random", random, s, t, randomCapacity)) return 1;
+    return 0;
+}
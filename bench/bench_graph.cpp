@@ -0,0 +1,112 @@
+/**
+ * @file bench_graph.cpp
+ * @brief Throughput and latency of every public Graph method on synthetic graphs
+ *
+ * Usage: bench_graph [scale] [edge factor]
+ * Each generator builds a graph with about 2^scale vertices and
+ * edgeFactor * 2^scale edges (defaults: 2^17 vertices, 8 edges per vertex).
+ * Results are named "<generator>/<method>". "bfs/reference" is the BFS as
+ * it was before traversal statistics, to compare against the plain bfs.
+ */
+
+#include <cmath>
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+
+// The BFS as it was before instrumentation, the baseline for the plain bfs
+static std::vector<int> referenceBfs(const Graph<int>& g, int v) {
+    std::vector<int> result;
+    std::unordered_set<int> seen;
+    std::queue<int> pending;
+    pending.push(v);
+    seen.insert(v);
+    while (!pending.empty()) {
+        int current = pending.front();
+        pending.pop();
+        result.emplace_back(current);
+        for (int next : g.neighbors(current)) {
+            if (seen.insert(next).second) pending.push(next);
+        }
+    }
+    return result;
+}
+
+static void benchGraph(bench::Reporter& rep, const std::string& name, const bench::EdgeList& list) {
+    const std::size_t n = list.n;
+    const std::size_t m = list.edges.size();
+    auto key = [&](const char* method) { return name + "/" + method; };
+
+    // Query inputs, drawn once so every method sees the same vertices
+    graphlib::Xoshiro256 rng(42);
+    const std::size_t queries = 1 << 20;
+    std::vector<int> probe(queries);
+    for (auto& v : probe) v = static_cast<int>(graphlib::boundedRandom(rng, n));
+    auto at = [&](std::size_t i) { return probe[i & (queries - 1)]; };
+    auto edgeAt = [&](std::size_t i) { return list.edges[(i * 0x9e3779b97f4a7c15ULL) % m]; };
+
+    Graph<int> g;
+    rep.run(key("addVertex"), n, [&](std::size_t i) { g.addVertex(static_cast<int>(i)); });
+    rep.run(key("addEdge"), m, [&](std::size_t i) {
+        const auto& [u, v] = list.edges[i];
+        g.addEdge(static_cast<int>(u), static_cast<int>(v));
+    });
+
+    const MemoryUsage usage = g.memoryUsage();
+    rep.metric(key("memory/total"), static_cast<double>(usage.total()), "bytes");
+    rep.metric(key("memory/adjacency_buckets"), static_cast<double>(usage.adjacencyBuckets), "bytes");
+
+    std::size_t sink = 0;
+    rep.run(key("containsVertex/hit"), queries, [&](std::size_t i) { sink += g.containsVertex(at(i)); });
+    rep.run(key("containsVertex/miss"), queries, [&](std::size_t i) { sink += g.containsVertex(-1 - at(i)); });
+    rep.run(key("containsEdge/hit"), queries, [&](std::size_t i) {
+        const auto [u, v] = edgeAt(i);
+        sink += g.containsEdge(static_cast<int>(u), static_cast<int>(v));
+    });
+    rep.run(key("containsEdge/random"), queries, [&](std::size_t i) { sink += g.containsEdge(at(i), at(i + 1)); });
+    rep.run(key("degree"), queries, [&](std::size_t i) { sink += g.degree(at(i)); });
+    rep.run(key("neighbors"), queries, [&](std::size_t i) { sink += g.neighbors(at(i)).size(); });
+    rep.run(key("closedNeighbors"), queries / 16, [&](std::size_t i) { sink += g.closedNeighbors(at(i)).size(); });
+    rep.run(key("countVertices"), queries, [&](std::size_t) { sink += g.countVertices(); });
+    rep.run(key("countEdges"), 16, [&](std::size_t) { sink += g.countEdges(); });
+    rep.run(key("maxDegree"), 16, [&](std::size_t) { sink += g.maxDegree(); });
+    rep.run(key("iterate"), 16, [&](std::size_t) {
+        for (int v : g) sink += v;
+    });
+    rep.run(key("vertices"), 4, [&](std::size_t) { sink += g.vertices().size(); });
+    rep.run(key("edges"), 2, [&](std::size_t) { sink += g.edges().size(); });
+    rep.run(key("toDot"), 2, [&](std::size_t) { sink += g.toDot().size(); });
+    rep.run(key("bfs"), 8, [&](std::size_t i) { sink += g.bfs(at(i)).size(); });
+    rep.run(key("bfs/reference"), 8, [&](std::size_t i) { sink += referenceBfs(g, at(i)).size(); });
+    rep.run(key("bfs/bounded1000"), 64, [&](std::size_t i) { sink += g.bfs(at(i), 1000).size(); });
+    rep.run(key("distance"), 32, [&](std::size_t i) { sink += g.distance(at(2 * i), at(2 * i + 1)).value_or(-1); });
+
+    Graph<int> copy = g;
+    rep.run(key("removeEdge"), m / 2, [&](std::size_t i) {
+        const auto& [u, v] = list.edges[i];
+        copy.removeEdge(static_cast<int>(u), static_cast<int>(v));
+    });
+    rep.run(key("removeVertex"), n / 2, [&](std::size_t i) { copy.removeVertex(static_cast<int>(i)); });
+    std::size_t released = 0;
+    rep.once(key("shrinkToFit"), [&] { released = copy.shrinkToFit(); });
+    rep.metric(key("shrinkToFit/released"), static_cast<double>(released), "bytes");
+    rep.run(key("clear"), 1, [&](std::size_t) { g.clear(); });
+    bench::keep(sink);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 17);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+    const std::size_t n = std::size_t{1} << scale;
+    const std::size_t side = static_cast<std::size_t>(std::sqrt(static_cast<double>(n)));
+
+    bench::Reporter rep("graph");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+
+    benchGraph(rep, "erdos_renyi", bench::erdosRenyi(n, n * edgeFactor, 1));
+    benchGraph(rep, "rmat", bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1));
+    benchGraph(rep, "barabasi_albert", bench::barabasiAlbert(n, edgeFactor, 1));
+    benchGraph(rep, "grid2d", bench::grid2d(side, side));
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_hashing.cpp
+ * @brief Collision rates and lookup throughput of the pair, integer and string hashes
+ *
+ * Usage: bench_hashing [scale]
+ * Uses the edges of a 2^(scale/2) x 2^(scale/2) grid (also with ids
+ * multiplied by 1024) and of an R-MAT graph with 2^scale vertices
+ * (default 2^18) as pair keys, and 2^scale vertex names as string keys.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+
+// The previous std::hash<std::pair> combine, kept as the baseline
+struct XorShiftPairHash {
+    size_t operator()(const std::pair<int, int>& p) const {
+        size_t h1 = std::hash<int>{}(p.first);
+        size_t h2 = std::hash<int>{}(p.second);
+        return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+    }
+};
+
+// Bucket statistics of a filled set: share of used buckets, largest bucket,
+// and mean number of keys compared by a successful lookup
+template<typename Set>
+static void collisions(bench::Reporter& rep, const std::string& name, const Set& set) {
+    std::size_t used = 0, largest = 0;
+    double probes = 0;
+    for (std::size_t b = 0; b < set.bucket_count(); b++) {
+        const std::size_t s = set.bucket_size(b);
+        used += s > 0;
+        largest = std::max(largest, s);
+        probes += s * (s + 1) / 2.0;
+    }
+    rep.metric(name + "/used_buckets", static_cast<double>(used) / set.bucket_count(), "fraction");
+    rep.metric(name + "/max_bucket", static_cast<double>(largest), "keys");
+    rep.metric(name + "/mean_probes", probes / set.size(), "keys");
+}
+
+// Same statistics for a power-of-two table indexed by the low bits of the
+// hash, as used by open-addressing maps; this is where weak mixing shows
+template<typename Hash, typename Key>
+static void maskedCollisions(bench::Reporter& rep, const std::string& name, const std::vector<Key>& keys) {
+    std::size_t buckets = 1;
+    while (buckets < keys.size()) buckets *= 2;
+    std::vector<std::uint32_t> size(buckets, 0);
+    for (const Key& k : keys) size[Hash{}(k) & (buckets - 1)]++;
+    std::size_t used = 0, largest = 0;
+    double probes = 0;
+    for (std::uint32_t s : size) {
+        used += s > 0;
+        largest = std::max<std::size_t>(largest, s);
+        probes += s * (s + 1) / 2.0;
+    }
+    rep.metric(name + "/pow2/used_buckets", static_cast<double>(used) / buckets, "fraction");
+    rep.metric(name + "/pow2/max_bucket", static_cast<double>(largest), "keys");
+    rep.metric(name + "/pow2/mean_probes", probes / keys.size(), "keys");
+}
+
+template<typename PairHash>
+static void benchPairs(bench::Reporter& rep, const std::string& name, const std::vector<std::pair<int, int>>& keys) {
+    std::unordered_set<std::pair<int, int>, PairHash> set;
+    rep.run(name + "/insert", keys.size(), [&](std::size_t i) { set.insert(keys[i]); });
+    collisions(rep, name, set);
+    maskedCollisions<PairHash>(rep, name, keys);
+    std::size_t sink = 0;
+    rep.run(name + "/find", keys.size(), [&](std::size_t i) { sink += set.contains(keys[(i * 7919) % keys.size()]); });
+    bench::keep(sink);
+}
+
+template<typename Hash>
+static void benchIntegers(bench::Reporter& rep, const std::string& name, std::size_t n, int stride) {
+    Graph<int, Hash> g;
+    for (std::size_t i = 0; i < n; i++) g.addVertex(static_cast<int>(i) * stride);
+    std::vector<int> keys(n);
+    for (std::size_t i = 0; i < n; i++) keys[i] = static_cast<int>(i) * stride;
+    std::unordered_set<int, Hash> ids(keys.begin(), keys.end());
+    collisions(rep, name, ids);
+    maskedCollisions<Hash>(rep, name, keys);
+    std::size_t sink = 0;
+    rep.run(name + "/containsVertex", 1 << 20, [&](std::size_t i) {
+        sink += g.containsVertex(static_cast<int>((i * 7919) % n) * stride);
+    });
+    bench::keep(sink);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 18);
+    const std::size_t n = std::size_t{1} << scale;
+    const std::size_t side = std::size_t{1} << (scale / 2);
+
+    bench::Reporter rep("hashing");
+    rep.param("scale", static_cast<double>(scale));
+
+    // Pair keys, as produced by Graph::edges() on sequential ids
+    std::vector<std::pair<int, int>> gridKeys, rmatKeys;
+    for (const auto& [u, v] : bench::grid2d(side, side).edges) gridKeys.emplace_back(std::min(u, v), std::max(u, v));
+    for (const auto& [u, v] : bench::rmat(static_cast<unsigned>(scale), 8, 1).edges) {
+        if (u != v) rmatKeys.emplace_back(std::min(u, v), std::max(u, v));
+    }
+    std::sort(rmatKeys.begin(), rmatKeys.end());
+    rmatKeys.erase(std::unique(rmatKeys.begin(), rmatKeys.end()), rmatKeys.end());
+    benchPairs<XorShiftPairHash>(rep, "pair/grid/xorshift", gridKeys);
+    benchPairs<std::hash<std::pair<int, int>>>(rep, "pair/grid/mix64", gridKeys);
+    std::vector<std::pair<int, int>> stridedKeys;
+    for (const auto& [u, v] : gridKeys) stridedKeys.emplace_back(u * 1024, v * 1024);
+    benchPairs<XorShiftPairHash>(rep, "pair/strided/xorshift", stridedKeys);
+    benchPairs<std::hash<std::pair<int, int>>>(rep, "pair/strided/mix64", stridedKeys);
+    benchPairs<XorShiftPairHash>(rep, "pair/rmat/xorshift", rmatKeys);
+    benchPairs<std::hash<std::pair<int, int>>>(rep, "pair/rmat/mix64", rmatKeys);
+
+    Graph<int> grid = bench::toGraph(bench::grid2d(side, side));
+    std::size_t sink = 0;
+    rep.run("pair/grid/edges", 4, [&](std::size_t) { sink += grid.edges().size(); });
+
+    // Integer keys: sequential ids and ids strided by a power of two
+    benchIntegers<std::hash<int>>(rep, "int/sequential/std", n, 1);
+    benchIntegers<graphlib::IntegerHash<int>>(rep, "int/sequential/mix64", n, 1);
+    benchIntegers<std::hash<int>>(rep, "int/strided/std", n, 1024);
+    benchIntegers<graphlib::IntegerHash<int>>(rep, "int/strided/mix64", n, 1024);
+
+    // String keys looked up by std::string_view, as read from a file or a request
+    std::vector<std::string> names(n);
+    for (std::size_t i = 0; i < n; i++) names[i] = "user/" + std::to_string(i * 2654435761u) + "/profile";
+    std::string buffer;
+    std::vector<std::string_view> views(n);
+    for (std::size_t i = 0; i < n; i++) buffer += names[i];
+    for (std::size_t i = 0, pos = 0; i < n; pos += names[i].size(), i++) views[i] = std::string_view(buffer).substr(pos, names[i].size());
+
+    Graph<std::string> plain;
+    Graph<std::string, graphlib::StringHash> transparent;
+    for (std::size_t i = 0; i < n; i++) {
+        plain.addEdge(names[i], names[(i + 1) % n]);
+        transparent.addEdge(names[i], names[(i + 1) % n]);
+    }
+    rep.run("string/std/containsVertex", 1 << 20, [&](std::size_t i) {
+        sink += plain.containsVertex(std::string(views[(i * 7919) % n]));
+    });
+    rep.run("string/transparent/containsVertex", 1 << 20, [&](std::size_t i) {
+        sink += transparent.containsVertex(views[(i * 7919) % n]);
+    });
+    rep.run("string/std/containsEdge", 1 << 20, [&](std::size_t i) {
+        const std::size_t k = (i * 7919) % n;
+        sink += plain.containsEdge(std::string(views[k]), std::string(views[(k + 1) % n]));
+    });
+    rep.run("string/transparent/containsEdge", 1 << 20, [&](std::size_t i) {
+        const std::size_t k = (i * 7919) % n;
+        sink += transparent.containsEdge(views[k], views[(k + 1) % n]);
+    });
+    bench::keep(sink);
+    return 0;
+}
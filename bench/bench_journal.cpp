@@ -0,0 +1,110 @@
+/**
+ * @file bench_journal.cpp
+ * @brief Cost of journaling mutations, and recovery throughput from the log and from a snapshot
+ *
+ * Usage: bench_journal [scale] [edge factor] [per-record commits]
+ * Journals the insertion of an R-MAT graph with 2^scale vertices (default
+ * 2^18) and edgeFactor * 2^scale edges (default 8), then recovers it by
+ * replaying the log and by loading a snapshot. The last argument (default
+ * 100000) is the number of insertions timed with one commit per record.
+ */
+
+#include <filesystem>
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/journal.hpp"
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 18);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+    const std::size_t perRecord = bench::arg(argc, argv, 3, 100000);
+    const std::string path = "build/bench/journal.log";
+    using J = Journal<int>;
+
+    bench::Reporter rep("journal");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+
+    const auto list = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+    auto insertAll = [&](Graph<int>& g, std::size_t limit) {
+        for (std::size_t i = 0; i < limit && i < list.edges.size(); i++) {
+            g.addEdge(static_cast<int>(list.edges[i].first), static_cast<int>(list.edges[i].second));
+        }
+    };
+    auto reset = [&] {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + ".snap");
+    };
+
+    // Warm-up, so that the first timed run does not pay for fresh pages
+    {
+        Graph<int> warm;
+        insertAll(warm, list.edges.size());
+    }
+
+    // Baseline: the same insertions without a journal
+    Graph<int> plain;
+    const double plainSecs = rep.once("insert/no_journal", [&] { insertAll(plain, list.edges.size()); });
+
+    // Group commit with the default 64 KB buffer
+    reset();
+    Graph<int> g;
+    std::uint64_t records = 0, logBytes = 0;
+    const double groupSecs = rep.once("insert/group_commit", [&] {
+        auto journal = J::open(path, g);
+        insertAll(g, list.edges.size());
+        journal->commit();
+        records = journal->sequenceNumber();
+        logBytes = journal->logSize();
+    });
+    rep.metric("records", static_cast<double>(records), "records");
+    rep.metric("log_bytes", static_cast<double>(logBytes), "bytes");
+    rep.metric("insert/group_commit/overhead", groupSecs / plainSecs, "x");
+
+    // One write and flush per record, on a prefix of the stream
+    {
+        reset();
+        Graph<int> h, hPlain;
+        const double base = rep.once("insert/prefix_no_journal", [&] { insertAll(hPlain, perRecord); });
+        const double each = rep.once("insert/prefix_commit_per_record", [&] {
+            auto journal = J::open(path, h, {.groupBytes = 0});
+            insertAll(h, perRecord);
+        });
+        rep.metric("insert/commit_per_record/overhead", each / base, "x");
+    }
+
+    // Recovery by replaying the whole log
+    reset();
+    {
+        auto journal = J::open(path, g);
+        insertAll(g, list.edges.size());
+    }
+    Graph<int> replayed;
+    std::optional<RecoveryStats> stats;
+    const double replaySecs = rep.once("recover/replay_log", [&] { stats = J::recover(path, replayed); });
+    if (!stats || replayed.countEdges() != plain.countEdges()) return 1;
+    rep.metric("recover/replay_log/records_per_second", stats->recordsReplayed / replaySecs, "records/s");
+    rep.metric("recover/replay_log/mb_per_second", stats->validBytes / replaySecs / 1e6, "MB/s");
+
+    // Rebuilding from the edge list, for comparison
+    Graph<int> rebuilt;
+    rep.once("recover/rebuild_from_edges", [&] { insertAll(rebuilt, list.edges.size()); });
+
+    // Compaction, then recovery from the snapshot
+    {
+        Graph<int> h;
+        auto journal = J::open(path, h);
+        rep.once("compact", [&] { journal->compact(); });
+    }
+    rep.metric("snapshot_bytes", static_cast<double>(std::filesystem::file_size(path + ".snap")), "bytes");
+    Graph<int> fromSnapshot;
+    const double snapshotSecs = rep.once("recover/snapshot", [&] { stats = J::recover(path, fromSnapshot); });
+    if (!stats || fromSnapshot.countEdges() != plain.countEdges()) return 1;
+    rep.metric("recover/snapshot/edges_per_second", fromSnapshot.countEdges() / snapshotSecs, "edges/s");
+    rep.metric("recover/snapshot/speedup_vs_replay", replaySecs / snapshotSecs, "x");
+
+    reset();
+    bench::keep(rebuilt.countVertices());
+    return 0;
+}
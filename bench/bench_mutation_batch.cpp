@@ -0,0 +1,90 @@
+/**
+ * @file bench_mutation_batch.cpp
+ * @brief Applying mixed mutations through MutationBatch versus individual calls
+ *
+ * Usage: bench_mutation_batch [vertices] [initial edges] [mutations] [threads]
+ * Defaults to 10M mutations on an Erdos-Renyi graph with 1M vertices and
+ * 3M edges, on one thread.
+ */
+
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/mutation_batch.hpp"
+
+struct Mutation {
+    int kind; // 0 addEdge, 1 removeEdge, 2 removeVertex
+    int u, v;
+};
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::arg(argc, argv, 1, 1000000);
+    const std::size_t m = bench::arg(argc, argv, 2, 3000000);
+    const std::size_t count = bench::arg(argc, argv, 3, 10000000);
+    const std::size_t threads = bench::arg(argc, argv, 4, 1);
+
+    bench::Reporter rep("mutation_batch");
+    rep.param("vertices", static_cast<double>(n));
+    rep.param("edges", static_cast<double>(m));
+    rep.param("mutations", static_cast<double>(count));
+    rep.param("threads", static_cast<double>(threads));
+
+    Graph<int> base = bench::toGraph(bench::erdosRenyi(n, m, 1));
+    graphlib::Xoshiro256 rng(2);
+    auto pick = [&] { return static_cast<int>(graphlib::boundedRandom(rng, n)); };
+
+    // Uniform endpoints, then a skewed stream where half the endpoints are one of 1% hot vertices
+    for (int hotPercent : {0, 50}) {
+        auto endpoint = [&] {
+            if (graphlib::boundedRandom(rng, 100) < static_cast<std::uint64_t>(hotPercent)) {
+                return static_cast<int>(graphlib::boundedRandom(rng, n / 100));
+            }
+            return pick();
+        };
+
+        // 60% insertions, 35% removals of previously inserted edges, 5% vertex removals
+        std::vector<Mutation> mutations;
+        mutations.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            const auto r = graphlib::boundedRandom(rng, 100);
+            if (r < 60 || mutations.empty()) {
+                mutations.push_back({0, endpoint(), endpoint()});
+            } else if (r < 95) {
+                const Mutation& earlier = mutations[graphlib::boundedRandom(rng, mutations.size())];
+                mutations.push_back({1, earlier.u, earlier.v});
+            } else {
+                mutations.push_back({2, endpoint(), 0});
+            }
+        }
+
+        const std::string stream = hotPercent ? "skewed" : "uniform";
+
+        Graph<int> individual = base;
+        double individualSecs = rep.once(stream + "/individual", [&] {
+            for (const auto& mu : mutations) {
+                if (mu.kind == 0) individual.addEdge(mu.u, mu.v);
+                else if (mu.kind == 1) individual.removeEdge(mu.u, mu.v);
+                else individual.removeVertex(mu.u);
+            }
+        });
+
+        Graph<int> batched = base;
+        double batchSecs = rep.once(stream + "/batch", [&] {
+            MutationBatch<int> batch;
+            for (const auto& mu : mutations) {
+                if (mu.kind == 0) batch.addEdge(mu.u, mu.v);
+                else if (mu.kind == 1) batch.removeEdge(mu.u, mu.v);
+                else batch.removeVertex(mu.u);
+            }
+            batch.applyTo(batched, threads);
+        });
+        rep.metric(stream + "/individual_per_sec", count / individualSecs, "1/s");
+        rep.metric(stream + "/batch_per_sec", count / batchSecs, "1/s");
+        rep.metric(stream + "/speedup", individualSecs / batchSecs, "x");
+
+        if (individual.countVertices() != batched.countVertices() || individual.countEdges() != batched.countEdges()) {
+            std::cerr << "MISMATCH between individual and batched results" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file bench_parallel.cpp
+ * @brief Scaling of forEachVertex/forEachEdge on a skewed power-law graph
+ *
+ * Usage: bench_parallel [scale] [edge factor]
+ * Builds an R-MAT graph with 2^scale vertices (default 2^18) and
+ * edgeFactor * 2^scale edges (default 16), then times whole-graph passes
+ * with 1, 2, 4, ... threads up to the number of hardware threads. The
+ * "static" variant splits ids evenly with parallelFor, without degree
+ * weights, as a reference for the degree-aware split.
+ */
+
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/csr.hpp"
+
+using Id = CSRGraph<int>::Id;
+
+// Per-thread accumulator on its own cache line
+struct alignas(64) Sum {
+    std::size_t value = 0;
+};
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 18);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 16);
+    const std::size_t hardware = graphlib::hardwareThreads();
+
+    bench::Reporter rep("parallel");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+    rep.param("hardware_threads", static_cast<double>(hardware));
+
+    const auto list = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+    const Graph<int> g = bench::toGraph(list);
+    const auto csr = CSRGraph<int>::fromEdgeList(list.n, list.edges);
+    rep.metric("max_degree", static_cast<double>(csr.maxDegree()), "edges");
+
+    std::size_t sink = 0;
+    // Work proportional to the degree: two-hop degree sum of every vertex
+    auto twoHop = [&](Id v) {
+        std::size_t s = 0;
+        for (Id w : csr.neighbors(v)) s += csr.degree(w);
+        return s;
+    };
+
+    std::vector<Sum> sums(hardware);
+    auto collect = [&] {
+        for (auto& s : sums) {
+            sink += s.value;
+            s.value = 0;
+        }
+    };
+
+    // Warm-up pass, so the first timed pass does not pay for page faults
+    for (Id v = 0; v < csr.countVertices(); v++) sink += twoHop(v);
+
+    // Sequential references, over the plain iterators
+    const double graphVertexBase = rep.once("graph/forEachVertex/sequential", [&] {
+        for (int v : g) {
+            for (int w : g.neighbors(v)) sums[0].value += g.degree(w);
+        }
+        collect();
+    });
+    const double graphEdgeBase = rep.once("graph/forEachEdge/sequential", [&] {
+        for (int u : g) {
+            for (int v : g.neighbors(u)) {
+                if (u < v) sums[0].value += static_cast<std::size_t>(u ^ v);
+            }
+        }
+        collect();
+    });
+    const double csrVertexBase = rep.once("csr/forEachVertex/sequential", [&] {
+        for (Id v = 0; v < csr.countVertices(); v++) sums[0].value += twoHop(v);
+        collect();
+    });
+
+    for (std::size_t threads = 1; threads <= hardware; threads *= 2) {
+        const std::string t = "/threads" + std::to_string(threads);
+        const graphlib::ParallelPolicy policy{.threads = threads};
+        const double gv = rep.once("graph/forEachVertex" + t, [&] {
+            g.forEachVertex(policy, [&](int v, std::size_t worker) {
+                for (int w : g.neighbors(v)) sums[worker].value += g.degree(w);
+            });
+            collect();
+        });
+        const double ge = rep.once("graph/forEachEdge" + t, [&] {
+            g.forEachEdge(policy, [&](int u, int v, std::size_t worker) { sums[worker].value += static_cast<std::size_t>(u ^ v); });
+            collect();
+        });
+        const double cv = rep.once("csr/forEachVertex" + t, [&] {
+            csr.forEachVertex(policy, [&](Id v, std::size_t worker) { sums[worker].value += twoHop(v); });
+            collect();
+        });
+        const double sv = rep.once("csr/static" + t, [&] {
+            graphlib::parallelFor(csr.countVertices(), threads, [&](std::size_t v, std::size_t worker) {
+                sums[worker].value += twoHop(static_cast<Id>(v));
+            }, (csr.countVertices() + threads - 1) / threads);
+            collect();
+        });
+        rep.once("csr/forEachEdge" + t, [&] {
+            csr.forEachEdge(policy, [&](Id u, Id v, std::size_t worker) { sums[worker].value += u ^ v; });
+            collect();
+        });
+        rep.metric("graph/forEachVertex" + t + "/speedup", graphVertexBase / gv, "x");
+        rep.metric("graph/forEachEdge" + t + "/speedup", graphEdgeBase / ge, "x");
+        rep.metric("csr/forEachVertex" + t + "/speedup", csrVertexBase / cv, "x");
+        rep.metric("csr/static" + t + "/speedup", csrVertexBase / sv, "x");
+    }
+    bench::keep(sink);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench_partition.cpp
+ * @brief Edge cut and running time of the partitioners on power-law graphs
+ *
+ * Usage: bench_partition [scale] [edge factor] [parts]
+ * Runs on an R-MAT graph with 2^scale vertices (default 2^18) and
+ * edgeFactor * 2^scale edges (default 8), and on a Barabasi-Albert graph
+ * of the same size, split into `parts` parts (default 16) with 3%
+ * imbalance. A hash split (part = hash(v) mod parts) is the baseline.
+ * The R-MAT graph is also split into 4 parts, and its parts are extracted
+ * with their ghosts.
+ */
+
+#include <string>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/partition.hpp"
+
+static void benchPartition(bench::Reporter& rep, const std::string& name, const CSRGraph<int>& g,
+                           std::size_t parts) {
+    auto key = [&](const std::string& what) { return name + "/k" + std::to_string(parts) + "/" + what; };
+
+    std::vector<PartId> hashed(g.countVertices());
+    for (std::size_t v = 0; v < hashed.size(); v++) hashed[v] = static_cast<PartId>(graphlib::hashMix(v) % parts);
+    rep.metric(key("hash/cut_ratio"),
+               static_cast<double>(edgeCut(g, std::span<const PartId>(hashed))) / static_cast<double>(g.countEdges()),
+               "ratio");
+
+    const std::pair<const char*, PartitionAlgorithm> algorithms[] = {
+        {"ldg", PartitionAlgorithm::LDG}, {"fennel", PartitionAlgorithm::Fennel}, {"multilevel", PartitionAlgorithm::Multilevel}};
+    for (const auto& [label, alg] : algorithms) {
+        Partition p;
+        rep.once(key(std::string(label) + "/time"), [&] { p = partitionGraph(g, {.parts = parts, .algorithm = alg}); });
+        rep.metric(key(std::string(label) + "/cut_ratio"), p.cutRatio(), "ratio");
+        rep.metric(key(std::string(label) + "/balance"), p.balance(), "max/avg");
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 18);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+    const std::size_t parts = bench::arg(argc, argv, 3, 16);
+
+    bench::Reporter rep("partition");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+    rep.param("parts", static_cast<double>(parts));
+
+    const std::size_t n = std::size_t{1} << scale;
+    const bench::EdgeList rmatList = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+    const auto rmat = CSRGraph<int>::fromEdgeList(rmatList.n, rmatList.edges);
+    const bench::EdgeList baList = bench::barabasiAlbert(n, edgeFactor, 1);
+    const auto ba = CSRGraph<int>::fromEdgeList(baList.n, baList.edges);
+
+    benchPartition(rep, "rmat", rmat, parts);
+    benchPartition(rep, "barabasi_albert", ba, parts);
+    benchPartition(rep, "rmat", rmat, 4);
+
+    const Partition p = partitionGraph(rmat, {.parts = 4});
+    std::vector<PartSubgraph<int, std::hash<int>>> subs;
+    rep.once("rmat/k4/extract", [&] { subs = extractParts(rmat, p); });
+    std::size_t ghosts = 0;
+    for (const auto& sub : subs) ghosts += sub.ghosts.size();
+    rep.metric("rmat/k4/ghosts_per_owned", static_cast<double>(ghosts) / static_cast<double>(rmat.countVertices()), "ratio");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file bench_properties.cpp
+ * @brief Traversals filtered on an edge property: EdgeColumn versus a side hash map
+ *
+ * Usage: bench_properties [scale] [edge factor]
+ * Builds an R-MAT graph with 2^scale vertices (default 2^18) and
+ * edgeFactor * 2^scale edges (default 8), gives every edge a random
+ * timestamp, then runs BFS restricted to recent edges (timestamp >= half).
+ */
+
+#include <string>
+#include <unordered_map>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/properties.hpp"
+
+using Id = CSRGraph<int>::Id;
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 18);
+    const std::size_t edgeFactor = bench::arg(argc, argv, 2, 8);
+
+    bench::Reporter rep("properties");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("edge_factor", static_cast<double>(edgeFactor));
+
+    const auto list = bench::rmat(static_cast<unsigned>(scale), edgeFactor, 1);
+    const unsigned cutoff = 1u << 31;
+    graphlib::Xoshiro256 rng(5);
+
+    // Side-map approach: a Graph plus a table keyed by (min, max) vertex pairs
+    Graph<int> g = bench::toGraph(list);
+    std::unordered_map<std::pair<int, int>, unsigned> sideMap;
+    rep.once("side_map/build", [&] {
+        for (const auto& [u, v] : g.edges()) sideMap.emplace(std::pair{u, v}, static_cast<unsigned>(rng()));
+    });
+
+    // Columnar approach: the same timestamps, stored per CSR slot
+    const auto csr = CSRGraph<int>::fromEdgeList(list.n, list.edges);
+    EdgeColumn<unsigned, int> timestamp(csr);
+    rep.once("column/build", [&] {
+        for (const auto& [e, t] : sideMap) timestamp.set(static_cast<Id>(e.first), static_cast<Id>(e.second), t);
+    });
+
+    const double entries = static_cast<double>(sideMap.size());
+    rep.metric("side_map/bytes", static_cast<double>(sideMap.bucket_count() * sizeof(void*))
+               + entries * (sizeof(void*) + sizeof(std::size_t) + sizeof(std::pair<const std::pair<int, int>, unsigned>)), "bytes");
+    rep.metric("column/bytes", static_cast<double>(timestamp.size() * sizeof(unsigned)), "bytes");
+
+    std::vector<int> sources(16);
+    for (auto& s : sources) s = list.edges[graphlib::boundedRandom(rng, list.edges.size())].first;
+
+    std::size_t reachedMap = 0, reachedColumn = 0;
+    rep.run("side_map/filtered_bfs", sources.size(), [&](std::size_t i) {
+        std::unordered_set<int> seen{sources[i]};
+        std::vector<int> order{sources[i]};
+        for (std::size_t head = 0; head < order.size(); head++) {
+            const int u = order[head];
+            for (int w : g.neighbors(u)) {
+                if (sideMap.find(std::minmax(u, w))->second < cutoff) continue;
+                if (seen.insert(w).second) order.push_back(w);
+            }
+        }
+        reachedMap += order.size();
+    });
+    rep.run("column/filtered_bfs", sources.size(), [&](std::size_t i) {
+        std::vector<bool> seen(csr.countVertices(), false);
+        std::vector<Id> order{static_cast<Id>(sources[i])};
+        seen[order[0]] = true;
+        for (std::size_t head = 0; head < order.size(); head++) {
+            const Id u = order[head];
+            for (std::size_t s = csr.offset(u); s < csr.offset(u + 1); s++) {
+                if (timestamp[s] < cutoff || seen[csr.target(s)]) continue;
+                seen[csr.target(s)] = true;
+                order.push_back(csr.target(s));
+            }
+        }
+        reachedColumn += order.size();
+    });
+    rep.metric("reached_vertices_match", reachedMap == reachedColumn ? 1 : 0, "bool");
+    return 0;
+}
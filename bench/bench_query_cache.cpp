@@ -0,0 +1,126 @@
+/**
+ * @file bench_query_cache.cpp
+ * @brief Hit rate and latency of QueryCache under a Zipfian query mix
+ *
+ * Usage: bench_query_cache [scale] [queries] [keys]
+ * Builds an R-MAT graph with 2^scale vertices (default 2^12, edge factor 8)
+ * and a trace of queries (default 100000) drawn from a Zipfian distribution
+ * (exponent 0.99) over a fixed set of keys (default 2^15): 80% distance()
+ * between two random vertices, 20% bfs() limited to 256 vertices.
+ * The trace is replayed:
+ * - "uncached": directly on the graph, first tenth of the trace only;
+ * - "cached/<budget>": through caches of 256 KB, 2 MB and 16 MB, the last
+ *   one holding every key;
+ * - "mutating": 16 MB cache, with one edge added every 1000 queries;
+ * - "threads": 16 MB cache shared by every hardware thread.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/query_cache.hpp"
+
+struct Query {
+    bool bfs;
+    int u, v;
+};
+
+// Draws `count` indexes in [0, keys) with P(k) proportional to 1 / (k + 1)^s
+static std::vector<std::size_t> zipfTrace(std::size_t keys, std::size_t count, double s, std::uint64_t seed) {
+    std::vector<double> cdf(keys);
+    double sum = 0;
+    for (std::size_t k = 0; k < keys; k++) cdf[k] = sum += 1.0 / std::pow(static_cast<double>(k + 1), s);
+    graphlib::Xoshiro256 rng(seed);
+    std::vector<std::size_t> trace(count);
+    for (auto& k : trace) {
+        const double x = static_cast<double>(rng() >> 11) * 0x1.0p-53 * sum;
+        k = std::min<std::size_t>(keys - 1, std::upper_bound(cdf.begin(), cdf.end(), x) - cdf.begin());
+    }
+    return trace;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t scale = bench::arg(argc, argv, 1, 12);
+    const std::size_t queries = bench::arg(argc, argv, 2, 100000);
+    const std::size_t keys = bench::arg(argc, argv, 3, std::size_t{1} << 15);
+    const std::size_t bfsLimit = 256;
+
+    bench::Reporter rep("query_cache");
+    rep.param("scale", static_cast<double>(scale));
+    rep.param("queries", static_cast<double>(queries));
+    rep.param("keys", static_cast<double>(keys));
+
+    Graph<int> g = bench::toGraph(bench::rmat(static_cast<unsigned>(scale), 8, 1));
+    const auto n = static_cast<std::uint64_t>(1) << scale;
+
+    graphlib::Xoshiro256 rng(3);
+    auto pick = [&] {
+        for (;;) {
+            const int v = static_cast<int>(graphlib::boundedRandom(rng, n));
+            if (g.degree(v) > 0) return v;
+        }
+    };
+    std::vector<Query> keySet(keys);
+    for (auto& q : keySet) q = {graphlib::boundedRandom(rng, 5) == 0, pick(), pick()};
+    std::vector<Query> trace;
+    trace.reserve(queries);
+    for (std::size_t k : zipfTrace(keys, queries, 0.99, 5)) trace.push_back(keySet[k]);
+
+    const double uncached = rep.run("uncached", std::max<std::size_t>(queries / 10, 1), [&](std::size_t i) {
+        const Query& q = trace[i];
+        if (q.bfs) bench::keep(g.bfs(q.u, bfsLimit).size());
+        else bench::keep(g.distance(q.u, q.v));
+    });
+
+    auto replay = [&](QueryCache<Graph<int>>& cache, std::size_t i) {
+        const Query& q = trace[i];
+        if (q.bfs) bench::keep(cache.bfs(q.u, bfsLimit)->size());
+        else bench::keep(cache.distance(q.u, q.v));
+    };
+    auto report = [&](const std::string& name, const QueryCacheStats& stats) {
+        rep.metric(name + "/hit_rate", stats.hitRate(), "ratio");
+        rep.metric(name + "/bytes", static_cast<double>(stats.bytes), "bytes");
+        rep.metric(name + "/evictions", static_cast<double>(stats.evictions), "entries");
+    };
+
+    const std::size_t fullBudget = std::size_t{16} << 20;
+    for (const std::size_t kb : {256, 2048, 16384}) {
+        const std::string name = "cached/" + std::to_string(kb) + "KB";
+        QueryCache<Graph<int>> cache(g, {.maxBytes = kb << 10});
+        const double ops = rep.run(name, queries, [&](std::size_t i) { replay(cache, i); });
+        report(name, cache.stats());
+        rep.metric(name + "/speedup", ops / uncached, "x");
+    }
+
+    {
+        QueryCache<Graph<int>> cache(g, {.maxBytes = fullBudget});
+        const double ops = rep.run("mutating", queries, [&](std::size_t i) {
+            if (i % 1000 == 999) g.addEdge(pick(), pick());
+            replay(cache, i);
+        });
+        const QueryCacheStats stats = cache.stats();
+        report("mutating", stats);
+        rep.metric("mutating/stale", static_cast<double>(stats.stale), "queries");
+        rep.metric("mutating/speedup", ops / uncached, "x");
+    }
+
+    {
+        QueryCache<Graph<int>> cache(g, {.maxBytes = fullBudget});
+        const std::size_t threads = graphlib::hardwareThreads();
+        rep.param("threads", static_cast<double>(threads));
+        rep.once("threads/total", [&] {
+            std::vector<std::thread> pool;
+            for (std::size_t t = 0; t < threads; t++) {
+                pool.emplace_back([&, t] {
+                    for (std::size_t i = t; i < queries; i += threads) replay(cache, i);
+                });
+            }
+            for (auto& th : pool) th.join();
+        });
+        report("threads", cache.stats());
+    }
+    return 0;
+}
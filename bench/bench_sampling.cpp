@@ -0,0 +1,61 @@
+/**
+ * @file bench_sampling.cpp
+ * @brief Throughput of neighbor sampling on a large random graph
+ *
+ * Usage: bench_sampling [vertices] [edges] [threads]
+ * Defaults to 1M vertices / 10M edges; pass 10000000 100000000 for the
+ * 100M-edge configuration (needs about 2.5 GB of RAM).
+ */
+
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/sampling.hpp"
+
+int main(int argc, char** argv) {
+    using Id = CSRGraph<int>::Id;
+    const std::size_t n = bench::arg(argc, argv, 1, 1000000);
+    const std::size_t m = bench::arg(argc, argv, 2, 10000000);
+    const std::size_t threads = bench::arg(argc, argv, 3, 0);
+
+    bench::Reporter rep("sampling");
+    rep.param("vertices", static_cast<double>(n));
+    rep.param("edges", static_cast<double>(m));
+    rep.param("threads", static_cast<double>(threads));
+
+    auto list = bench::erdosRenyi(n, m, 1);
+    std::optional<CSRGraph<int>> csr;
+    rep.once("csr_build", [&] { csr.emplace(CSRGraph<int>::fromEdgeList(n, list.edges)); });
+    list = {};
+
+    NeighborSampler<int> sampler(*csr);
+    graphlib::Xoshiro256 rng(2);
+
+    // Single-vertex sampling, k = 10
+    std::vector<Id> out;
+    std::size_t sampled = 0;
+    rep.run("sampleNeighbors/k10", 2000000, [&](std::size_t) {
+        out.clear();
+        sampler.sampleNeighbors(static_cast<Id>(graphlib::boundedRandom(rng, n)), 10, rng, out);
+        sampled += out.size();
+    });
+    bench::keep(sampled);
+
+    // Mini-batches of 512 seeds with fanouts [25, 10]
+    const std::size_t batchCount = 200;
+    std::vector<std::vector<Id>> batches(batchCount);
+    for (auto& b : batches) {
+        b.resize(512);
+        for (auto& s : b) s = static_cast<Id>(graphlib::boundedRandom(rng, n));
+    }
+    std::vector<std::size_t> fanouts = {25, 10};
+
+    std::vector<NeighborSampler<int>::KHopSample> samples;
+    double secs = rep.once("sampleKHopBatch/25x10", [&] { samples = sampler.sampleKHopBatch(batches, fanouts, 7, threads); });
+    sampled = 0;
+    for (const auto& s : samples) {
+        for (const auto& hop : s.edges) sampled += hop.size();
+    }
+    rep.metric("sampleKHopBatch/samples_per_sec", sampled / secs, "1/s");
+    rep.metric("sampleKHopBatch/batches_per_sec", batchCount / secs, "1/s");
+    return 0;
+}
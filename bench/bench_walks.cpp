@@ -0,0 +1,43 @@
+/**
+ * @file bench_walks.cpp
+ * @brief Throughput of uniform and node2vec random walks
+ *
+ * Usage: bench_walks [vertices] [edges] [threads]
+ * Reports steps/sec overall and per core.
+ */
+
+#include "bench/generators.hpp"
+#include "bench/harness.hpp"
+#include "graphlib/walks.hpp"
+
+int main(int argc, char** argv) {
+    using Id = CSRGraph<int>::Id;
+    const std::size_t n = bench::arg(argc, argv, 1, 1000000);
+    const std::size_t m = bench::arg(argc, argv, 2, 10000000);
+    std::size_t threads = bench::arg(argc, argv, 3, 0);
+    if (threads == 0) threads = graphlib::hardwareThreads();
+
+    bench::Reporter rep("walks");
+    rep.param("vertices", static_cast<double>(n));
+    rep.param("edges", static_cast<double>(m));
+    rep.param("threads", static_cast<double>(threads));
+
+    auto csr = CSRGraph<int>::fromEdgeList(n, bench::erdosRenyi(n, m, 1).edges);
+
+    RandomWalker<int> walker(csr);
+    const std::size_t length = 80;
+    std::vector<Id> starts(n);
+    for (std::size_t i = 0; i < n; i++) starts[i] = static_cast<Id>(i);
+    std::vector<Id> out(starts.size() * length);
+
+    auto report = [&](const std::string& name, auto&& fn) {
+        double rate = starts.size() * (length - 1) / rep.once(name, fn);
+        rep.metric(name + "/steps_per_sec", rate, "1/s");
+        rep.metric(name + "/steps_per_sec_per_core", rate / threads, "1/s");
+    };
+
+    report("uniform", [&] { walker.uniformWalks(starts, length, out, 1, threads); });
+    report("node2vec/p1_q1", [&] { walker.node2vecWalks(starts, length, {1.0, 1.0}, out, 1, threads); });
+    report("node2vec/p4_q0.5", [&] { walker.node2vecWalks(starts, length, {4.0, 0.5}, out, 1, threads); });
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file generators.hpp
+ * @brief Deterministic synthetic graph generators for the benchmarks
+ *
+ * Generators return an edge list over vertices 0..n-1 so the same input can
+ * feed Graph, CSRGraph::fromEdgeList or any other representation. Edge lists
+ * may contain duplicates and self-loops; every representation drops them the
+ * same way Graph::addEdge does.
+ */
+
+#ifndef GRAPHLIB_BENCH_GENERATORS_HPP
+#define GRAPHLIB_BENCH_GENERATORS_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graphlib.hpp"
+#include "graphlib/random.hpp"
+
+namespace bench {
+
+/// Undirected edge list over vertices 0..n-1
+struct EdgeList {
+    std::size_t n = 0;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+};
+
+/**
+ * @brief Erdos-Renyi G(n, m): m edges with uniformly random endpoints
+ * @note Here i used https://en.wikipedia.org/wiki/Erd%C5%91s%E2%80%93R%C3%A9nyi_model as a reference
+ */
+inline EdgeList erdosRenyi(std::size_t n, std::size_t m, std::uint64_t seed = 1) {
+    graphlib::Xoshiro256 rng(seed);
+    EdgeList res{n, {}};
+    res.edges.resize(m);
+    for (auto& e : res.edges) {
+        e = {static_cast<std::uint32_t>(graphlib::boundedRandom(rng, n)),
+             static_cast<std::uint32_t>(graphlib::boundedRandom(rng, n))};
+    }
+    return res;
+}
+
+/**
+ * @brief R-MAT / Kronecker graph with 2^scale vertices and edgeFactor * 2^scale edges
+ * @param a, b, c Quadrant probabilities (d = 1 - a - b - c), Graph500 defaults
+ * @note Produces a skewed, power-law-like degree distribution
+ * @note Here i used https://doi.org/10.1137/1.9781611972740.43 as a reference
+ */
+inline EdgeList rmat(unsigned scale, std::size_t edgeFactor, std::uint64_t seed = 1,
+                     double a = 0.57, double b = 0.19, double c = 0.19) {
+    graphlib::Xoshiro256 rng(seed);
+    EdgeList res{std::size_t{1} << scale, {}};
+    res.edges.resize(edgeFactor << scale);
+    for (auto& e : res.edges) {
+        std::uint32_t u = 0, v = 0;
+        for (unsigned bit = 0; bit < scale; bit++) {
+            const double r = graphlib::uniformReal(rng);
+            const std::uint32_t right = (r >= a && r < a + b) || r >= a + b + c;
+            const std::uint32_t down = r >= a + b;
+            u |= down << bit;
+            v |= right << bit;
+        }
+        e = {u, v};
+    }
+    // Scramble ids so high-degree vertices are not clustered at small ids
+    std::vector<std::uint32_t> perm(res.n);
+    for (std::uint32_t i = 0; i < res.n; i++) perm[i] = i;
+    for (std::size_t i = res.n; i > 1; i--) std::swap(perm[i - 1], perm[graphlib::boundedRandom(rng, i)]);
+    for (auto& e : res.edges) e = {perm[e.first], perm[e.second]};
+    return res;
+}
+
+/**
+ * @brief Barabasi-Albert preferential attachment: each new vertex links to k existing ones
+ * @note Here i used https://en.wikipedia.org/wiki/Barab%C3%A1si%E2%80%93Albert_model as a reference
+ */
+inline EdgeList barabasiAlbert(std::size_t n, std::size_t k, std::uint64_t seed = 1) {
+    graphlib::Xoshiro256 rng(seed);
+    EdgeList res{n, {}};
+    if (n < 2) return res;
+    res.edges.reserve(n * k);
+    // Picking an endpoint of a uniformly random edge is picking a vertex
+    // with probability proportional to its degree
+    std::vector<std::uint32_t> endpoints = {0, 1};
+    res.edges.emplace_back(0, 1);
+    for (std::uint32_t v = 2; v < n; v++) {
+        for (std::size_t j = 0; j < k; j++) {
+            std::uint32_t u = endpoints[graphlib::boundedRandom(rng, endpoints.size())];
+            res.edges.emplace_back(v, u);
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief 2D grid of width x height vertices, vertex (x, y) has id y * width + x
+ */
+inline EdgeList grid2d(std::size_t width, std::size_t height) {
+    EdgeList res{width * height, {}};
+    res.edges.reserve(2 * width * height);
+    for (std::uint32_t y = 0; y < height; y++) {
+        for (std::uint32_t x = 0; x < width; x++) {
+            const std::uint32_t id = static_cast<std::uint32_t>(y * width + x);
+            if (x + 1 < width) res.edges.emplace_back(id, id + 1);
+            if (y + 1 < height) res.edges.emplace_back(id, static_cast<std::uint32_t>(id + width));
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Loads an edge list into a hash-based Graph<int>
+ */
+inline Graph<int> toGraph(const EdgeList& list) {
+    Graph<int> g;
+    for (const auto& [u, v] : list.edges) g.addEdge(static_cast<int>(u), static_cast<int>(v));
+    return g;
+}
+
+} // namespace bench
+
+#endif
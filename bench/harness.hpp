@@ -0,0 +1,196 @@
+/**
+ * @file harness.hpp
+ * @brief Timing harness shared by the benchmarks, reporting machine-readable JSON
+ *
+ * Every benchmark binary creates one Reporter and prints a single JSON
+ * document on stdout:
+ *
+ *     {"suite": "...", "config": {...}, "results": [...], "peak_rss_kb": N}
+ *
+ * Timed results carry throughput and per-operation latency percentiles in
+ * nanoseconds; scalar metrics (memory, speedups, ...) carry a value and a
+ * unit. Inputs come from fixed seeds so runs on different commits measure
+ * the same work and can be diffed result by result.
+ */
+
+#ifndef GRAPHLIB_BENCH_HARNESS_HPP
+#define GRAPHLIB_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+
+/**
+ * @brief Returns the peak resident set size of the process in KiB (0 if unknown)
+ */
+inline long peakRssKb() {
+#if defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#elif defined(__unix__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Parses argv[index] as an unsigned integer, or returns a default
+ */
+inline std::size_t arg(int argc, char** argv, int index, std::size_t fallback) {
+    return argc > index ? std::strtoull(argv[index], nullptr, 10) : fallback;
+}
+
+/**
+ * @brief Prevents the compiler from optimizing away a computed value
+ */
+template<typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief Collects benchmark results and prints them as one JSON document
+ */
+class Reporter {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::string suite;
+    std::vector<std::string> config;
+    std::vector<std::string> results;
+
+    static std::string quote(const std::string& s) {
+        std::string res = "\"";
+        for (char c : s) {
+            if (c == '"' || c == '\\') res += '\\';
+            res += c;
+        }
+        return res + "\"";
+    }
+
+    static std::string number(double v) {
+        std::ostringstream oss;
+        oss.precision(10);
+        oss << v;
+        return oss.str();
+    }
+
+public:
+    explicit Reporter(std::string name) : suite(std::move(name)) {}
+
+    Reporter(const Reporter&) = delete;
+    Reporter& operator=(const Reporter&) = delete;
+
+    ~Reporter() {
+        std::cout << "{\"suite\": " << quote(suite) << ", \"config\": {";
+        for (std::size_t i = 0; i < config.size(); i++) std::cout << (i ? ", " : "") << config[i];
+        std::cout << "}, \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            std::cout << "  " << results[i] << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        std::cout << "], \"peak_rss_kb\": " << peakRssKb() << "}" << std::endl;
+    }
+
+    /**
+     * @brief Records an input parameter of the run (graph size, seed, ...)
+     */
+    void param(const std::string& key, double value) {
+        config.push_back(quote(key) + ": " + number(value));
+    }
+
+    void param(const std::string& key, const std::string& value) {
+        config.push_back(quote(key) + ": " + quote(value));
+    }
+
+    /**
+     * @brief Records a scalar measurement
+     * @param name Result name, unique within the suite
+     * @param value Measured value
+     * @param unit Unit of the value (e.g. "bytes", "x", "s")
+     */
+    void metric(const std::string& name, double value, const std::string& unit) {
+        results.push_back("{\"name\": " + quote(name) + ", \"value\": " + number(value)
+                          + ", \"unit\": " + quote(unit) + "}");
+        std::cerr << name << ": " << value << " " << unit << std::endl;
+    }
+
+    /**
+     * @brief Times `ops` calls of fn(i), i in [0, ops)
+     * @param name Result name, unique within the suite
+     * @param ops Number of operations
+     * @param fn Callable invoked as fn(size_t i)
+     * @note Operations are timed in chunks sized so that each chunk lasts
+     *       about a microsecond; percentiles are per-operation averages of
+     *       those chunks, which keeps clock overhead out of cheap operations
+     * @return Operations per second
+     */
+    template<typename Fn>
+    double run(const std::string& name, std::size_t ops, Fn&& fn) {
+        if (ops == 0) return 0;
+
+        auto start = Clock::now();
+        fn(std::size_t{0});
+        double first = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        std::size_t chunk = first >= 1000.0 ? 1 : std::min<std::size_t>(1024, static_cast<std::size_t>(1000.0 / std::max(first, 1.0)) + 1);
+
+        std::vector<double> perOp;
+        perOp.reserve(ops / chunk + 2);
+        perOp.push_back(first);
+
+        double total = first;
+        for (std::size_t i = 1; i < ops; i += chunk) {
+            const std::size_t end = std::min(ops, i + chunk);
+            auto t0 = Clock::now();
+            for (std::size_t j = i; j < end; j++) fn(j);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+            total += ns;
+            perOp.push_back(ns / (end - i));
+        }
+
+        std::sort(perOp.begin(), perOp.end());
+        auto pct = [&](double p) { return perOp[std::min(perOp.size() - 1, static_cast<std::size_t>(p * perOp.size()))]; };
+        const double opsPerSec = ops / (total * 1e-9);
+
+        results.push_back("{\"name\": " + quote(name) + ", \"ops\": " + std::to_string(ops)
+                          + ", \"ops_per_sec\": " + number(opsPerSec)
+                          + ", \"p50_ns\": " + number(pct(0.50))
+                          + ", \"p90_ns\": " + number(pct(0.90))
+                          + ", \"p99_ns\": " + number(pct(0.99))
+                          + ", \"max_ns\": " + number(perOp.back())
+                          + ", \"peak_rss_kb\": " + std::to_string(peakRssKb()) + "}");
+        std::cerr << name << ": " << opsPerSec << " ops/sec, p50 " << pct(0.50) << " ns, p99 " << pct(0.99) << " ns" << std::endl;
+        return opsPerSec;
+    }
+
+    /**
+     * @brief Times a single call of fn()
+     * @return Elapsed seconds
+     */
+    template<typename Fn>
+    double once(const std::string& name, Fn&& fn) {
+        auto t0 = Clock::now();
+        fn();
+        double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+        metric(name, secs, "s");
+        return secs;
+    }
+};
+
+} // namespace bench
+
+#endif
@@ -15,21 +15,173 @@
 #include <optional>
 #include <type_traits>
 #include <sstream>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "graphlib/parallel.hpp"
+
+namespace graphlib {
+
+/**
+ * @brief Mixes the bits of a 64-bit value so that every input bit affects every output bit
+ * @note Here i used the hash_mix function of Boost.ContainerHash
+ *       (https://www.boost.org/doc/libs/latest/libs/container_hash/doc/html/hash.html#notes_hash_combine) as a reference
+ */
+constexpr std::uint64_t hashMix(std::uint64_t x) noexcept {
+    constexpr std::uint64_t m = 0xe9846af9b1a615d;
+    x ^= x >> 32;
+    x *= m;
+    x ^= x >> 32;
+    x *= m;
+    x ^= x >> 28;
+    return x;
+}
+
+/**
+ * @brief Hash for integer vertices that spreads sequential ids over the whole 64-bit range
+ * @note std::hash of integers is the identity in libstdc++ and libc++; use
+ *       this as the Hash parameter when ids are not well spread (e.g.
+ *       multiples of a power of two) or when feeding them to hash_combine
+ */
+template<typename T>
+struct IntegerHash {
+    static_assert(std::is_integral_v<T>, "IntegerHash only hashes integers");
+
+    size_t operator()(T v) const noexcept {
+        return static_cast<size_t>(hashMix(static_cast<std::uint64_t>(v)));
+    }
+};
+
+/**
+ * @brief Transparent hash for std::string vertices
+ * @note Graph<std::string, graphlib::StringHash> accepts std::string_view
+ *       and const char* in its lookups without building a std::string
+ * @note Not noexcept on purpose: like std::hash<std::string>, it lets the
+ *       standard containers cache hash codes instead of rehashing strings
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view s) const {
+        return std::hash<std::string_view>{}(s);
+    }
+};
+
+/// Equality used by containers hashed with Hash: transparent if Hash is
+template<typename Vertex, typename Hash>
+using KeyEqual = std::conditional_t<requires { typename Hash::is_transparent; },
+                                    std::equal_to<>, std::equal_to<Vertex>>;
+
+namespace detail {
+
+// Modification counter behind version(). Copies keep the value; an assigned
+// counter moves past both values, so a graph never reuses a version
+struct VersionCounter {
+    std::uint64_t value = 0;
+
+    VersionCounter() = default;
+    VersionCounter(const VersionCounter&) = default;
+    VersionCounter& operator=(const VersionCounter& other) {
+        value = (value > other.value ? value : other.value) + 1;
+        return *this;
+    }
+    // A moved-from graph is left empty, so its version moves on as well
+    VersionCounter(VersionCounter&& other) noexcept : value(other.value) {
+        other.value++;
+    }
+    VersionCounter& operator=(VersionCounter&& other) noexcept {
+        value = (value > other.value ? value : other.value) + 1;
+        other.value++;
+        return *this;
+    }
+    void operator++(int) {
+        value++;
+    }
+    void operator+=(std::uint64_t n) {
+        value += n;
+    }
+};
+
+} // namespace detail
+
+} // namespace graphlib
 
 // Specialization of std::hash for std::pair
 namespace std {
     template <typename T1, typename T2>
     struct hash<std::pair<T1, T2>> {
         size_t operator()(const std::pair<T1, T2>& p) const {
-            size_t h1 = std::hash<T1>{}(p.first);
-            size_t h2 = std::hash<T2>{}(p.second);
-            // using boost hash_combine method
+            // Optimization: the xor-shift combine with the 32-bit constant
+            // clustered sequential integer pairs; combining through a full
+            // 64-bit mixer spreads them over every bucket
             // https://www.boost.org/doc/libs/latest/libs/container_hash/doc/html/hash.html#ref_hash_combine
-            return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+            std::uint64_t seed = graphlib::hashMix(0x9e3779b97f4a7c15ULL + std::hash<T1>{}(p.first));
+            return static_cast<size_t>(graphlib::hashMix(seed + 0x9e3779b97f4a7c15ULL + std::hash<T2>{}(p.second)));
         }
     };
 }
 
+/**
+ * @brief Interface for objects notified of every change made to a Graph
+ * @tparam Vertex Vertex type
+ * @note Callbacks run synchronously, right after the graph has been modified
+ * @note removeVertex(v) reports one onRemoveEdge per incident edge before
+ *       onRemoveVertex(v), so observers only need to handle single edges
+ */
+template<typename Vertex>
+class GraphObserver {
+public:
+    virtual ~GraphObserver() = default;
+    virtual void onAddVertex(const Vertex&) {}
+    virtual void onAddEdge(const Vertex&, const Vertex&) {}
+    virtual void onRemoveEdge(const Vertex&, const Vertex&) {}
+    virtual void onRemoveVertex(const Vertex&) {}
+    virtual void onClear() {}
+};
+
+/**
+ * @brief Work done by one traversal, filled by the bfs() and distance() overloads taking it
+ */
+struct TraversalStats {
+    size_t verticesExpanded = 0;        ///< Vertices whose adjacency set was scanned
+    size_t edgesScanned = 0;            ///< Adjacency entries read
+    std::vector<size_t> frontierSizes;  ///< frontierSizes[d] = vertices discovered at depth d
+};
+
+/**
+ * @brief Heap memory held by a Graph, in bytes, as returned by Graph::memoryUsage()
+ * @note Heap memory owned by the vertex values themselves (e.g. the buffer of
+ *       a long std::string) is not included
+ */
+struct MemoryUsage {
+    size_t vertexTable = 0;       ///< Bucket array and nodes of the vertex map, keys excluded
+    size_t adjacencyBuckets = 0;  ///< Bucket arrays of the adjacency sets
+    size_t adjacencyNodes = 0;    ///< Nodes of the adjacency sets, neighbor values excluded
+    size_t payload = 0;           ///< The stored vertex values: n keys and 2m neighbor entries
+
+    size_t total() const {
+        return vertexTable + adjacencyBuckets + adjacencyNodes + payload;
+    }
+};
+
+/**
+ * @brief Graph-level counters, maintained only when GRAPHLIB_STATS is defined
+ * @note Define GRAPHLIB_STATS before including graphlib.hpp to enable them;
+ *       without it Graph has no counter member and no counting code
+ */
+struct GraphCounters {
+    size_t vertexInserts = 0;   ///< Vertices created
+    size_t edgeInserts = 0;     ///< Edges created (duplicates and self-loops excluded)
+    size_t vertexRemovals = 0;  ///< Vertices removed, clear() included
+    size_t edgeRemovals = 0;    ///< Edges removed, incident edges of removed vertices included
+    size_t rehashes = 0;        ///< Bucket array growths of adj and of the adjacency sets
+    size_t bytesAllocated = 0;  ///< Estimated bytes requested for nodes and bucket arrays
+};
+
+template<typename Vertex, typename Hash>
+class MutationBatch;
+
 /**
  * @brief Class representing an undirected graph
  * @tparam Vertex Vertex type
@@ -40,8 +192,224 @@ class Graph {
 private:
     // Optimization: pass primitive types by value, complex ones by const ref
     using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+    using KeyEqual = graphlib::KeyEqual<Vertex, Hash>;
+
+public:
+    /// Adjacency set of one vertex, as returned by neighbors()
+    using NeighborSet = std::unordered_set<Vertex, Hash, KeyEqual>;
+
+    /// True when Hash is transparent: lookups then accept any key type Hash
+    /// can hash, e.g. std::string_view for graphlib::StringHash
+    static constexpr bool heterogeneousLookup = requires { typename Hash::is_transparent; };
+
+private:
+    // Lookup keys of another type than Vertex, only with a transparent Hash
+    template<typename Key>
+    static constexpr bool lookupKey = heterogeneousLookup
+        && !std::is_same_v<std::remove_cvref_t<Key>, Vertex>
+        && std::is_invocable_v<const Hash&, const Key&>;
+
+    std::unordered_map<Vertex, NeighborSet, Hash, KeyEqual> adj;
+
+    // Observers are bound to one graph instance: copies and moves start with none
+    struct ObserverList {
+        std::vector<GraphObserver<Vertex>*> list;
+
+        ObserverList() = default;
+        ObserverList(const ObserverList&) {}
+        ObserverList& operator=(const ObserverList&) { return *this; }
+    } observers;
+
+    bool observed() const {
+        return !observers.list.empty();
+    }
+
+    // Bumped by every mutation that changes the graph, see version()
+    graphlib::detail::VersionCounter mutations;
+
+    // Applies buffered mutations directly on adj
+    friend class MutationBatch<Vertex, Hash>;
+
+#ifdef GRAPHLIB_STATS
+    GraphCounters stats;
+
+    // Accounts for one insertion attempt into an unordered container; node
+    // sizes are estimated as one next pointer plus the stored value
+    template<typename Container>
+    void countGrowth(const Container& c, size_t bucketsBefore, bool inserted) {
+        if (inserted) stats.bytesAllocated += sizeof(void*) + sizeof(typename Container::value_type);
+        if (c.bucket_count() != bucketsBefore) {
+            stats.rehashes++;
+            stats.bytesAllocated += c.bucket_count() * sizeof(void*);
+        }
+    }
+#endif
+
+    // Layout of one node of a node-based unordered container: next pointer,
+    // value, then the cached hash code when the container stores it
+    template<typename Value, bool CachedHash>
+    struct NodeLayout {
+        void* next;
+        Value value;
+        size_t hash;
+    };
+
+    template<typename Value>
+    struct NodeLayout<Value, false> {
+        void* next;
+        Value value;
+    };
+
+#ifdef __GLIBCXX__
+    // libstdc++ does not cache hash codes of cheap, noexcept hash functions
+    static constexpr bool cachedHash = std::__cache_default<Vertex, Hash>::value;
+#else
+    static constexpr bool cachedHash = true;
+#endif
+
+    template<typename Value>
+    static constexpr size_t nodeBytes = sizeof(NodeLayout<Value, cachedHash>);
+
+    // Bytes of the bucket array of a container
+    template<typename Container>
+    static size_t bucketBytes(const Container& c) {
+#ifdef __GLIBCXX__
+        if (c.bucket_count() == 1) return 0; // Single bucket stored inside the container
+#endif
+        return c.bucket_count() * sizeof(void*);
+    }
+
+    // Adds to a graph-level counter, compiles to nothing without GRAPHLIB_STATS
+    void count([[maybe_unused]] size_t GraphCounters::* counter, [[maybe_unused]] size_t amount = 1) {
+#ifdef GRAPHLIB_STATS
+        stats.*counter += amount;
+#endif
+    }
 
-    std::unordered_map<Vertex, std::unordered_set<Vertex, Hash>, Hash> adj;
+    // adj.try_emplace(v), counted
+    auto emplaceVertex(const VertexParam v) {
+#ifdef GRAPHLIB_STATS
+        const size_t buckets = adj.bucket_count();
+        auto res = adj.try_emplace(v);
+        countGrowth(adj, buckets, res.second);
+        stats.vertexInserts += res.second;
+        return res;
+#else
+        return adj.try_emplace(v);
+#endif
+    }
+
+    // set.insert(v).second, counted
+    bool insertNeighbor(NeighborSet& set, const VertexParam v) {
+#ifdef GRAPHLIB_STATS
+        const size_t buckets = set.bucket_count();
+        const bool inserted = set.insert(v).second;
+        countGrowth(set, buckets, inserted);
+        return inserted;
+#else
+        return set.insert(v).second;
+#endif
+    }
+
+    // Shared by the plain and instrumented traversals; with Instrumented ==
+    // false every statistics statement is discarded at compile time
+    template<bool Instrumented>
+    std::vector<Vertex> bfsImpl(const VertexParam v, size_t maxv, [[maybe_unused]] TraversalStats* ts) const {
+        std::vector<Vertex> result;
+        if (!containsVertex(v)) return result;
+        
+        if (maxv > 0) result.reserve(maxv); // Pre-allocate if limit is known (optimization)
+        
+        std::unordered_set<Vertex, Hash> seen;
+        std::queue<Vertex> pending;
+        
+        pending.push(v);
+        seen.insert(v);
+
+        // Vertices left to expand at the current depth, and discovered at the next one
+        [[maybe_unused]] size_t levelLeft = 1, nextLevel = 0;
+        if constexpr (Instrumented) ts->frontierSizes.push_back(1);
+        
+        while (!pending.empty()) {
+            if (maxv > 0 && result.size() >= maxv) break;
+            
+            Vertex current = pending.front();
+            pending.pop();
+            result.emplace_back(current);
+            
+            auto it = adj.find(current);
+            if (it == adj.end()) continue;
+
+            if constexpr (Instrumented) {
+                ts->verticesExpanded++;
+                ts->edgesScanned += it->second.size();
+            }
+            
+            for (const Vertex& next : it->second) {
+                if (seen.insert(next).second) {
+                    pending.push(next);
+                    if constexpr (Instrumented) nextLevel++;
+                }
+            }
+
+            if constexpr (Instrumented) {
+                if (--levelLeft == 0 && nextLevel > 0) {
+                    ts->frontierSizes.push_back(nextLevel);
+                    levelLeft = nextLevel;
+                    nextLevel = 0;
+                }
+            }
+        }
+        if constexpr (Instrumented) {
+            if (nextLevel > 0) ts->frontierSizes.push_back(nextLevel);
+        }
+        return result;
+    }
+
+    template<bool Instrumented>
+    std::optional<int> distanceImpl(const VertexParam u, const VertexParam v, [[maybe_unused]] TraversalStats* ts) const {
+        if (!containsVertex(u) || !containsVertex(v)) return std::nullopt;
+        if constexpr (Instrumented) ts->frontierSizes.push_back(1);
+        if (u == v) return 0;
+        
+        std::unordered_set<Vertex, Hash> seen;
+        std::queue<Vertex> level;
+        int depth = 0;
+        
+        level.push(u);
+        seen.insert(u);
+        
+        while (!level.empty()) {
+            depth++;
+            int level_size = level.size();
+            [[maybe_unused]] size_t discovered = 0;
+            
+            for (int i = 0; i < level_size; i++) {
+                Vertex current = level.front();
+                level.pop();
+                
+                auto it = adj.find(current);
+                if (it == adj.end()) continue;
+                if constexpr (Instrumented) ts->verticesExpanded++;
+                
+                for (const Vertex& neighbor : it->second) {
+                    if constexpr (Instrumented) ts->edgesScanned++;
+                    if (neighbor == v) {
+                        if constexpr (Instrumented) ts->frontierSizes.push_back(discovered + 1);
+                        return depth;
+                    }
+                    if (seen.insert(neighbor).second) {
+                        level.push(neighbor);
+                        if constexpr (Instrumented) discovered++;
+                    }
+                }
+            }
+            if constexpr (Instrumented) {
+                if (discovered > 0) ts->frontierSizes.push_back(discovered);
+            }
+        }
+        return std::nullopt;
+    }
 
 public:
     Graph() = default;
@@ -53,7 +421,11 @@ public:
      * @note Complexity: O(1) amortized
      */
     void addVertex(const VertexParam v) {
-        adj.try_emplace(v);
+        if (!emplaceVertex(v).second) return;
+        mutations++;
+        if (observed()) {
+            for (auto* o : observers.list) o->onAddVertex(v);
+        }
     }
 
     /**
@@ -67,8 +439,27 @@ public:
      */
     void addEdge(const VertexParam u, const VertexParam v) {
         if (u == v) return;
-        adj[u].insert(v);
-        adj[v].insert(u);
+        if (!observed()) {
+            // A new endpoint always gets the edge too, so inserted covers both
+            const bool inserted = insertNeighbor(emplaceVertex(u).first->second, v);
+            insertNeighbor(emplaceVertex(v).first->second, u);
+            count(&GraphCounters::edgeInserts, inserted);
+            mutations += inserted;
+            return;
+        }
+
+        auto [itU, newU] = emplaceVertex(u);
+        auto& setU = itU->second; // References survive the rehash emplacing v may cause
+        auto [itV, newV] = emplaceVertex(v);
+        bool inserted = insertNeighbor(setU, v);
+        insertNeighbor(itV->second, u);
+        count(&GraphCounters::edgeInserts, inserted);
+        mutations += inserted;
+        for (auto* o : observers.list) {
+            if (newU) o->onAddVertex(u);
+            if (newV) o->onAddVertex(v);
+            if (inserted) o->onAddEdge(u, v);
+        }
     }
 
     /**
@@ -81,6 +472,18 @@ public:
         return adj.contains(v);
     }
 
+    /**
+     * @brief Checks if a vertex exists, looked up by an equivalent key
+     * @param v A key hashing and comparing like a vertex, e.g. a std::string_view
+     * @note Only with a transparent Hash (see heterogeneousLookup); no
+     *       temporary Vertex is built
+     * @note Complexity: O(1) amortized
+     */
+    template<typename Key> requires lookupKey<Key>
+    bool containsVertex(const Key& v) const {
+        return adj.contains(v);
+    }
+
     /**
      * @brief Checks if an edge exists between two vertices
      * @param u First vertex of the edge
@@ -98,6 +501,22 @@ public:
         return (it != adj.end()) && it->second.contains(v);
     }
 
+    /**
+     * @brief Checks if an edge exists, looked up by equivalent keys
+     * @param u First vertex of the edge, as a key hashing and comparing like a vertex
+     * @param v Second vertex of the edge, likewise
+     * @note Only with a transparent Hash (see heterogeneousLookup)
+     * @note Complexity: O(1) amortized
+     */
+    template<typename KeyU, typename KeyV> requires (lookupKey<KeyU> || lookupKey<KeyV>)
+                                                 && std::is_invocable_v<const Hash&, const KeyU&>
+                                                 && std::is_invocable_v<const Hash&, const KeyV&>
+    bool containsEdge(const KeyU& u, const KeyV& v) const {
+        // Adjacency sets never hold their own vertex, so self-loops are false here too
+        auto it = adj.find(u);
+        return (it != adj.end()) && it->second.contains(v);
+    }
+
     /**
      * @brief Returns the degree (number of neighbors) of a vertex
      * @param v The vertex to check
@@ -109,6 +528,18 @@ public:
         return (it != adj.end()) ? it->second.size() : 0;
     }
 
+    /**
+     * @brief Returns the degree of a vertex looked up by an equivalent key
+     * @param v A key hashing and comparing like a vertex, e.g. a std::string_view
+     * @note Only with a transparent Hash (see heterogeneousLookup)
+     * @note Complexity: O(1) amortized
+     */
+    template<typename Key> requires lookupKey<Key>
+    size_t degree(const Key& v) const {
+        auto it = adj.find(v);
+        return (it != adj.end()) ? it->second.size() : 0;
+    }
+
     /**
      * @brief Returns the maximum degree in the graph
      * @return The maximum degree, or 0 if the graph is empty
@@ -145,6 +576,48 @@ public:
         return total / 2;
     }
 
+    /**
+     * @brief Returns the heap memory used by the graph, broken down by structure
+     * @return Estimated bytes; exact with libstdc++ and the default allocator,
+     *         malloc bookkeeping aside
+     * @note Complexity: O(n) where n is the number of vertices
+     */
+    MemoryUsage memoryUsage() const {
+        using AdjSet = NeighborSet;
+        MemoryUsage res;
+        res.vertexTable = bucketBytes(adj) + adj.size() * (nodeBytes<typename decltype(adj)::value_type> - sizeof(Vertex));
+        res.payload = adj.size() * sizeof(Vertex);
+        for (const auto& [_, neighbors] : adj) {
+            res.adjacencyBuckets += bucketBytes(neighbors);
+            res.adjacencyNodes += neighbors.size() * (nodeBytes<typename AdjSet::value_type> - sizeof(Vertex));
+            res.payload += neighbors.size() * sizeof(Vertex);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Shrinks the bucket arrays that are larger than their contents need
+     * @return The number of bytes released
+     * @note Hash tables never shrink on erase: after heavy removeEdge/removeVertex
+     *       churn, this rehashes every oversized table down to the size that
+     *       insertions would have produced
+     * @note Invalidates iterators, but not references to vertices or neighbor sets
+     * @note Complexity: O(n + m)
+     */
+    size_t shrinkToFit() {
+        size_t released = 0;
+        auto shrink = [&](auto& table) {
+            const size_t before = bucketBytes(table);
+            if (table.bucket_count() * table.max_load_factor() > 2 * table.size() + 1) {
+                table.rehash(0);
+            }
+            released += before - bucketBytes(table);
+        };
+        for (auto& [_, neighbors] : adj) shrink(neighbors);
+        shrink(adj);
+        return released;
+    }
+
     /**
      * @brief Removes an edge between two vertices
      * @param u First vertex of the edge
@@ -155,11 +628,18 @@ public:
     void removeEdge(const VertexParam u, const VertexParam v) {
         if (u == v) return; 
         
+        size_t erased = 0;
         auto itU = adj.find(u);
-        if (itU != adj.end()) itU->second.erase(v);
+        if (itU != adj.end()) erased = itU->second.erase(v);
         
         auto itV = adj.find(v);
         if (itV != adj.end()) itV->second.erase(u);
+        count(&GraphCounters::edgeRemovals, erased);
+        mutations += erased;
+
+        if (erased && observed()) {
+            for (auto* o : observers.list) o->onRemoveEdge(u, v);
+        }
     }
 
     /**
@@ -171,7 +651,24 @@ public:
     void removeVertex(const VertexParam v) {
         auto it = adj.find(v);
         if (it == adj.end()) return;
+        mutations++;
+        count(&GraphCounters::vertexRemovals);
+        count(&GraphCounters::edgeRemovals, it->second.size());
         
+        if (observed()) {
+            // Detach edges one at a time so observers always see a consistent graph
+            while (!it->second.empty()) {
+                Vertex neighbor = *it->second.begin();
+                it->second.erase(it->second.begin());
+                adj[neighbor].erase(v);
+                for (auto* o : observers.list) o->onRemoveEdge(v, neighbor);
+            }
+            Vertex removed = it->first;
+            adj.erase(it);
+            for (auto* o : observers.list) o->onRemoveVertex(removed);
+            return;
+        }
+
         for (const auto& neighbor : it->second) {
             adj[neighbor].erase(v);
         }
@@ -184,7 +681,69 @@ public:
      * @note Complexity: O(n + m) linear in the size of the graph
      */
     void clear() {
+#ifdef GRAPHLIB_STATS
+        stats.vertexRemovals += adj.size();
+        stats.edgeRemovals += countEdges();
+#endif
+        if (!adj.empty()) mutations++;
         adj.clear();
+        for (auto* o : observers.list) o->onClear();
+    }
+
+    /**
+     * @brief Returns the version of the graph, a counter bumped by every modification
+     * @return A value that changes whenever addVertex, addEdge, removeEdge,
+     *         removeVertex or clear modifies the graph; calls that leave the
+     *         graph unchanged keep it. Applying a non-empty MutationBatch bumps it
+     * @note Lets callers cache results computed on the graph and detect that
+     *       they went stale with one comparison
+     * @note Copies start with the version of their source; assigning a graph
+     *       gives it a version above both the old and the assigned one
+     * @note Complexity: O(1)
+     */
+    std::uint64_t version() const {
+        return mutations.value;
+    }
+
+#ifdef GRAPHLIB_STATS
+    static constexpr bool statsEnabled = true;
+
+    /**
+     * @brief Returns the graph-level counters accumulated since construction or the last reset
+     * @note Only available when GRAPHLIB_STATS is defined
+     */
+    const GraphCounters& counters() const {
+        return stats;
+    }
+
+    /**
+     * @brief Resets every graph-level counter to zero
+     * @note Only available when GRAPHLIB_STATS is defined
+     */
+    void resetCounters() {
+        stats = {};
+    }
+#else
+    static constexpr bool statsEnabled = false;
+#endif
+
+    /**
+     * @brief Registers an observer notified of every subsequent modification
+     * @param o The observer, must stay valid until detached
+     * @note Observers are not copied or moved along with the graph
+     * @note Complexity: O(1) amortized
+     */
+    void attach(GraphObserver<Vertex>* o) {
+        observers.list.push_back(o);
+    }
+
+    /**
+     * @brief Unregisters an observer
+     * @param o The observer to remove, no effect if it is not attached
+     * @note Complexity: O(k) where k is the number of observers
+     */
+    void detach(GraphObserver<Vertex>* o) {
+        std::erase(observers.list, o);
     }
 
     /**
@@ -225,8 +784,21 @@ public:
      * @note Returns an empty set if v is not in the graph
      * @note Complexity: O(1)
      */
-    const std::unordered_set<Vertex>& neighbors(const VertexParam v) const {
-        static const std::unordered_set<Vertex> empty;
+    const NeighborSet& neighbors(const VertexParam v) const {
+        static const NeighborSet empty;
+        auto it = adj.find(v);
+        return (it != adj.end()) ? it->second : empty;
+    }
+
+    /**
+     * @brief Returns the set of neighbors of a vertex, looked up by an equivalent key
+     * @param v A key hashing and comparing like a vertex, e.g. a std::string_view
+     * @note Only with a transparent Hash (see heterogeneousLookup)
+     * @note Complexity: O(1)
+     */
+    template<typename Key> requires lookupKey<Key>
+    const NeighborSet& neighbors(const Key& v) const {
+        static const NeighborSet empty;
         auto it = adj.find(v);
         return (it != adj.end()) ? it->second : empty;
     }
@@ -241,7 +813,7 @@ public:
         auto it = adj.find(v);
         if (it == adj.end()) return {};
         
-        std::unordered_set<Vertex> res = it->second;
+        std::unordered_set<Vertex> res(it->second.begin(), it->second.end());
         res.insert(v);
         return res;
     }
@@ -255,34 +827,20 @@ public:
      * @note Complexity: O(V + E) where V is visited vertices and E visited edges
      */
     std::vector<Vertex> bfs(const VertexParam v, size_t maxv = 0) const {
-        std::vector<Vertex> result;
-        if (!containsVertex(v)) return result;
-        
-        if (maxv > 0) result.reserve(maxv); // Pre-allocate if limit is known (optimization)
-        
-        std::unordered_set<Vertex, Hash> seen;
-        std::queue<Vertex> pending;
-        
-        pending.push(v);
-        seen.insert(v);
-        
-        while (!pending.empty()) {
-            if (maxv > 0 && result.size() >= maxv) break;
-            
-            Vertex current = pending.front();
-            pending.pop();
-            result.emplace_back(current);
-            
-            auto it = adj.find(current);
-            if (it == adj.end()) continue;
-            
-            for (const Vertex& next : it->second) {
-                if (seen.insert(next).second) {
-                    pending.push(next);
-                }
-            }
-        }
-        return result;
+        return bfsImpl<false>(v, maxv, nullptr);
+    }
+
+    /**
+     * @brief Performs a BFS like bfs(v, maxv) and reports the work it did
+     * @param v The starting vertex
+     * @param maxv Maximum number of vertices to visit (0 for unlimited)
+     * @param stats Overwritten with the traversal statistics
+     * @return A vector of visited vertices in BFS order
+     * @note Always available; the plain overload does not pay for it
+     */
+    std::vector<Vertex> bfs(const VertexParam v, size_t maxv, TraversalStats& stats) const {
+        stats = {};
+        return bfsImpl<true>(v, maxv, &stats);
     }
 
     /**
@@ -293,36 +851,105 @@ public:
      * @note Complexity: O(V + E) for BFS traversal
      */
     std::optional<int> distance(const VertexParam u, const VertexParam v) const {
-        if (!containsVertex(u) || !containsVertex(v)) return std::nullopt;
-        if (u == v) return 0;
-        
-        std::unordered_set<Vertex, Hash> seen;
-        std::queue<Vertex> level;
-        int depth = 0;
-        
-        level.push(u);
-        seen.insert(u);
-        
-        while (!level.empty()) {
-            depth++;
-            int level_size = level.size();
-            
-            for (int i = 0; i < level_size; i++) {
-                Vertex current = level.front();
-                level.pop();
-                
-                auto it = adj.find(current);
-                if (it == adj.end()) continue;
-                
-                for (const Vertex& neighbor : it->second) {
-                    if (neighbor == v) return depth;
-                    if (seen.insert(neighbor).second) {
-                        level.push(neighbor);
+        return distanceImpl<false>(u, v, nullptr);
+    }
+
+    /**
+     * @brief Calculates the distance like distance(u, v) and reports the work it did
+     * @param u Start vertex
+     * @param v End vertex
+     * @param stats Overwritten with the traversal statistics; the search stops
+     *        at the target, so the last frontier size only counts the vertices
+     *        found at the target depth up to and including the target
+     * @return The distance if a path exists, std::nullopt otherwise
+     */
+    std::optional<int> distance(const VertexParam u, const VertexParam v, TraversalStats& stats) const {
+        stats = {};
+        return distanceImpl<true>(u, v, &stats);
+    }
+
+    /**
+     * @brief Calls fn on every vertex, in parallel
+     * @param policy Thread count and chunking, e.g. {.threads = 8}
+     * @param fn Callable invoked as fn(const Vertex& v) or fn(const Vertex& v, size_t worker),
+     *        worker being in [0, threads) to index per-thread accumulators
+     * @note The vertices are split by ranges of hash buckets into
+     *       threads * tasksPerThread chunks, run on a work-stealing pool
+     * @note fn must not modify the graph; calls run concurrently
+     * @note Complexity: O(n) work
+     */
+    template<typename Fn>
+    void forEachVertex(const graphlib::ParallelPolicy& policy, Fn&& fn) const {
+        const size_t threads = policy.threads ? policy.threads : graphlib::hardwareThreads();
+        const size_t buckets = adj.bucket_count();
+        const size_t tasks = std::min(buckets, std::max<size_t>(1, threads * policy.tasksPerThread));
+        graphlib::parallelTasks(tasks, threads, [&](size_t t, size_t worker) {
+            for (size_t b = buckets * t / tasks; b < buckets * (t + 1) / tasks; b++) {
+                for (auto it = adj.begin(b); it != adj.end(b); ++it) {
+                    graphlib::detail::invokeWithWorker(fn, worker, it->first);
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Calls fn once per edge, in parallel
+     * @param policy Thread count and chunking, e.g. {.threads = 8}
+     * @param fn Callable invoked as fn(const Vertex& u, const Vertex& v) with
+     *        u < v, or with an extra size_t worker argument
+     * @note Vertices are split by ranges of hash buckets like forEachVertex();
+     *       a vertex with more than policy.splitDegree neighbors is set aside
+     *       and its neighbor set is split by bucket ranges in a second pass,
+     *       so a hub is shared by several threads instead of stalling one
+     * @note fn must not modify the graph; calls run concurrently
+     * @note Complexity: O(n + m) work
+     */
+    template<typename Fn>
+    void forEachEdge(const graphlib::ParallelPolicy& policy, Fn&& fn) const {
+        const size_t threads = policy.threads ? policy.threads : graphlib::hardwareThreads();
+        const size_t splitDegree = std::max<size_t>(1, policy.splitDegree);
+        const size_t buckets = adj.bucket_count();
+        const size_t tasks = std::min(buckets, std::max<size_t>(1, threads * policy.tasksPerThread));
+        using Entry = typename decltype(adj)::value_type;
+        std::vector<std::vector<const Entry*>> hubs(threads);
+
+        graphlib::parallelTasks(tasks, threads, [&](size_t t, size_t worker) {
+            for (size_t b = buckets * t / tasks; b < buckets * (t + 1) / tasks; b++) {
+                for (auto it = adj.begin(b); it != adj.end(b); ++it) {
+                    if (it->second.size() > splitDegree) {
+                        hubs[worker].push_back(&*it);
+                        continue;
+                    }
+                    for (const Vertex& v : it->second) {
+                        if (it->first < v) graphlib::detail::invokeWithWorker(fn, worker, it->first, v);
                     }
                 }
             }
+        });
+
+        // Second pass: one task per splitDegree neighbors of each hub
+        struct HubTask {
+            const Entry* hub;
+            size_t firstBucket, lastBucket;
+        };
+        std::vector<HubTask> hubTasks;
+        for (const auto& list : hubs) {
+            for (const Entry* hub : list) {
+                const size_t parts = (hub->second.size() + splitDegree - 1) / splitDegree;
+                const size_t setBuckets = hub->second.bucket_count();
+                for (size_t p = 0; p < parts; p++) {
+                    hubTasks.push_back({hub, setBuckets * p / parts, setBuckets * (p + 1) / parts});
+                }
+            }
         }
-        return std::nullopt;
+        graphlib::parallelTasks(hubTasks.size(), threads, [&](size_t t, size_t worker) {
+            const auto& [hub, first, last] = hubTasks[t];
+            for (size_t b = first; b < last; b++) {
+                for (auto it = hub->second.begin(b); it != hub->second.end(b); ++it) {
+                    if (hub->first < *it) graphlib::detail::invokeWithWorker(fn, worker, hub->first, *it);
+                }
+            }
+        });
     }
 
     /**
@@ -359,10 +986,10 @@ public:
         using reference = const Vertex&;
 
     private:
-        typename std::unordered_map<Vertex, std::unordered_set<Vertex, Hash>, Hash>::const_iterator it;
+        typename std::unordered_map<Vertex, NeighborSet, Hash, KeyEqual>::const_iterator it;
 
     public:
-        iterator(typename std::unordered_map<Vertex, std::unordered_set<Vertex, Hash>, Hash>::const_iterator i) : it(i) {}
+        iterator(typename std::unordered_map<Vertex, NeighborSet, Hash, KeyEqual>::const_iterator i) : it(i) {}
         
         reference operator*() const { return it->first; }
         pointer operator->() const { return &(it->first); }
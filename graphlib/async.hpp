@@ -0,0 +1,498 @@
+/**
+ * @file graphlib/async.hpp
+ * @brief Coroutine queries on a bounded executor, with cooperative yielding,
+ *        cancellation and deadlines
+ *
+ * Graph::distance() and Graph::bfs() run to completion on the calling
+ * thread, so a server answering them on a fixed pool stalls cheap queries
+ * behind expensive ones. QueryExecutor runs the same traversals as C++20
+ * coroutines: every `yieldEvery` expanded vertices a query goes back to the
+ * end of the run queue, so a long traversal only holds a thread for a time
+ * slice and short queries submitted after it still finish quickly.
+ */
+
+#ifndef GRAPHLIB_ASYNC_HPP
+#define GRAPHLIB_ASYNC_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stop_token>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+
+/**
+ * @brief How a query ended
+ */
+enum class QueryStatus {
+    Ok,               ///< The query ran to completion and its value is set
+    Cancelled,        ///< Stop was requested on its stop token, or the executor shut down
+    DeadlineExceeded, ///< The deadline passed before the query completed
+    Rejected,         ///< The executor was full (or shutting down) when the query was submitted
+    Failed            ///< The traversal threw (std::bad_alloc, a throwing hash...); see QueryResult::error
+};
+
+/**
+ * @brief Outcome of a query: a status and, if the status is Ok, its value
+ * @note If the status is Failed, error holds the exception the traversal
+ *       threw; std::rethrow_exception(error) raises it again
+ */
+template<typename T>
+struct QueryResult {
+    QueryStatus status = QueryStatus::Ok;
+    T value{};
+    std::exception_ptr error{};
+
+    bool ok() const {
+        return status == QueryStatus::Ok;
+    }
+};
+
+/**
+ * @brief Per-query cancellation and deadline
+ * @note Both are checked when the query starts and at every yield point,
+ *       so a query stops at most `yieldEvery` vertices after either fires
+ */
+struct QueryOptions {
+    std::stop_token stop{}; ///< Cancels the query when stop is requested on its source
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
+/**
+ * @brief Construction parameters of a QueryExecutor
+ */
+struct QueryExecutorOptions {
+    std::size_t threads = 0;          ///< Worker threads, 0 for hardwareThreads()
+    std::size_t queueCapacity = 1024; ///< Queries admitted at once, running or queued; more are Rejected
+    std::size_t yieldEvery = 64;      ///< Vertices a query expands before yielding its thread
+};
+
+namespace graphlib::detail {
+
+// Result slot shared by a running query and the Query handles waiting on it
+template<typename T>
+struct QueryState {
+    std::mutex lock;
+    std::condition_variable doneSignal;
+    bool done = false;
+    QueryResult<T> result;
+    std::coroutine_handle<> continuation;
+
+    // Publishes the result and wakes get(); returns the awaiting coroutine, if any
+    [[nodiscard]] std::coroutine_handle<> publish(QueryResult<T>&& r) {
+        std::coroutine_handle<> next;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            result = std::move(r);
+            done = true;
+            next = std::exchange(continuation, nullptr);
+        }
+        doneSignal.notify_all();
+        return next;
+    }
+
+    // Publishes the result and resumes an awaiting coroutine on this thread
+    void complete(QueryResult<T>&& r) {
+        if (auto next = publish(std::move(r))) next.resume();
+    }
+};
+
+// Run queue and worker threads; the non-template part of QueryExecutor
+class QueryScheduler {
+private:
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::deque<std::coroutine_handle<>> ready;
+    std::size_t capacity;
+    std::size_t live = 0; // Admitted queries not finished yet
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> workers;
+
+    void work() {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;) {
+            wake.wait(guard, [&] { return !ready.empty() || (stopping && live == 0); });
+            if (ready.empty()) return;
+            auto h = ready.front();
+            ready.pop_front();
+            guard.unlock();
+            h.resume();
+            guard.lock();
+        }
+    }
+
+public:
+    const std::size_t yieldEvery;
+
+    explicit QueryScheduler(const QueryExecutorOptions& opts)
+        : capacity(opts.queueCapacity == 0 ? 1 : opts.queueCapacity),
+          yieldEvery(opts.yieldEvery == 0 ? std::numeric_limits<std::size_t>::max() : opts.yieldEvery) {
+        const std::size_t threads = opts.threads == 0 ? hardwareThreads() : opts.threads;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; t++) workers.emplace_back([this] { work(); });
+    }
+
+    QueryScheduler(const QueryScheduler&) = delete;
+    QueryScheduler& operator=(const QueryScheduler&) = delete;
+
+    // Queries still queued see isStopping() and end as Cancelled at their next check
+    ~QueryScheduler() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& th : workers) th.join();
+    }
+
+    // Reserves a slot for a new query; false if the executor is full or stopping
+    bool admit() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (stopping || live >= capacity) return false;
+        live++;
+        return true;
+    }
+
+    // Appends an admitted query to the run queue
+    void post(std::coroutine_handle<> h) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ready.push_back(h);
+        }
+        wake.notify_one();
+    }
+
+    // Releases the slot of a query that completed
+    void finished() {
+        bool last;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            last = --live == 0;
+        }
+        if (last) {
+            drained.notify_all();
+            if (stopping) wake.notify_all();
+        }
+    }
+
+    // Blocks until no admitted query is left
+    void waitIdle() {
+        std::unique_lock<std::mutex> guard(lock);
+        drained.wait(guard, [&] { return live == 0; });
+    }
+
+    std::size_t pending() {
+        std::lock_guard<std::mutex> guard(lock);
+        return live;
+    }
+
+    std::size_t threadCount() const {
+        return workers.size();
+    }
+
+    bool isStopping() const {
+        return stopping.load(std::memory_order_relaxed);
+    }
+
+    QueryStatus check(const QueryOptions& opts) const {
+        if (opts.stop.stop_requested() || isStopping()) return QueryStatus::Cancelled;
+        if (opts.deadline != std::chrono::steady_clock::time_point::max()
+            && std::chrono::steady_clock::now() >= opts.deadline) {
+            return QueryStatus::DeadlineExceeded;
+        }
+        return QueryStatus::Ok;
+    }
+};
+
+// Coroutine type of the traversals; only QueryExecutor creates and starts them
+template<typename T>
+struct QueryTask {
+    struct promise_type {
+        QueryScheduler& scheduler;
+        std::shared_ptr<QueryState<T>> state = std::make_shared<QueryState<T>>();
+        QueryResult<T> result;
+
+        // The traversals take the scheduler as their first parameter
+        template<typename... Args>
+        explicit promise_type(QueryScheduler& s, const Args&...) : scheduler(s) {}
+
+        QueryTask get_return_object() {
+            return {std::coroutine_handle<promise_type>::from_promise(*this), state};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Publishes the result before releasing the executor slot, so that
+        // waitIdle() never returns ahead of ready(); the continuation is
+        // resumed last, once the slot is free to submit a new query
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                QueryScheduler& s = h.promise().scheduler;
+                auto st = std::move(h.promise().state);
+                auto res = std::move(h.promise().result);
+                h.destroy();
+                auto next = st->publish(std::move(res));
+                s.finished();
+                if (next) next.resume();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(QueryResult<T> r) {
+            result = std::move(r);
+        }
+
+        void unhandled_exception() {
+            result = {QueryStatus::Failed, T{}, std::current_exception()};
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+    std::shared_ptr<QueryState<T>> state;
+};
+
+// Awaited every `yieldEvery` vertices: requeues the query at the back of the
+// run queue, unless it was cancelled or is past its deadline
+struct YieldPoint {
+    QueryScheduler& scheduler;
+    const QueryOptions& opts;
+    QueryStatus status = QueryStatus::Ok;
+
+    bool await_ready() {
+        status = scheduler.check(opts);
+        return status != QueryStatus::Ok;
+    }
+    void await_suspend(std::coroutine_handle<> h) {
+        scheduler.post(h);
+    }
+    QueryStatus await_resume() {
+        return status == QueryStatus::Ok ? scheduler.check(opts) : status;
+    }
+};
+
+template<typename G>
+using QueryVertex = typename G::NeighborSet::key_type;
+
+template<typename G>
+using QuerySeenSet = std::unordered_set<QueryVertex<G>, typename G::NeighborSet::hasher,
+                                        typename G::NeighborSet::key_equal>;
+
+// Level-by-level BFS of Graph::distance() with yield points
+template<typename G>
+QueryTask<std::optional<int>> distanceQuery(QueryScheduler& s, const G& g, QueryVertex<G> u, QueryVertex<G> v,
+                                            QueryOptions opts) {
+    using Vertex = QueryVertex<G>;
+    if (QueryStatus st = s.check(opts); st != QueryStatus::Ok) co_return {st, std::nullopt};
+    if (!g.containsVertex(u) || !g.containsVertex(v)) co_return {QueryStatus::Ok, std::nullopt};
+    if (u == v) co_return {QueryStatus::Ok, 0};
+
+    QuerySeenSet<G> seen;
+    std::queue<Vertex> level;
+    level.push(u);
+    seen.insert(u);
+    std::size_t budget = s.yieldEvery;
+    int depth = 0;
+
+    while (!level.empty()) {
+        depth++;
+        for (std::size_t i = level.size(); i > 0; i--) {
+            if (--budget == 0) {
+                budget = s.yieldEvery;
+                if (QueryStatus st = co_await YieldPoint{s, opts}; st != QueryStatus::Ok) co_return {st, std::nullopt};
+            }
+            Vertex current = std::move(level.front());
+            level.pop();
+            for (const Vertex& next : g.neighbors(current)) {
+                if (next == v) co_return {QueryStatus::Ok, depth};
+                if (seen.insert(next).second) level.push(next);
+            }
+        }
+    }
+    co_return {QueryStatus::Ok, std::nullopt};
+}
+
+// Graph::bfs() with yield points
+template<typename G>
+QueryTask<std::vector<QueryVertex<G>>> bfsQuery(QueryScheduler& s, const G& g, QueryVertex<G> source,
+                                                std::size_t maxv, QueryOptions opts) {
+    using Vertex = QueryVertex<G>;
+    std::vector<Vertex> result;
+    if (QueryStatus st = s.check(opts); st != QueryStatus::Ok) co_return {st, {}};
+    if (!g.containsVertex(source)) co_return {QueryStatus::Ok, {}};
+    if (maxv > 0) result.reserve(maxv);
+
+    QuerySeenSet<G> seen;
+    std::queue<Vertex> pending;
+    pending.push(source);
+    seen.insert(source);
+    std::size_t budget = s.yieldEvery;
+
+    while (!pending.empty() && (maxv == 0 || result.size() < maxv)) {
+        if (--budget == 0) {
+            budget = s.yieldEvery;
+            if (QueryStatus st = co_await YieldPoint{s, opts}; st != QueryStatus::Ok) co_return {st, {}};
+        }
+        result.push_back(std::move(pending.front()));
+        pending.pop();
+        for (const Vertex& next : g.neighbors(result.back())) {
+            if (seen.insert(next).second) pending.push(next);
+        }
+    }
+    co_return {QueryStatus::Ok, std::move(result)};
+}
+
+} // namespace graphlib::detail
+
+/**
+ * @brief Handle on the result of a submitted query
+ * @tparam T Value type of the query
+ * @note Either co_await it from a coroutine, which resumes on the executor
+ *       thread that completed the query, or block on get(). Await a Query at
+ *       most once. A coroutine resumed by a query should not block, since it
+ *       holds an executor thread
+ * @note Dropping a Query does not cancel it; use QueryOptions::stop
+ */
+template<typename T>
+class Query {
+private:
+    std::shared_ptr<graphlib::detail::QueryState<T>> state;
+
+public:
+    explicit Query(std::shared_ptr<graphlib::detail::QueryState<T>> s) : state(std::move(s)) {}
+
+    /**
+     * @brief Checks if the query completed
+     */
+    bool ready() const {
+        std::lock_guard<std::mutex> guard(state->lock);
+        return state->done;
+    }
+
+    /**
+     * @brief Blocks until the query completes and returns its result
+     */
+    const QueryResult<T>& get() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        state->doneSignal.wait(guard, [&] { return state->done; });
+        return state->result;
+    }
+
+    bool await_ready() const {
+        return ready();
+    }
+
+    bool await_suspend(std::coroutine_handle<> h) {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (state->done) return false;
+        state->continuation = h;
+        return true;
+    }
+
+    QueryResult<T> await_resume() {
+        return std::move(state->result);
+    }
+};
+
+/**
+ * @brief Runs distance and BFS queries as coroutines on a fixed pool of threads
+ * @note At most `queueCapacity` queries are admitted at once; a query
+ *       submitted beyond that completes immediately as Rejected, so callers
+ *       shed load instead of queueing without bound
+ * @note Threads take queries from one FIFO run queue. A query runs until it
+ *       has expanded `yieldEvery` vertices, then goes back to the end of the
+ *       queue: a traversal of the whole graph takes n / yieldEvery turns,
+ *       and a query touching fewer vertices finishes in its first turn
+ * @note The graphs must not be modified while queries on them are admitted
+ * @note The destructor cancels the queries left and joins the threads
+ */
+class QueryExecutor {
+private:
+    graphlib::detail::QueryScheduler scheduler;
+
+    template<typename T>
+    Query<T> submit(graphlib::detail::QueryTask<T> task) {
+        Query<T> query(task.state);
+        if (!scheduler.admit()) {
+            task.handle.destroy();
+            task.state->complete({QueryStatus::Rejected, T{}});
+        } else {
+            scheduler.post(task.handle);
+        }
+        return query;
+    }
+
+public:
+    explicit QueryExecutor(const QueryExecutorOptions& opts = {}) : scheduler(opts) {}
+
+    QueryExecutor(const QueryExecutor&) = delete;
+    QueryExecutor& operator=(const QueryExecutor&) = delete;
+
+    /**
+     * @brief Computes the distance between two vertices, like Graph::distance()
+     * @param g The graph (Graph, DenseGraph or any graph with the same
+     *          containsVertex/neighbors interface); must outlive the query
+     * @param u Source vertex
+     * @param v Target vertex
+     * @param opts Cancellation token and deadline
+     * @return The query; its value is std::nullopt when no path exists
+     */
+    template<typename G>
+    Query<std::optional<int>> distance(const G& g, graphlib::detail::QueryVertex<G> u,
+                                       graphlib::detail::QueryVertex<G> v, QueryOptions opts = {}) {
+        return submit(graphlib::detail::distanceQuery(scheduler, g, std::move(u), std::move(v), std::move(opts)));
+    }
+
+    /**
+     * @brief Lists the vertices reachable from a source in BFS order, like Graph::bfs()
+     * @param g The graph; must outlive the query
+     * @param v Source vertex
+     * @param maxv Stop after this many vertices (0 for no limit)
+     * @param opts Cancellation token and deadline
+     */
+    template<typename G>
+    Query<std::vector<graphlib::detail::QueryVertex<G>>> bfs(const G& g, graphlib::detail::QueryVertex<G> v,
+                                                             std::size_t maxv = 0, QueryOptions opts = {}) {
+        return submit(graphlib::detail::bfsQuery(scheduler, g, std::move(v), maxv, std::move(opts)));
+    }
+
+    /**
+     * @brief Blocks until every admitted query has completed
+     */
+    void waitIdle() {
+        scheduler.waitIdle();
+    }
+
+    /**
+     * @brief Returns the number of admitted queries not completed yet
+     * @note A query's slot is released just after its result is published,
+     *       so a query whose get() has returned may still be counted briefly
+     */
+    std::size_t pending() {
+        return scheduler.pending();
+    }
+
+    /**
+     * @brief Returns the number of worker threads
+     */
+    std::size_t threads() const {
+        return scheduler.threadCount();
+    }
+};
+
+#endif
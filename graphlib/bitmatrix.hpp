@@ -0,0 +1,338 @@
+/**
+ * @file graphlib/bitmatrix.hpp
+ * @brief Adjacency bit matrix for small dense graphs on vertices 0..n-1
+ *
+ * Row u of an n x n bit matrix has bit v set when the edge {u, v} exists.
+ * For a few thousand vertices and a high density this is both smaller and
+ * faster than one hash set per vertex: an edge test reads one bit, a degree
+ * is a popcount of one row, and set operations on neighborhoods (common
+ * neighbors, triangles, BFS frontiers) run 64 vertices per instruction.
+ */
+
+#ifndef GRAPHLIB_BITMATRIX_HPP
+#define GRAPHLIB_BITMATRIX_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Undirected graph on vertices 0..n-1 stored as an adjacency bit matrix
+ * @note The vertex set is fixed at construction; ids outside [0, n) are
+ *       ignored by the mutators and are never neighbors
+ * @note Memory: n * ceil(n / 64) * 8 bytes, e.g. 2 MB for n = 4096, whatever
+ *       the number of edges. For sparse graphs prefer Graph or CSRGraph
+ * @note The loops over the words of a row have no branches, so the compiler
+ *       vectorizes them (SSE2 by default, wider with -march=native)
+ */
+class BitMatrixGraph {
+public:
+    using Id = std::uint32_t;
+    using Word = std::uint64_t;
+
+    /// Distance of vertices not reached by bfs()
+    static constexpr Id unreachable = std::numeric_limits<Id>::max();
+
+private:
+    static constexpr std::size_t wordBits = 64;
+
+    std::size_t n = 0;
+    std::size_t stride = 0; // Words per row
+    std::size_t edgeCount = 0;
+    std::vector<Word> bits;
+
+    Word* rowData(Id u) { return bits.data() + u * stride; }
+    const Word* rowData(Id u) const { return bits.data() + u * stride; }
+
+    static Word mask(Id v) { return Word{1} << (v % wordBits); }
+
+    bool valid(Id u, Id v) const {
+        return u != v && u < n && v < n;
+    }
+
+    // Calls fn(v) for every bit v set in words[0..count)
+    template<typename Fn>
+    static void forEachBit(const Word* words, std::size_t count, Fn&& fn) {
+        for (std::size_t k = 0; k < count; k++) {
+            for (Word w = words[k]; w; w &= w - 1) {
+                fn(static_cast<Id>(k * wordBits + static_cast<std::size_t>(std::countr_zero(w))));
+            }
+        }
+    }
+
+public:
+    BitMatrixGraph() = default;
+
+    /**
+     * @brief Creates a graph with n isolated vertices
+     * @param vertices Number of vertices n
+     * @note Complexity: O(n^2 / 64)
+     */
+    explicit BitMatrixGraph(std::size_t vertices)
+        : n(vertices), stride((vertices + wordBits - 1) / wordBits), bits(n * stride, 0) {}
+
+    /**
+     * @brief Builds a graph from an edge list
+     * @param vertices Number of vertices n
+     * @param edges Undirected edges; self-loops, duplicates and endpoints >= n are dropped
+     * @note Complexity: O(n^2 / 64 + m)
+     */
+    static BitMatrixGraph fromEdgeList(std::size_t vertices, const std::vector<std::pair<Id, Id>>& edges) {
+        BitMatrixGraph g(vertices);
+        for (const auto& [u, v] : edges) g.addEdge(u, v);
+        return g;
+    }
+
+    /**
+     * @brief Returns the number of vertices n
+     */
+    std::size_t countVertices() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the number of edges
+     * @note Complexity: O(1)
+     */
+    std::size_t countEdges() const {
+        return edgeCount;
+    }
+
+    /**
+     * @brief Returns the bytes used by the matrix
+     */
+    std::size_t memoryUsage() const {
+        return bits.size() * sizeof(Word);
+    }
+
+    /**
+     * @brief Adds the edge {u, v}
+     * @note No effect if it exists, if u == v or if an endpoint is >= n
+     * @note Complexity: O(1)
+     */
+    void addEdge(Id u, Id v) {
+        if (!valid(u, v)) return;
+        Word& w = rowData(u)[v / wordBits];
+        if (w & mask(v)) return;
+        w |= mask(v);
+        rowData(v)[u / wordBits] |= mask(u);
+        edgeCount++;
+    }
+
+    /**
+     * @brief Removes the edge {u, v}, if it exists
+     * @note Complexity: O(1)
+     */
+    void removeEdge(Id u, Id v) {
+        if (!valid(u, v)) return;
+        Word& w = rowData(u)[v / wordBits];
+        if (!(w & mask(v))) return;
+        w &= ~mask(v);
+        rowData(v)[u / wordBits] &= ~mask(u);
+        edgeCount--;
+    }
+
+    /**
+     * @brief Removes every edge of a vertex; the vertex itself stays
+     * @note Complexity: O(n / 64 + d)
+     */
+    void isolateVertex(Id u) {
+        if (u >= n) return;
+        Word* row = rowData(u);
+        forEachBit(row, stride, [&](Id v) { rowData(v)[u / wordBits] &= ~mask(u); });
+        edgeCount -= degree(u);
+        std::fill(row, row + stride, 0);
+    }
+
+    /**
+     * @brief Removes every edge
+     * @note Complexity: O(n^2 / 64)
+     */
+    void clear() {
+        std::fill(bits.begin(), bits.end(), 0);
+        edgeCount = 0;
+    }
+
+    /**
+     * @brief Checks if the edge {u, v} exists
+     * @note Complexity: O(1), one bit test
+     */
+    bool containsEdge(Id u, Id v) const {
+        return u < n && v < n && (rowData(u)[v / wordBits] & mask(v));
+    }
+
+    /**
+     * @brief Returns the number of neighbors of u, 0 if u >= n
+     * @note Complexity: O(n / 64), one popcount per word
+     */
+    std::size_t degree(Id u) const {
+        if (u >= n) return 0;
+        const Word* row = rowData(u);
+        std::size_t d = 0;
+        for (std::size_t k = 0; k < stride; k++) d += static_cast<std::size_t>(std::popcount(row[k]));
+        return d;
+    }
+
+    /**
+     * @brief Returns the maximum degree, 0 for an empty graph
+     * @note Complexity: O(n^2 / 64)
+     */
+    std::size_t maxDegree() const {
+        std::size_t best = 0;
+        for (Id u = 0; u < n; u++) best = std::max(best, degree(u));
+        return best;
+    }
+
+    /**
+     * @brief Returns row u of the matrix: bit v of word v / 64 is set if {u, v} is an edge
+     * @param u A vertex < n
+     * @note Bits at positions >= n are always zero
+     */
+    std::span<const Word> row(Id u) const {
+        return {rowData(u), stride};
+    }
+
+    /**
+     * @brief Returns the neighbors of u in increasing order, empty if u >= n
+     * @note Complexity: O(n / 64 + d)
+     */
+    std::vector<Id> neighbors(Id u) const {
+        std::vector<Id> res;
+        if (u >= n) return res;
+        res.reserve(degree(u));
+        forEachBit(rowData(u), stride, [&](Id v) { res.push_back(v); });
+        return res;
+    }
+
+    /**
+     * @brief Calls fn(v) for every neighbor v of u, in increasing order
+     * @note Complexity: O(n / 64 + d)
+     */
+    template<typename Fn>
+    void forEachNeighbor(Id u, Fn&& fn) const {
+        if (u < n) forEachBit(rowData(u), stride, fn);
+    }
+
+    /**
+     * @brief Returns the number of vertices adjacent to both u and v
+     * @note Complexity: O(n / 64), a word-wise AND and popcount of two rows
+     */
+    std::size_t commonNeighbors(Id u, Id v) const {
+        if (u >= n || v >= n) return 0;
+        const Word* a = rowData(u);
+        const Word* b = rowData(v);
+        std::size_t count = 0;
+        for (std::size_t k = 0; k < stride; k++) count += static_cast<std::size_t>(std::popcount(a[k] & b[k]));
+        return count;
+    }
+
+    /**
+     * @brief Counts the triangles of the graph
+     * @return The number of vertex triples u < v < w that are pairwise adjacent
+     * @note For every edge u < v, the rows of u and v are ANDed from the
+     *       word holding v on, with the bits <= v masked off
+     * @note Complexity: O(m * n / 64)
+     */
+    std::uint64_t countTriangles() const {
+        std::uint64_t total = 0;
+        for (Id u = 0; u < n; u++) {
+            const Word* a = rowData(u);
+            // Neighbors v > u: start at the word of u + 1
+            for (std::size_t kv = (u + 1) / wordBits; kv < stride; kv++) {
+                Word higher = a[kv];
+                if (kv == (u + 1) / wordBits) higher &= ~Word{0} << ((u + 1) % wordBits);
+                for (; higher; higher &= higher - 1) {
+                    const Id v = static_cast<Id>(kv * wordBits + static_cast<std::size_t>(std::countr_zero(higher)));
+                    const Word* b = rowData(v);
+                    const std::size_t first = (v + 1) / wordBits;
+                    if (first >= stride) continue;
+                    std::uint64_t count = static_cast<std::uint64_t>(
+                        std::popcount(a[first] & b[first] & (~Word{0} << ((v + 1) % wordBits))));
+                    for (std::size_t k = first + 1; k < stride; k++) {
+                        count += static_cast<std::uint64_t>(std::popcount(a[k] & b[k]));
+                    }
+                    total += count;
+                }
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Computes hop distances from a source with bitset frontiers
+     * @param source The start vertex
+     * @return dist[v] for every vertex, unreachable if v cannot be reached;
+     *         empty if source >= n
+     * @note Each level picks the cheaper direction: top-down ORs the rows of
+     *       the frontier, bottom-up tests each unvisited row against the
+     *       frontier and stops at the first hit
+     * @note Here i used Beamer, Asanović & Patterson, "Direction-Optimizing
+     *       Breadth-First Search" (https://doi.org/10.1109/SC.2012.50) as a reference
+     * @note Complexity: O(n^2 / 64) per level at worst
+     */
+    std::vector<Id> bfs(Id source) const {
+        std::vector<Id> dist;
+        if (source >= n) return dist;
+        dist.assign(n, unreachable);
+        std::vector<Word> visited(stride, 0), frontier(stride, 0), next(stride, 0);
+        visited[source / wordBits] |= mask(source);
+        frontier[source / wordBits] |= mask(source);
+        dist[source] = 0;
+        std::size_t frontierSize = 1, unvisited = n - 1;
+
+        for (Id depth = 1; frontierSize > 0 && unvisited > 0; depth++) {
+            std::fill(next.begin(), next.end(), 0);
+            if (frontierSize <= unvisited) {
+                forEachBit(frontier.data(), stride, [&](Id f) {
+                    const Word* r = rowData(f);
+                    for (std::size_t k = 0; k < stride; k++) next[k] |= r[k];
+                });
+                for (std::size_t k = 0; k < stride; k++) next[k] &= ~visited[k];
+            } else {
+                for (std::size_t kv = 0; kv < stride; kv++) {
+                    Word candidates = ~visited[kv];
+                    if (kv == n / wordBits) candidates &= mask(static_cast<Id>(n)) - 1;
+                    if (kv > n / wordBits) candidates = 0;
+                    for (; candidates; candidates &= candidates - 1) {
+                        const auto v = static_cast<Id>(kv * wordBits + static_cast<std::size_t>(std::countr_zero(candidates)));
+                        const Word* r = rowData(v);
+                        for (std::size_t k = 0; k < stride; k++) {
+                            if (r[k] & frontier[k]) {
+                                next[kv] |= mask(v);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            frontierSize = 0;
+            forEachBit(next.data(), stride, [&](Id v) {
+                dist[v] = depth;
+                frontierSize++;
+            });
+            for (std::size_t k = 0; k < stride; k++) visited[k] |= next[k];
+            unvisited -= frontierSize;
+            frontier.swap(next);
+        }
+        return dist;
+    }
+
+    /**
+     * @brief Returns the hop distance between two vertices
+     * @return The distance, or std::nullopt if no path exists or a vertex is >= n
+     * @note Complexity: that of bfs(u)
+     */
+    std::optional<int> distance(Id u, Id v) const {
+        if (u >= n || v >= n) return std::nullopt;
+        const Id d = bfs(u)[v];
+        if (d == unreachable) return std::nullopt;
+        return static_cast<int>(d);
+    }
+};
+
+#endif
@@ -0,0 +1,278 @@
+/**
+ * @file graphlib/coloring.hpp
+ * @brief Vertex coloring and maximal independent sets on a CSRGraph
+ *
+ * Every function works on dense ids: colors and set membership are flat
+ * arrays indexed by CSRGraph::Id, and the parallel versions proceed in
+ * rounds separated by barriers, so each round only writes the entries of
+ * the vertices it decides and never races with a neighbor.
+ */
+
+#ifndef GRAPHLIB_COLORING_HPP
+#define GRAPHLIB_COLORING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "csr.hpp"
+#include "parallel.hpp"
+
+/// Color of a vertex, in [0, number of colors)
+using Color = std::uint32_t;
+
+/// Vertex orderings for greedyColoring()
+enum class ColoringOrder {
+    Natural,       ///< Ids 0..n-1
+    LargestFirst,  ///< Decreasing degree (Welsh-Powell)
+    SmallestLast   ///< Degeneracy order: at most degeneracy + 1 colors
+};
+
+namespace graphlib::detail {
+
+// Random priority of a vertex, identical for every thread count; ties are
+// broken by id so that neighbors never compare equal
+inline bool beats(std::uint64_t seed, std::uint32_t v, std::uint32_t w) {
+    const std::uint64_t pv = hashMix(seed + 0x9e3779b97f4a7c15ULL * (v + 1ULL));
+    const std::uint64_t pw = hashMix(seed + 0x9e3779b97f4a7c15ULL * (w + 1ULL));
+    return pv != pw ? pv > pw : v > w;
+}
+
+// Smallest color not used by the already colored neighbors of v; `mark` is
+// scratch space of at least degree(v) + 1 entries, all different from `stamp`
+template<typename Vertex, typename Hash>
+Color firstFreeColor(const CSRGraph<Vertex, Hash>& g, std::uint32_t v, std::span<const Color> colors,
+                     std::vector<std::uint32_t>& mark, std::uint32_t stamp) {
+    constexpr Color none = static_cast<Color>(-1);
+    const std::size_t limit = g.degree(v);
+    for (auto w : g.neighbors(v)) {
+        // Colors above the degree can never be the smallest free one
+        if (colors[w] != none && colors[w] <= limit) mark[colors[w]] = stamp;
+    }
+    Color c = 0;
+    while (mark[c] == stamp) c++;
+    return c;
+}
+
+} // namespace graphlib::detail
+
+/**
+ * @brief Returns the vertices of a graph in a coloring order
+ * @param g The graph
+ * @param kind The ordering
+ * @return A permutation of 0..n-1
+ * @note SmallestLast repeatedly removes a vertex of minimum remaining degree
+ *       and returns them in reverse removal order
+ * @note Here i used Matula & Beck, "Smallest-last ordering and clustering and
+ *       graph coloring algorithms" (https://doi.org/10.1145/2402.322385) as a reference
+ * @note Complexity: O(n + m) with bucket queues
+ */
+template<typename Vertex, typename Hash>
+std::vector<typename CSRGraph<Vertex, Hash>::Id> coloringOrder(const CSRGraph<Vertex, Hash>& g, ColoringOrder kind) {
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+    const std::size_t n = g.countVertices();
+    std::vector<Id> order(n);
+    for (Id v = 0; v < n; v++) order[v] = v;
+    if (kind == ColoringOrder::Natural || n == 0) return order;
+
+    const std::size_t maxDeg = g.maxDegree();
+    if (kind == ColoringOrder::LargestFirst) {
+        // Counting sort by decreasing degree, ids increasing within a degree
+        std::vector<std::size_t> start(maxDeg + 2, 0);
+        for (Id v = 0; v < n; v++) start[maxDeg - g.degree(v) + 1]++;
+        for (std::size_t d = 0; d <= maxDeg; d++) start[d + 1] += start[d];
+        for (Id v = 0; v < n; v++) order[start[maxDeg - g.degree(v)]++] = v;
+        return order;
+    }
+
+    // Bucket queue on remaining degree: vertices sorted by degree, with
+    // bucketStart[d] the first position of degree d; moving a vertex down one
+    // degree swaps it with the first vertex of its bucket
+    std::vector<std::size_t> degree(n), bucketStart(maxDeg + 2, 0), position(n);
+    for (Id v = 0; v < n; v++) {
+        degree[v] = g.degree(v);
+        bucketStart[degree[v] + 1]++;
+    }
+    for (std::size_t d = 0; d <= maxDeg; d++) bucketStart[d + 1] += bucketStart[d];
+    std::vector<std::size_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    std::vector<Id> sorted(n);
+    for (Id v = 0; v < n; v++) {
+        position[v] = fill[degree[v]]++;
+        sorted[position[v]] = v;
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+        const Id v = sorted[i]; // Minimum remaining degree
+        order[n - 1 - i] = v;
+        for (Id w : g.neighbors(v)) {
+            if (position[w] <= i) continue; // Already removed
+            const std::size_t d = degree[w];
+            const std::size_t first = std::max(bucketStart[d], i + 1);
+            const Id u = sorted[first];
+            std::swap(sorted[first], sorted[position[w]]);
+            std::swap(position[u], position[w]);
+            bucketStart[d] = first + 1;
+            degree[w]--;
+        }
+    }
+    return order;
+}
+
+/**
+ * @brief Colors the vertices greedily, in a given order
+ * @param g The graph
+ * @param order A permutation of the ids, e.g. from coloringOrder()
+ * @return colors[v] for every id v; adjacent vertices get different colors
+ * @note Each vertex takes the smallest color unused by its earlier neighbors,
+ *       so at most maxDegree() + 1 colors are used
+ * @note Complexity: O(n + m)
+ */
+template<typename Vertex, typename Hash>
+std::vector<Color> greedyColoring(const CSRGraph<Vertex, Hash>& g, std::span<const typename CSRGraph<Vertex, Hash>::Id> order) {
+    std::vector<Color> colors(g.countVertices(), static_cast<Color>(-1));
+    std::vector<std::uint32_t> mark(g.maxDegree() + 1, 0);
+    std::uint32_t stamp = 0;
+    for (auto v : order) colors[v] = graphlib::detail::firstFreeColor(g, v, colors, mark, ++stamp);
+    return colors;
+}
+
+/**
+ * @brief Colors the vertices greedily, in one of the predefined orders
+ * @see greedyColoring(g, order)
+ */
+template<typename Vertex, typename Hash>
+std::vector<Color> greedyColoring(const CSRGraph<Vertex, Hash>& g, ColoringOrder kind = ColoringOrder::SmallestLast) {
+    const auto order = coloringOrder(g, kind);
+    return greedyColoring(g, std::span<const typename CSRGraph<Vertex, Hash>::Id>(order));
+}
+
+/**
+ * @brief Colors the vertices in parallel (Jones-Plassmann)
+ * @param g The graph
+ * @param seed Seed of the random tie-breaking between vertices of equal degree
+ * @param threads Number of threads (0 for all hardware threads)
+ * @return colors[v] for every id v; adjacent vertices get different colors
+ * @note A vertex is colored, with the smallest free color, once all its
+ *       neighbors of higher priority are colored. Vertices colored in the
+ *       same round are never adjacent, so rounds have no conflicts.
+ * @note Priorities favor high degrees (largest-degree-first), which uses
+ *       about as few colors as the sequential largest-first order
+ * @note The result only depends on the seed, not on the thread count
+ * @note Here i used Jones & Plassmann, "A Parallel Graph Coloring Heuristic"
+ *       (https://doi.org/10.1137/0914041) as a reference
+ * @note Complexity: O(n + m) work in total; each vertex keeps a count of
+ *       its uncolored higher-priority neighbors instead of rescanning them
+ */
+template<typename Vertex, typename Hash>
+std::vector<Color> parallelColoring(const CSRGraph<Vertex, Hash>& g, std::uint64_t seed = 0, std::size_t threads = 0) {
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+    if (threads == 0) threads = graphlib::hardwareThreads();
+    const std::size_t n = g.countVertices();
+
+    // Degree in the high bits, a random tie-breaker below, the id last
+    std::vector<std::uint64_t> priority(n);
+    graphlib::parallelFor(n, threads, [&](std::size_t v, std::size_t) {
+        const std::uint64_t degree = std::min<std::uint64_t>(g.degree(static_cast<Id>(v)), (1 << 20) - 1);
+        priority[v] = (degree << 44) | (graphlib::hashMix(seed + 0x9e3779b97f4a7c15ULL * (v + 1)) >> 20);
+    }, 1024);
+    auto beats = [&](Id w, Id v) { return priority[w] != priority[v] ? priority[w] > priority[v] : w > v; };
+
+    // waiting[v]: neighbors of v that must be colored before v
+    std::vector<std::atomic<std::uint32_t>> waiting(n);
+    std::vector<std::vector<Id>> ready(threads);
+    graphlib::parallelFor(n, threads, [&](std::size_t i, std::size_t worker) {
+        const Id v = static_cast<Id>(i);
+        std::uint32_t count = 0;
+        for (Id w : g.neighbors(v)) count += beats(w, v);
+        waiting[v].store(count, std::memory_order_relaxed);
+        if (count == 0) ready[worker].push_back(v);
+    }, 1024);
+
+    std::vector<Color> colors(n, static_cast<Color>(-1));
+    std::vector<std::vector<std::uint32_t>> mark(threads, std::vector<std::uint32_t>(g.maxDegree() + 1, 0));
+    std::vector<std::uint32_t> stamp(threads, 0);
+    std::vector<Id> frontier;
+    for (;;) {
+        frontier.clear();
+        for (auto& local : ready) {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+            local.clear();
+        }
+        if (frontier.empty()) break;
+
+        // Colors read here belong to earlier rounds: the neighbors colored in
+        // this round have a lower priority and are not in the frontier yet
+        graphlib::parallelFor(frontier.size(), threads, [&](std::size_t i, std::size_t worker) {
+            const Id v = frontier[i];
+            colors[v] = graphlib::detail::firstFreeColor(g, v, colors, mark[worker], ++stamp[worker]);
+            for (Id w : g.neighbors(v)) {
+                if (beats(v, w) && waiting[w].fetch_sub(1, std::memory_order_relaxed) == 1) ready[worker].push_back(w);
+            }
+        }, 64);
+    }
+    return colors;
+}
+
+/**
+ * @brief Computes a maximal independent set in parallel (Luby)
+ * @param g The graph
+ * @param seed Seed of the random vertex priorities
+ * @param threads Number of threads (0 for all hardware threads)
+ * @return The ids of the set, in increasing order: no two are adjacent and
+ *         every other vertex has a neighbor in the set
+ * @note Each round adds every remaining vertex whose priority beats all its
+ *       remaining neighbors, then removes the neighbors of the added ones
+ * @note The result only depends on the seed, not on the thread count
+ * @note Here i used Luby, "A Simple Parallel Algorithm for the Maximal
+ *       Independent Set Problem" (https://doi.org/10.1137/0215074) as a reference
+ * @note Complexity: O(n + m) work per round, O(log n) expected rounds
+ */
+template<typename Vertex, typename Hash>
+std::vector<typename CSRGraph<Vertex, Hash>::Id> maximalIndependentSet(const CSRGraph<Vertex, Hash>& g, std::uint64_t seed = 0,
+                                                                       std::size_t threads = 0) {
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+    const std::size_t n = g.countVertices();
+
+    // Separate arrays per phase, so a phase never writes what it reads
+    std::vector<std::uint8_t> inSet(n, 0), removed(n, 0);
+    std::vector<Id> active(n);
+    for (Id v = 0; v < n; v++) active[v] = v;
+
+    while (!active.empty()) {
+        // Phase 1: join if no remaining neighbor has a higher priority
+        graphlib::parallelFor(active.size(), threads, [&](std::size_t i, std::size_t) {
+            const Id v = active[i];
+            bool best = true;
+            for (Id w : g.neighbors(v)) {
+                if (!removed[w] && graphlib::detail::beats(seed, w, v)) {
+                    best = false;
+                    break;
+                }
+            }
+            inSet[v] = best;
+        }, 256);
+
+        // Phase 2: the members and their neighbors leave the graph
+        graphlib::parallelFor(active.size(), threads, [&](std::size_t i, std::size_t) {
+            const Id v = active[i];
+            bool covered = inSet[v];
+            for (Id w : g.neighbors(v)) {
+                if (covered) break;
+                covered = inSet[w];
+            }
+            removed[v] = covered;
+        }, 256);
+
+        std::erase_if(active, [&](Id v) { return removed[v] != 0; });
+    }
+
+    std::vector<Id> res;
+    for (Id v = 0; v < n; v++) {
+        if (inSet[v]) res.push_back(v);
+    }
+    return res;
+}
+
+#endif
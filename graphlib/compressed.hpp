@@ -0,0 +1,527 @@
+/**
+ * @file graphlib/compressed.hpp
+ * @brief Read-only graph with gap-encoded, byte-aligned neighbor lists
+ *
+ * A CSRGraph spends 4 bytes per neighbor entry, Graph about 40. Sorted
+ * neighbor lists have small gaps between consecutive ids, so storing the
+ * gaps with as few bytes as they need brings most graphs down to 1-2 bytes
+ * per entry, at the cost of decoding lists while traversing them.
+ */
+
+#ifndef GRAPHLIB_COMPRESSED_HPP
+#define GRAPHLIB_COMPRESSED_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief Immutable compressed graph with dense vertex ids, built from a CSRGraph
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note Ids, and the order of neighbors (ascending ids), are the same as in
+ *       the CSRGraph it was built from
+ * @note Each neighbor list is split into blocks of `blockSize` ids. Inside a
+ *       block, gaps between consecutive ids are stored stream-vbyte style: a
+ *       run of 2-bit length codes (1 to 4 bytes) followed by the gap bytes,
+ *       so a decoder knows every length before touching the data. A skip
+ *       table holds the first id and the byte offset of every block after
+ *       the first one, which lets containsEdge() jump to a single block.
+ * @note Here i used Lemire et al., "Stream VByte: Faster Byte-Oriented Integer
+ *       Compression" (https://doi.org/10.1016/j.ipl.2017.09.011) as a reference
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class CompressedGraph {
+public:
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+
+    /// Returned by id() for vertices that are not in the graph
+    static constexpr Id npos = CSRGraph<Vertex, Hash>::npos;
+
+    /// Number of neighbor ids per block
+    static constexpr std::size_t blockSize = 128;
+
+private:
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+
+    // Encoded list of vertex i, at data[groupOffsets[i / groupSize] + localOffsets[i]]:
+    //   varint degree
+    //   varint zigzag(first neighbor - i)       (if degree > 0)
+    //   (blocks - 1) x {uint32 first id, uint32 byte offset} of the blocks
+    //   after the first one, offsets relative to the first block (skip table)
+    //   per block: ceil(gaps / 4) length-code bytes, then the gaps,
+    //   where gap = id - previous id - 1 and a block of c ids has c - 1 gaps
+    std::vector<std::uint8_t> data;
+    // Offsets cost 4 bytes per vertex instead of 8: a 64-bit base per group
+    // of vertices plus 32-bit offsets inside the group (every group of
+    // vertices must encode to less than 4 GiB)
+    static constexpr std::size_t groupSize = 64;
+    std::vector<std::uint64_t> groupOffsets;
+    std::vector<std::uint32_t> localOffsets;
+    std::vector<Vertex> idToVertex;
+    std::unordered_map<Vertex, Id, Hash> vertexToId;
+    bool identityIds = false;
+    std::size_t edgeCount = 0;
+
+    static void putVarint(std::vector<std::uint8_t>& out, std::uint64_t x) {
+        while (x >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(x | 0x80));
+            x >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(x));
+    }
+
+    static std::uint64_t getVarint(const std::uint8_t*& p) {
+        std::uint64_t x = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const std::uint8_t b = *p++;
+            x |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (b < 0x80) return x;
+        }
+    }
+
+    static std::uint32_t loadId(const std::uint8_t* p) {
+        std::uint32_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+
+    // Reads one gap of `len` bytes: a fixed 4-byte load and a mask, no
+    // variable-length copy (the data array is padded for the last gap)
+    static std::uint32_t loadGap(const std::uint8_t* p, unsigned len) {
+        static constexpr std::uint32_t masks[5] = {0, 0xff, 0xffff, 0xffffff, 0xffffffff};
+        return loadId(p) & masks[len];
+    }
+
+    static constexpr std::size_t skipEntryBytes = 2 * sizeof(std::uint32_t);
+
+    static std::size_t codeBytes(std::size_t gaps) {
+        return (gaps + 3) / 4;
+    }
+
+    // Decoded header of a list
+    struct ListHeader {
+        std::size_t degree = 0;
+        Id first = 0;
+        const std::uint8_t* skips = nullptr;  // Skip table
+        const std::uint8_t* blocks = nullptr; // First block
+    };
+
+    const std::uint8_t* listStart(Id i) const {
+        return data.data() + groupOffsets[i / groupSize] + localOffsets[i];
+    }
+
+    ListHeader header(Id i) const {
+        ListHeader h;
+        const std::uint8_t* p = listStart(i);
+        h.degree = getVarint(p);
+        if (h.degree == 0) return h;
+        const std::uint64_t z = getVarint(p);
+        const std::int64_t delta = static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+        h.first = static_cast<Id>(static_cast<std::int64_t>(i) + delta);
+        h.skips = p;
+        h.blocks = p + (blockCount(h.degree) - 1) * skipEntryBytes;
+        return h;
+    }
+
+    static std::size_t blockCount(std::size_t degree) {
+        return (degree + blockSize - 1) / blockSize;
+    }
+
+    // Calls fn(id) for the c ids of a block starting at `first`, returns the next block
+    template<typename Fn>
+    static const std::uint8_t* decodeBlock(const std::uint8_t* p, Id first, std::size_t c, Fn& fn) {
+        const std::size_t gaps = c - 1;
+        const std::uint8_t* codes = p;
+        const std::uint8_t* in = p + codeBytes(gaps);
+        Id value = first;
+        fn(value);
+        std::size_t k = 0;
+        // Four gaps per length-code byte
+        for (; k + 4 <= gaps; k += 4) {
+            const unsigned code = codes[k >> 2];
+            for (unsigned j = 0; j < 4; j++) {
+                const unsigned len = ((code >> (2 * j)) & 3) + 1;
+                value += loadGap(in, len) + 1;
+                in += len;
+                fn(value);
+            }
+        }
+        for (; k < gaps; k++) {
+            const unsigned len = ((codes[k >> 2] >> (2 * (k & 3))) & 3) + 1;
+            value += loadGap(in, len) + 1;
+            in += len;
+            fn(value);
+        }
+        return in;
+    }
+
+    void encode(const CSRGraph<Vertex, Hash>& csr) {
+        const std::size_t n = csr.countVertices();
+        groupOffsets.resize((n + groupSize - 1) / groupSize);
+        localOffsets.resize(n);
+        std::vector<std::uint8_t> codes;
+        std::vector<std::uint8_t> bytes;
+        std::vector<std::uint8_t> encoded;
+        std::vector<std::uint32_t> blockStarts;
+
+        for (Id i = 0; i < n; i++) {
+            if (i % groupSize == 0) groupOffsets[i / groupSize] = data.size();
+            localOffsets[i] = static_cast<std::uint32_t>(data.size() - groupOffsets[i / groupSize]);
+            auto nbrs = csr.neighbors(i);
+            putVarint(data, nbrs.size());
+            if (nbrs.empty()) continue;
+
+            const std::int64_t delta = static_cast<std::int64_t>(nbrs[0]) - static_cast<std::int64_t>(i);
+            putVarint(data, (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+
+            const std::size_t blocks = blockCount(nbrs.size());
+            encoded.clear();
+            blockStarts.clear();
+            for (std::size_t b = 0; b < blocks; b++) {
+                blockStarts.push_back(static_cast<std::uint32_t>(encoded.size()));
+                const std::size_t begin = b * blockSize;
+                const std::size_t end = std::min(nbrs.size(), begin + blockSize);
+                codes.assign(codeBytes(end - begin - 1), 0);
+                bytes.clear();
+                for (std::size_t k = begin + 1; k < end; k++) {
+                    const std::uint32_t gap = nbrs[k] - nbrs[k - 1] - 1;
+                    const unsigned len = gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+                    const std::size_t g = k - begin - 1;
+                    codes[g >> 2] |= static_cast<std::uint8_t>((len - 1) << (2 * (g & 3)));
+                    for (unsigned j = 0; j < len; j++) bytes.push_back(static_cast<std::uint8_t>(gap >> (8 * j)));
+                }
+                encoded.insert(encoded.end(), codes.begin(), codes.end());
+                encoded.insert(encoded.end(), bytes.begin(), bytes.end());
+            }
+
+            for (std::size_t b = 1; b < blocks; b++) {
+                const std::uint32_t entry[2] = {nbrs[b * blockSize], blockStarts[b]};
+                const auto* raw = reinterpret_cast<const std::uint8_t*>(entry);
+                data.insert(data.end(), raw, raw + skipEntryBytes);
+            }
+            data.insert(data.end(), encoded.begin(), encoded.end());
+        }
+        // Padding lets loadGap read 4 bytes at the last gap
+        data.resize(data.size() + sizeof(std::uint32_t), 0);
+        data.shrink_to_fit();
+        edgeCount = csr.countEdges();
+    }
+
+public:
+    /**
+     * @brief Forward iterator decoding a neighbor list one id at a time
+     */
+    class NeighborIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Id;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Id*;
+        using reference = Id;
+
+    private:
+        const std::uint8_t* skips = nullptr;
+        const std::uint8_t* codes = nullptr;
+        const std::uint8_t* in = nullptr;
+        std::size_t left = 0;     // Ids not returned yet, current one included
+        std::size_t gapIndex = 0; // Index of the next gap in the current block
+        std::size_t blockGaps = 0;
+        Id value = 0;
+
+        void startBlock(const std::uint8_t* p, Id first) {
+            value = first;
+            blockGaps = std::min(left, blockSize) - 1;
+            gapIndex = 0;
+            codes = p;
+            in = p + codeBytes(blockGaps);
+        }
+
+    public:
+        NeighborIterator() = default;
+
+        NeighborIterator(const ListHeader& h) : skips(h.skips), left(h.degree) {
+            if (left) startBlock(h.blocks, h.first);
+        }
+
+        reference operator*() const { return value; }
+
+        NeighborIterator& operator++() {
+            if (--left == 0) return *this;
+            if (gapIndex == blockGaps) {
+                // Blocks are contiguous: the next one starts after the last gap
+                startBlock(in, loadId(skips));
+                skips += skipEntryBytes;
+                return *this;
+            }
+            const unsigned len = ((codes[gapIndex >> 2] >> (2 * (gapIndex & 3))) & 3) + 1;
+            value += loadGap(in, len) + 1;
+            in += len;
+            gapIndex++;
+            return *this;
+        }
+
+        NeighborIterator operator++(int) {
+            NeighborIterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const NeighborIterator& other) const { return left == other.left; }
+        bool operator!=(const NeighborIterator& other) const { return left != other.left; }
+    };
+
+    /**
+     * @brief Range over the neighbor ids of a vertex, in ascending order
+     */
+    class NeighborRange {
+    private:
+        ListHeader h;
+
+    public:
+        explicit NeighborRange(const ListHeader& header) : h(header) {}
+
+        NeighborIterator begin() const { return NeighborIterator(h); }
+        NeighborIterator end() const { return NeighborIterator(); }
+        std::size_t size() const { return h.degree; }
+        bool empty() const { return h.degree == 0; }
+    };
+
+    CompressedGraph() = default;
+
+    /**
+     * @brief Compresses a CSR snapshot
+     * @param csr The source snapshot, can be discarded afterwards
+     * @note Complexity: O(n + m)
+     */
+    explicit CompressedGraph(const CSRGraph<Vertex, Hash>& csr) {
+        const std::size_t n = csr.countVertices();
+        idToVertex.reserve(n);
+        identityIds = std::is_integral_v<Vertex>;
+        for (Id i = 0; i < n; i++) {
+            idToVertex.push_back(csr.vertex(i));
+            if constexpr (std::is_integral_v<Vertex>) {
+                if (csr.vertex(i) != static_cast<Vertex>(i)) identityIds = false;
+            }
+        }
+        if (!identityIds) {
+            vertexToId.reserve(n);
+            for (Id i = 0; i < n; i++) vertexToId.emplace(idToVertex[i], i);
+        }
+        encode(csr);
+    }
+
+    /**
+     * @brief Compresses a Graph
+     * @param g The source graph
+     * @note Ids follow the iteration order of g, like CSRGraph(g)
+     * @note Complexity: O(n + m + sum(d log d))
+     */
+    explicit CompressedGraph(const Graph<Vertex, Hash>& g) : CompressedGraph(CSRGraph<Vertex, Hash>(g)) {}
+
+    /**
+     * @brief Builds a compressed graph on vertices 0..n-1 from an edge list
+     * @param n Number of vertices
+     * @param edges Undirected edges (u, v) with u, v < n
+     * @note Self-loops and duplicate edges are dropped, matching Graph::addEdge
+     * @note Goes through a temporary CSRGraph, which bounds the peak memory
+     * @note Complexity: O(n + m log m)
+     */
+    static CompressedGraph fromEdgeList(std::size_t n, const std::vector<std::pair<Id, Id>>& edges)
+        requires std::is_integral_v<Vertex>
+    {
+        return CompressedGraph(CSRGraph<Vertex, Hash>::fromEdgeList(n, edges));
+    }
+
+    /**
+     * @brief Returns the number of vertices
+     * @note Complexity: O(1)
+     */
+    std::size_t countVertices() const {
+        return idToVertex.size();
+    }
+
+    /**
+     * @brief Returns the number of undirected edges
+     * @note Complexity: O(1)
+     */
+    std::size_t countEdges() const {
+        return edgeCount;
+    }
+
+    /**
+     * @brief Returns the dense id of a vertex
+     * @param v The vertex to look up
+     * @return Its id, or npos if v is not in the graph
+     * @note Complexity: O(1) amortized
+     */
+    Id id(const VertexParam v) const {
+        if constexpr (std::is_integral_v<Vertex>) {
+            if (identityIds) {
+                return (v >= 0 && static_cast<std::size_t>(v) < idToVertex.size()) ? static_cast<Id>(v) : npos;
+            }
+        }
+        auto it = vertexToId.find(v);
+        return (it != vertexToId.end()) ? it->second : npos;
+    }
+
+    /**
+     * @brief Returns the vertex with a given dense id
+     * @param i A valid id (< countVertices())
+     * @note Complexity: O(1)
+     */
+    const Vertex& vertex(Id i) const {
+        return idToVertex[i];
+    }
+
+    /**
+     * @brief Returns the degree of a vertex
+     * @param i A valid id
+     * @note Complexity: O(1), decodes one varint
+     */
+    std::size_t degree(Id i) const {
+        const std::uint8_t* p = listStart(i);
+        return getVarint(p);
+    }
+
+    /**
+     * @brief Returns the neighbor ids of a vertex, decoded while iterating
+     * @param i A valid id
+     * @note Ids come in ascending order; the range is forward-only
+     * @note Complexity: O(1), then O(1) per step
+     */
+    NeighborRange neighbors(Id i) const {
+        return NeighborRange(header(i));
+    }
+
+    /**
+     * @brief Calls fn(id) for every neighbor of a vertex, in ascending order
+     * @param i A valid id
+     * @param fn Callable invoked as fn(Id)
+     * @note Decodes whole blocks in a tight loop; faster than neighbors() for full scans
+     * @note Complexity: O(d)
+     */
+    template<typename Fn>
+    void forEachNeighbor(Id i, Fn&& fn) const {
+        const ListHeader h = header(i);
+        if (h.degree == 0) return;
+        const std::uint8_t* p = h.blocks;
+        const std::size_t blocks = blockCount(h.degree);
+        for (std::size_t b = 0; b < blocks; b++) {
+            const Id first = b == 0 ? h.first : loadId(h.skips + (b - 1) * skipEntryBytes);
+            p = decodeBlock(p, first, std::min(blockSize, h.degree - b * blockSize), fn);
+        }
+    }
+
+    /**
+     * @brief Checks if an edge exists between two ids
+     * @note Complexity: O(log(d / B) + B) where B is blockSize: binary search
+     *       in the skip table, then a scan of one block
+     */
+    bool containsEdge(Id u, Id v) const {
+        const ListHeader h = header(u);
+        if (h.degree == 0 || v < h.first) return false;
+
+        // Last block whose first id is <= v
+        const std::size_t blocks = blockCount(h.degree);
+        std::size_t lo = 0, hi = blocks - 1;
+        while (lo < hi) {
+            const std::size_t mid = (lo + hi + 1) / 2;
+            if (loadId(h.skips + (mid - 1) * skipEntryBytes) <= v) lo = mid;
+            else hi = mid - 1;
+        }
+
+        const std::uint8_t* p = h.blocks;
+        Id value = h.first;
+        if (lo > 0) {
+            const std::uint8_t* entry = h.skips + (lo - 1) * skipEntryBytes;
+            value = loadId(entry);
+            p += loadId(entry + sizeof(std::uint32_t));
+        }
+        const std::size_t gaps = std::min(blockSize, h.degree - lo * blockSize) - 1;
+        const std::uint8_t* in = p + codeBytes(gaps);
+        for (std::size_t k = 0; value < v && k < gaps; k++) {
+            const unsigned len = ((p[k >> 2] >> (2 * (k & 3))) & 3) + 1;
+            value += loadGap(in, len) + 1;
+            in += len;
+        }
+        return value == v;
+    }
+
+    /**
+     * @brief Performs a BFS over ids
+     * @param source A valid id
+     * @param maxv Maximum number of vertices to visit (0 for unlimited)
+     * @return Visited ids in BFS order
+     * @note Complexity: O(V + E) where V is visited vertices and E visited edges
+     */
+    std::vector<Id> bfsById(Id source, std::size_t maxv = 0) const {
+        std::vector<Id> order;
+        std::vector<bool> seen(countVertices(), false);
+        order.push_back(source);
+        seen[source] = true;
+        const std::size_t limit = maxv ? maxv : countVertices();
+        for (std::size_t head = 0; head < order.size() && order.size() < limit; head++) {
+            forEachNeighbor(order[head], [&](Id w) {
+                if (!seen[w] && order.size() < limit) {
+                    seen[w] = true;
+                    order.push_back(w);
+                }
+            });
+        }
+        return order;
+    }
+
+    /**
+     * @brief Performs a Breadth-First Search (BFS) starting from a vertex
+     * @param v The starting vertex
+     * @param maxv Maximum number of vertices to visit (0 for unlimited)
+     * @return A vector of visited vertices in BFS order, empty if v is missing
+     * @note Same contract as Graph::bfs; neighbors are visited by ascending id
+     * @note Complexity: O(V + E)
+     */
+    std::vector<Vertex> bfs(const VertexParam v, std::size_t maxv = 0) const {
+        std::vector<Vertex> res;
+        const Id source = id(v);
+        if (source == npos) return res;
+        for (Id i : bfsById(source, maxv)) res.push_back(idToVertex[i]);
+        return res;
+    }
+
+    /**
+     * @brief Returns the bytes used by the encoded neighbor lists and their offsets
+     */
+    std::size_t adjacencyBytes() const {
+        return data.capacity()
+             + groupOffsets.capacity() * sizeof(std::uint64_t)
+             + localOffsets.capacity() * sizeof(std::uint32_t);
+    }
+
+    /**
+     * @brief Returns the average adjacency bytes per undirected edge
+     */
+    double bytesPerEdge() const {
+        return edgeCount ? static_cast<double>(adjacencyBytes()) / edgeCount : 0.0;
+    }
+
+    /**
+     * @brief Returns an estimate of the heap memory held by the graph
+     * @return Adjacency bytes plus the id arrays (the vertex-to-id hash
+     *         table is approximated)
+     */
+    std::size_t memoryBytes() const {
+        return adjacencyBytes()
+             + idToVertex.capacity() * sizeof(Vertex)
+             + vertexToId.bucket_count() * sizeof(void*)
+             + vertexToId.size() * (sizeof(void*) + sizeof(std::pair<const Vertex, Id>));
+    }
+};
+
+#endif
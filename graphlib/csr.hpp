@@ -0,0 +1,327 @@
+/**
+ * @file graphlib/csr.hpp
+ * @brief Read-only compressed sparse row (CSR) snapshot of a Graph
+ *
+ * Vertices are renumbered to dense ids 0..n-1 and every adjacency list is
+ * stored as a sorted, contiguous slice of a single array. Unlike the
+ * unordered_set adjacency of Graph, neighbors can be accessed by position,
+ * which is what sampling and random-walk style algorithms need.
+ */
+
+#ifndef GRAPHLIB_CSR_HPP
+#define GRAPHLIB_CSR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../graphlib.hpp"
+
+/**
+ * @brief Immutable CSR view of an undirected graph with dense vertex ids
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note The snapshot does not follow later modifications of the source Graph
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class CSRGraph {
+public:
+    /// Dense vertex id, in [0, countVertices())
+    using Id = std::uint32_t;
+
+    /// Returned by id() for vertices that are not in the graph
+    static constexpr Id npos = std::numeric_limits<Id>::max();
+
+private:
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+
+    std::vector<Vertex> idToVertex;
+    std::unordered_map<Vertex, Id, Hash> vertexToId;
+    std::vector<std::size_t> offsets{0}; // offsets[i]..offsets[i+1] is the slice of vertex i
+    std::vector<Id> targets;
+    bool identityIds = false; // id(v) == v, vertexToId is left empty
+
+    void sortNeighborLists() {
+        for (std::size_t i = 0; i + 1 < offsets.size(); i++) {
+            std::sort(targets.begin() + offsets[i], targets.begin() + offsets[i + 1]);
+        }
+    }
+
+public:
+    CSRGraph() = default;
+
+    /**
+     * @brief Builds the snapshot from a Graph
+     * @param g The source graph
+     * @note Ids follow the iteration order of g
+     * @note Complexity: O(n + m + sum(d log d)) for sorting the neighbor lists
+     */
+    explicit CSRGraph(const Graph<Vertex, Hash>& g) {
+        const std::size_t n = g.countVertices();
+        idToVertex.reserve(n);
+        vertexToId.reserve(n);
+        for (const Vertex& v : g) {
+            vertexToId.emplace(v, static_cast<Id>(idToVertex.size()));
+            idToVertex.push_back(v);
+        }
+
+        offsets.resize(n + 1);
+        for (Id i = 0; i < n; i++) {
+            offsets[i + 1] = offsets[i] + g.degree(idToVertex[i]);
+        }
+
+        targets.resize(offsets[n]);
+        for (Id i = 0; i < n; i++) {
+            std::size_t pos = offsets[i];
+            for (const Vertex& w : g.neighbors(idToVertex[i])) {
+                targets[pos++] = vertexToId.find(w)->second;
+            }
+        }
+        sortNeighborLists();
+    }
+
+    /**
+     * @brief Builds a graph on vertices 0..n-1 directly from an edge list
+     * @param n Number of vertices
+     * @param edges Undirected edges (u, v) with u, v < n
+     * @return The CSR graph, with id(v) == v for every vertex
+     * @note Self-loops and duplicate edges are dropped, matching Graph::addEdge
+     * @note Lets benchmarks and pipelines build graphs far larger than the
+     *       hash-based Graph could hold in memory
+     * @note Complexity: O(n + m log m)
+     */
+    static CSRGraph fromEdgeList(std::size_t n, const std::vector<std::pair<Id, Id>>& edges)
+        requires std::is_integral_v<Vertex>
+    {
+        CSRGraph res;
+        res.identityIds = true; // Optimization: no hash table needed to map ids
+        res.idToVertex.resize(n);
+        for (Id i = 0; i < n; i++) res.idToVertex[i] = static_cast<Vertex>(i);
+
+        std::vector<std::size_t> counts(n + 1, 0);
+        for (const auto& [u, v] : edges) {
+            if (u == v) continue;
+            counts[u + 1]++;
+            counts[v + 1]++;
+        }
+        for (std::size_t i = 0; i < n; i++) counts[i + 1] += counts[i];
+
+        res.targets.resize(counts[n]);
+        std::vector<std::size_t> fill(counts.begin(), counts.end() - 1);
+        for (const auto& [u, v] : edges) {
+            if (u == v) continue;
+            res.targets[fill[u]++] = v;
+            res.targets[fill[v]++] = u;
+        }
+        res.offsets = std::move(counts);
+        res.sortNeighborLists();
+
+        // Compact away duplicates in place
+        std::size_t write = 0;
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            std::size_t end = res.offsets[i + 1];
+            std::size_t start = write;
+            for (std::size_t p = begin; p < end; p++) {
+                if (write == start || res.targets[write - 1] != res.targets[p]) {
+                    res.targets[write++] = res.targets[p];
+                }
+            }
+            begin = end;
+            res.offsets[i + 1] = write;
+        }
+        res.targets.resize(write);
+        res.targets.shrink_to_fit();
+        return res;
+    }
+
+    /**
+     * @brief Returns the number of vertices
+     * @note Complexity: O(1)
+     */
+    std::size_t countVertices() const {
+        return idToVertex.size();
+    }
+
+    /**
+     * @brief Returns the number of undirected edges
+     * @note Complexity: O(1)
+     */
+    std::size_t countEdges() const {
+        return targets.size() / 2;
+    }
+
+    /**
+     * @brief Returns the dense id of a vertex
+     * @param v The vertex to look up
+     * @return Its id, or npos if v is not in the graph
+     * @note Complexity: O(1) amortized
+     */
+    Id id(const VertexParam v) const {
+        if constexpr (std::is_integral_v<Vertex>) {
+            if (identityIds) {
+                return (v >= 0 && static_cast<std::size_t>(v) < idToVertex.size()) ? static_cast<Id>(v) : npos;
+            }
+        }
+        auto it = vertexToId.find(v);
+        return (it != vertexToId.end()) ? it->second : npos;
+    }
+
+    /**
+     * @brief Returns the vertex with a given dense id
+     * @param i A valid id (< countVertices())
+     * @note Complexity: O(1)
+     */
+    const Vertex& vertex(Id i) const {
+        return idToVertex[i];
+    }
+
+    /**
+     * @brief Returns the degree of a vertex
+     * @param i A valid id
+     * @note Complexity: O(1)
+     */
+    std::size_t degree(Id i) const {
+        return offsets[i + 1] - offsets[i];
+    }
+
+    /**
+     * @brief Returns the sorted neighbor ids of a vertex
+     * @param i A valid id
+     * @note The span supports random access: neighbors(i)[k] is O(1)
+     * @note Complexity: O(1)
+     */
+    std::span<const Id> neighbors(Id i) const {
+        return {targets.data() + offsets[i], targets.data() + offsets[i + 1]};
+    }
+
+    /**
+     * @brief Returns the position of vertex i's first neighbor in the global
+     *        neighbor array; slot offset(i) + k holds neighbors(i)[k]
+     * @param i A valid id, or countVertices() for the total number of slots
+     * @note Complexity: O(1)
+     */
+    std::size_t offset(Id i) const {
+        return offsets[i];
+    }
+
+    /**
+     * @brief Returns the neighbor stored in a slot
+     * @param slot A slot in [0, 2 * countEdges())
+     * @note Complexity: O(1)
+     */
+    Id target(std::size_t slot) const {
+        return targets[slot];
+    }
+
+    /**
+     * @brief Hints the CPU to fetch the offsets of a vertex into cache
+     * @param i A valid id
+     * @note Lets algorithms that advance many independent cursors (walkers,
+     *       samplers) overlap the cache misses of their next step
+     */
+    void prefetch(Id i) const {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(offsets.data() + i);
+#else
+        (void)i;
+#endif
+    }
+
+    /**
+     * @brief Checks if an edge exists between two ids
+     * @note Complexity: O(log d) binary search in the sorted list of u
+     */
+    bool containsEdge(Id u, Id v) const {
+        auto nbrs = neighbors(u);
+        return std::binary_search(nbrs.begin(), nbrs.end(), v);
+    }
+
+    /**
+     * @brief Returns the maximum degree in the graph
+     * @note Complexity: O(n)
+     */
+    std::size_t maxDegree() const {
+        std::size_t max_d = 0;
+        for (std::size_t i = 0; i + 1 < offsets.size(); i++) {
+            max_d = std::max(max_d, offsets[i + 1] - offsets[i]);
+        }
+        return max_d;
+    }
+
+    /**
+     * @brief Calls fn on every vertex id, in parallel
+     * @param policy Thread count and chunking, e.g. {.threads = 8}
+     * @param fn Callable invoked as fn(Id v) or fn(Id v, size_t worker)
+     * @note Ids are split into threads * tasksPerThread ranges of equal
+     *       weight, a vertex weighing 1 + its degree, so that per-vertex work
+     *       proportional to the degree is balanced before any stealing
+     * @note Complexity: O(n) work
+     */
+    template<typename Fn>
+    void forEachVertex(const graphlib::ParallelPolicy& policy, Fn&& fn) const {
+        const std::size_t threads = policy.threads ? policy.threads : graphlib::hardwareThreads();
+        const std::size_t n = countVertices();
+        const std::size_t tasks = std::min(n, std::max<std::size_t>(1, threads * policy.tasksPerThread));
+        const std::size_t total = n + offsets[n];
+        // Weight before vertex v: v + offsets[v], nondecreasing in v
+        auto boundary = [&](std::size_t t) -> Id {
+            const std::size_t target = total * t / tasks;
+            std::size_t lo = 0, hi = n;
+            while (lo < hi) {
+                const std::size_t mid = (lo + hi) / 2;
+                if (mid + offsets[mid] < target) lo = mid + 1; else hi = mid;
+            }
+            return static_cast<Id>(lo);
+        };
+        graphlib::parallelTasks(tasks, threads, [&](std::size_t t, std::size_t worker) {
+            const Id last = boundary(t + 1);
+            for (Id v = boundary(t); v < last; v++) graphlib::detail::invokeWithWorker(fn, worker, v);
+        });
+    }
+
+    /**
+     * @brief Calls fn once per edge, in parallel
+     * @param policy Thread count and chunking, e.g. {.threads = 8}
+     * @param fn Callable invoked as fn(Id u, Id v) with u < v, or with an
+     *        extra size_t worker argument
+     * @note The neighbor array is split into threads * tasksPerThread slot
+     *       ranges of equal length, so a hub's list is shared by several tasks
+     * @note Complexity: O(m) work
+     */
+    template<typename Fn>
+    void forEachEdge(const graphlib::ParallelPolicy& policy, Fn&& fn) const {
+        const std::size_t threads = policy.threads ? policy.threads : graphlib::hardwareThreads();
+        const std::size_t slots = targets.size();
+        const std::size_t tasks = std::min(slots, std::max<std::size_t>(1, threads * policy.tasksPerThread));
+        graphlib::parallelTasks(tasks, threads, [&](std::size_t t, std::size_t worker) {
+            const std::size_t first = slots * t / tasks, last = slots * (t + 1) / tasks;
+            // Owner of the first slot: the last vertex whose list starts at or before it
+            Id u = static_cast<Id>(std::upper_bound(offsets.begin(), offsets.end(), first) - offsets.begin() - 1);
+            for (std::size_t s = first; s < last; s++) {
+                while (offsets[u + 1] <= s) u++;
+                if (u < targets[s]) graphlib::detail::invokeWithWorker(fn, worker, u, targets[s]);
+            }
+        });
+    }
+
+    /**
+     * @brief Returns an estimate of the heap memory held by the snapshot
+     * @return Bytes used by the offset, neighbor and id arrays (the
+     *         vertex-to-id hash table is approximated)
+     */
+    std::size_t memoryBytes() const {
+        return offsets.capacity() * sizeof(std::size_t)
+             + targets.capacity() * sizeof(Id)
+             + idToVertex.capacity() * sizeof(Vertex)
+             + vertexToId.bucket_count() * sizeof(void*)
+             + vertexToId.size() * (sizeof(void*) + sizeof(std::pair<const Vertex, Id>));
+    }
+};
+
+#endif
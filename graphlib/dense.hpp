@@ -0,0 +1,472 @@
+/**
+ * @file graphlib/dense.hpp
+ * @brief Graph on the integer ids 0..N-1, with array-indexed vertex lookup
+ *
+ * When vertices are known to be small contiguous integers, hashing them into
+ * an unordered_map only costs time: DenseGraph<N> stores the adjacency set of
+ * vertex v at index v of an array and the vertex set as a bitmap, and keeps
+ * the interface of Graph so that code can switch between the two by type.
+ */
+
+#ifndef GRAPHLIB_DENSE_HPP
+#define GRAPHLIB_DENSE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../graphlib.hpp"
+
+/**
+ * @brief Undirected graph whose vertices are the integers 0..N-1
+ * @tparam N Number of possible vertex ids
+ * @tparam Vertex Integer vertex type (default: int)
+ * @note Same interface as Graph<Vertex>, except observers, statistics and
+ *       parallel iteration. neighbors() returns the same std::unordered_set
+ *       type as Graph<Vertex>
+ * @note Ids outside [0, N) are never vertices: the mutators throw
+ *       std::out_of_range for them, and every query on them answers as for
+ *       a missing vertex
+ * @note containsVertex is one bit test, every other per-vertex operation
+ *       one array index; countVertices and countEdges are O(1). The arrays
+ *       take about 64 bytes per possible id, allocated by the constructor
+ */
+template<std::size_t N, typename Vertex = int>
+class DenseGraph {
+    static_assert(std::is_integral_v<Vertex> && !std::is_same_v<Vertex, bool>, "DenseGraph needs integer vertex ids");
+    static_assert(N > 0, "DenseGraph needs at least one id");
+    static_assert(N - 1 <= static_cast<std::make_unsigned_t<Vertex>>(std::numeric_limits<Vertex>::max()),
+                  "Every id in [0, N) must fit in Vertex");
+
+public:
+    /// Adjacency set of one vertex, as returned by neighbors(); the type Graph<Vertex> uses
+    using NeighborSet = typename Graph<Vertex>::NeighborSet;
+
+    /// Number of possible vertex ids
+    static constexpr std::size_t capacity = N;
+
+private:
+    using VertexParam = Vertex;
+    using Word = std::uint64_t;
+    static constexpr std::size_t wordBits = 64;
+    static constexpr std::size_t words = (N + wordBits - 1) / wordBits;
+
+    std::vector<NeighborSet> adj;
+    std::vector<Word> present; // Bit v is set if v is a vertex
+    std::size_t vertexCount = 0;
+    std::size_t edgeCount = 0;
+    graphlib::detail::VersionCounter mutations; // See version()
+
+    // Negative ids wrap around to large unsigned values and fail the test too
+    static bool inRange(const VertexParam v) {
+        return static_cast<std::make_unsigned_t<Vertex>>(v) < N;
+    }
+
+    static std::size_t index(const VertexParam v) {
+        return static_cast<std::size_t>(static_cast<std::make_unsigned_t<Vertex>>(v));
+    }
+
+    // Mutators reject ids a Graph<Vertex> would have stored, instead of losing them
+    static void checkRange(const VertexParam v) {
+        if (!inRange(v)) {
+            throw std::out_of_range("DenseGraph<" + std::to_string(N) + ">: vertex " + std::to_string(v)
+                                    + " is outside [0, " + std::to_string(N) + ")");
+        }
+    }
+
+    // Hands the contents over to *this and leaves other a valid empty graph.
+    // The fresh arrays are allocated first, so a bad_alloc changes nothing
+    void takeFrom(DenseGraph& other) {
+        std::vector<NeighborSet> emptyAdj(N);
+        std::vector<Word> emptyPresent(words, 0);
+        adj = std::exchange(other.adj, std::move(emptyAdj));
+        present = std::exchange(other.present, std::move(emptyPresent));
+        vertexCount = std::exchange(other.vertexCount, 0);
+        edgeCount = std::exchange(other.edgeCount, 0);
+    }
+
+    bool testBit(std::size_t i) const {
+        return (present[i / wordBits] >> (i % wordBits)) & 1;
+    }
+
+    // Sets bit v, returns true if it was clear
+    bool markVertex(std::size_t i) {
+        Word& w = present[i / wordBits];
+        const Word bit = Word{1} << (i % wordBits);
+        if (w & bit) return false;
+        w |= bit;
+        vertexCount++;
+        mutations++;
+        return true;
+    }
+
+    // Returns the first vertex id >= i, or N
+    std::size_t nextVertex(std::size_t i) const {
+        if (i >= N) return N;
+        std::size_t word = i / wordBits;
+        Word w = present[word] & (~Word{0} << (i % wordBits));
+        while (w == 0) {
+            if (++word == present.size()) return N;
+            w = present[word];
+        }
+        return word * wordBits + static_cast<std::size_t>(std::countr_zero(w));
+    }
+
+public:
+    /**
+     * @brief Creates an empty graph
+     * @note Complexity: O(N), allocates the id-indexed arrays
+     */
+    DenseGraph() : adj(N), present(words, 0) {}
+
+    DenseGraph(const DenseGraph&) = default;
+    DenseGraph& operator=(const DenseGraph&) = default;
+
+    /**
+     * @brief Moves a graph, leaving the source empty but usable
+     * @note Complexity: O(N), the source gets new id-indexed arrays
+     */
+    DenseGraph(DenseGraph&& other) : mutations(std::move(other.mutations)) {
+        takeFrom(other);
+    }
+
+    DenseGraph& operator=(DenseGraph&& other) {
+        if (this != &other) {
+            takeFrom(other);
+            mutations = std::move(other.mutations);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds a vertex to the graph
+     * @param v The vertex to add
+     * @throws std::out_of_range if v is outside [0, N)
+     * @note No effect if the vertex already exists
+     * @note Complexity: O(1)
+     */
+    void addVertex(const VertexParam v) {
+        checkRange(v);
+        markVertex(index(v));
+    }
+
+    /**
+     * @brief Adds an undirected edge between two vertices
+     * @param u First vertex of the edge
+     * @param v Second vertex of the edge
+     * @note Vertices are automatically created if they don't exist
+     * @throws std::out_of_range if an endpoint is outside [0, N)
+     * @note No effect if the edge already exists or if u == v
+     * @note Complexity: O(1) amortized
+     */
+    void addEdge(const VertexParam u, const VertexParam v) {
+        checkRange(u);
+        checkRange(v);
+        if (u == v) return;
+        markVertex(index(u));
+        markVertex(index(v));
+        if (adj[index(u)].insert(v).second) {
+            adj[index(v)].insert(u);
+            edgeCount++;
+            mutations++;
+        }
+    }
+
+    /**
+     * @brief Checks if a vertex exists in the graph
+     * @note Complexity: O(1), one bit test
+     */
+    bool containsVertex(const VertexParam v) const {
+        return inRange(v) && testBit(index(v));
+    }
+
+    /**
+     * @brief Checks if an edge exists between two vertices
+     * @note Complexity: O(1) average
+     */
+    bool containsEdge(const VertexParam u, const VertexParam v) const {
+        return inRange(u) && inRange(v) && adj[index(u)].contains(v);
+    }
+
+    /**
+     * @brief Returns the number of neighbors of a vertex, 0 if it does not exist
+     * @note Complexity: O(1)
+     */
+    std::size_t degree(const VertexParam v) const {
+        return inRange(v) ? adj[index(v)].size() : 0;
+    }
+
+    /**
+     * @brief Returns the maximum degree in the graph, 0 if it is empty
+     * @note Complexity: O(N / 64 + n)
+     */
+    std::size_t maxDegree() const {
+        std::size_t best = 0;
+        for (std::size_t i = nextVertex(0); i < N; i = nextVertex(i + 1)) {
+            best = std::max(best, adj[i].size());
+        }
+        return best;
+    }
+
+    /**
+     * @brief Returns the number of vertices
+     * @note Complexity: O(1)
+     */
+    std::size_t countVertices() const {
+        return vertexCount;
+    }
+
+    /**
+     * @brief Returns the number of edges
+     * @note Complexity: O(1), maintained by the mutators
+     */
+    std::size_t countEdges() const {
+        return edgeCount;
+    }
+
+    /**
+     * @brief Removes the edge between two vertices, if it exists
+     * @throws std::out_of_range if an endpoint is outside [0, N)
+     * @note Complexity: O(1) average
+     */
+    void removeEdge(const VertexParam u, const VertexParam v) {
+        checkRange(u);
+        checkRange(v);
+        if (u == v) return;
+        if (adj[index(u)].erase(v)) {
+            adj[index(v)].erase(u);
+            edgeCount--;
+            mutations++;
+        }
+    }
+
+    /**
+     * @brief Removes a vertex and all its incident edges
+     * @throws std::out_of_range if v is outside [0, N)
+     * @note No effect if the vertex does not exist
+     * @note Complexity: O(d) where d is the degree of v
+     */
+    void removeVertex(const VertexParam v) {
+        checkRange(v);
+        if (!testBit(index(v))) return;
+        NeighborSet& set = adj[index(v)];
+        for (const Vertex& w : set) adj[index(w)].erase(v);
+        edgeCount -= set.size();
+        NeighborSet().swap(set); // Release the buckets like Graph, which erases the whole entry
+        present[index(v) / wordBits] &= ~(Word{1} << (index(v) % wordBits));
+        vertexCount--;
+        mutations++;
+    }
+
+    /**
+     * @brief Removes all vertices and edges
+     * @note Complexity: O(N / 64 + n + m)
+     */
+    void clear() {
+        for (std::size_t i = nextVertex(0); i < N; i = nextVertex(i + 1)) NeighborSet().swap(adj[i]);
+        std::fill(present.begin(), present.end(), 0);
+        if (vertexCount != 0) mutations++;
+        vertexCount = 0;
+        edgeCount = 0;
+    }
+
+    /**
+     * @brief Returns a counter bumped by every modification, like Graph::version()
+     * @note Complexity: O(1)
+     */
+    std::uint64_t version() const {
+        return mutations.value;
+    }
+
+    /**
+     * @brief Returns the set of all vertices
+     * @note Complexity: O(N / 64 + n)
+     */
+    std::unordered_set<Vertex> vertices() const {
+        std::unordered_set<Vertex> res;
+        res.reserve(vertexCount);
+        for (std::size_t i = nextVertex(0); i < N; i = nextVertex(i + 1)) res.insert(static_cast<Vertex>(i));
+        return res;
+    }
+
+    /**
+     * @brief Returns the set of all edges, as pairs with u < v
+     * @note Complexity: O(N / 64 + n + m)
+     */
+    std::unordered_set<std::pair<Vertex, Vertex>> edges() const {
+        std::unordered_set<std::pair<Vertex, Vertex>> res;
+        for (std::size_t i = nextVertex(0); i < N; i = nextVertex(i + 1)) {
+            const auto u = static_cast<Vertex>(i);
+            for (const Vertex& v : adj[i]) {
+                if (u < v) res.emplace(u, v);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Returns the set of neighbors of a vertex, empty if it does not exist
+     * @note Complexity: O(1)
+     */
+    const NeighborSet& neighbors(const VertexParam v) const {
+        static const NeighborSet empty;
+        return inRange(v) ? adj[index(v)] : empty;
+    }
+
+    /**
+     * @brief Returns the neighbors of a vertex and the vertex itself, empty if it does not exist
+     * @note Complexity: O(d)
+     */
+    std::unordered_set<Vertex> closedNeighbors(const VertexParam v) const {
+        if (!containsVertex(v)) return {};
+        std::unordered_set<Vertex> res(adj[index(v)].begin(), adj[index(v)].end());
+        res.insert(v);
+        return res;
+    }
+
+    /**
+     * @brief Performs a Breadth-First Search (BFS) starting from a vertex
+     * @param v The starting vertex
+     * @param maxv Maximum number of vertices to visit (0 for unlimited)
+     * @return The visited vertices in BFS order, empty if v does not exist
+     * @note Visited vertices are marked in a bitmap and the result vector
+     *       doubles as the queue, instead of a hash set and a std::queue
+     * @note Complexity: O(N / 64 + V + E) where V is visited vertices and E visited edges
+     */
+    std::vector<Vertex> bfs(const VertexParam v, std::size_t maxv = 0) const {
+        std::vector<Vertex> order;
+        if (!containsVertex(v)) return order;
+        std::vector<Word> seen(present.size(), 0);
+        auto visit = [&](std::size_t i) {
+            Word& w = seen[i / wordBits];
+            const Word bit = Word{1} << (i % wordBits);
+            if (w & bit) return false;
+            w |= bit;
+            return true;
+        };
+        visit(index(v));
+        order.push_back(v);
+        for (std::size_t head = 0; head < order.size(); head++) {
+            if (maxv > 0 && order.size() >= maxv) break;
+            for (const Vertex& next : adj[index(order[head])]) {
+                if (visit(index(next))) order.push_back(next);
+            }
+        }
+        if (maxv > 0 && order.size() > maxv) order.resize(maxv);
+        return order;
+    }
+
+    /**
+     * @brief Calculates the shortest path distance between two vertices
+     * @return The number of edges on a shortest path, or std::nullopt if
+     *         either vertex does not exist or no path connects them
+     * @note Complexity: O(N / 64 + V + E) for the BFS, stopped at the target
+     */
+    std::optional<int> distance(const VertexParam u, const VertexParam v) const {
+        if (!containsVertex(u) || !containsVertex(v)) return std::nullopt;
+        if (u == v) return 0;
+        std::vector<Word> seen(present.size(), 0);
+        seen[index(u) / wordBits] |= Word{1} << (index(u) % wordBits);
+        std::vector<Vertex> level{u}, next;
+        for (int depth = 1; !level.empty(); depth++) {
+            next.clear();
+            for (const Vertex& current : level) {
+                for (const Vertex& w : adj[index(current)]) {
+                    if (w == v) return depth;
+                    Word& word = seen[index(w) / wordBits];
+                    const Word bit = Word{1} << (index(w) % wordBits);
+                    if (!(word & bit)) {
+                        word |= bit;
+                        next.push_back(w);
+                    }
+                }
+            }
+            level.swap(next);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Exports the graph to Graphviz DOT format
+     * @note Complexity: O(N / 64 + n + m)
+     */
+    std::string toDot() const {
+        std::ostringstream oss;
+        oss << "graph G {\n";
+        for (std::size_t i = nextVertex(0); i < N; i = nextVertex(i + 1)) {
+            for (const Vertex& v : adj[i]) {
+                if (static_cast<Vertex>(i) < v) oss << "  \"" << i << "\" -- \"" << v << "\";\n";
+            }
+        }
+        oss << "}\n";
+        return oss.str();
+    }
+
+    /**
+     * @brief Iterator over the vertices, in increasing id order
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Vertex;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Vertex*;
+        using reference = const Vertex&;
+
+    private:
+        const DenseGraph* g = nullptr;
+        std::size_t i = N;
+        Vertex current{};
+
+    public:
+        iterator() = default;
+        iterator(const DenseGraph* graph, std::size_t first)
+            : g(graph), i(first), current(static_cast<Vertex>(first)) {}
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+
+        iterator& operator++() {
+            i = g->nextVertex(i + 1);
+            current = static_cast<Vertex>(i);
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const { return i == other.i; }
+        bool operator!=(const iterator& other) const { return i != other.i; }
+    };
+
+    iterator begin() const { return iterator(this, nextVertex(0)); }
+    iterator end() const { return iterator(this, N); }
+};
+
+namespace graphlib {
+    /**
+     * @brief Selects DenseGraph<N, Vertex> for integer vertices with a known
+     *        id bound N, and Graph<Vertex, Hash> otherwise (N = 0)
+     * @note Lets generic code pick the fast path at compile time, e.g.
+     *       GraphFor<int, 1 << 20> or GraphFor<std::string>
+     */
+    template<typename Vertex, std::size_t N = 0, typename Hash = std::hash<Vertex>>
+    using GraphFor = std::conditional_t<(N > 0 && std::is_integral_v<Vertex> && !std::is_same_v<Vertex, bool>),
+                                        DenseGraph<(N > 0 ? N : 1), std::conditional_t<std::is_integral_v<Vertex>, Vertex, int>>,
+                                        Graph<Vertex, Hash>>;
+}
+
+#endif
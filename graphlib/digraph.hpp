@@ -0,0 +1,401 @@
+/**
+ * @file graphlib/digraph.hpp
+ * @brief Directed graph with out-edges and an optional in-edge index
+ *
+ * Same storage as Graph (one hash map of vertices to unordered_set
+ * adjacency), but each vertex entry holds its out-set and, unless disabled,
+ * its in-set. Both directions are therefore reached with a single lookup,
+ * instead of keeping a forward and a reverse graph side by side.
+ */
+
+#ifndef GRAPHLIB_DIGRAPH_HPP
+#define GRAPHLIB_DIGRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <queue>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../graphlib.hpp"
+
+/**
+ * @brief Class representing a directed graph
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @tparam InEdges Keep the in-edge index (default: true); without it,
+ *         inNeighbors() and inDegree() are unavailable, removeVertex() is
+ *         O(n + m) and every edge is stored once instead of twice
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>, bool InEdges=true>
+class DiGraph {
+private:
+    // Optimization: pass primitive types by value, complex ones by const ref
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+    using AdjSet = std::unordered_set<Vertex, Hash>;
+
+    struct NoInEdges {};
+
+    struct Adjacency {
+        AdjSet out;
+        // Optimization: takes no space when the in-edge index is disabled
+        [[no_unique_address]] std::conditional_t<InEdges, AdjSet, NoInEdges> in;
+    };
+
+    std::unordered_map<Vertex, Adjacency, Hash> adj;
+
+public:
+    DiGraph() = default;
+
+    /**
+     * @brief Adds a vertex to the graph
+     * @param v The vertex to add
+     * @note If the vertex already exists, the operation has no effect
+     * @note Complexity: O(1) amortized
+     */
+    void addVertex(const VertexParam v) {
+        adj.try_emplace(v);
+    }
+
+    /**
+     * @brief Adds a directed edge u -> v
+     * @param u Source vertex
+     * @param v Target vertex
+     * @note Vertices are automatically created if they don't exist
+     * @note If the edge already exists, the operation has no effect
+     * @note Self-loops (u == v) are silently ignored, like Graph::addEdge
+     * @note Complexity: O(1) amortized
+     */
+    void addEdge(const VertexParam u, const VertexParam v) {
+        if (u == v) return;
+        auto& outU = adj.try_emplace(u).first->second.out; // References survive the rehash emplacing v may cause
+        auto& entryV = adj.try_emplace(v).first->second;
+        if (outU.insert(v).second) {
+            if constexpr (InEdges) entryV.in.insert(u);
+        }
+    }
+
+    /**
+     * @brief Checks if a vertex exists in the graph
+     * @param v The vertex to search for
+     * @return true if the vertex exists, false otherwise
+     * @note Complexity: O(1) amortized
+     */
+    bool containsVertex(const VertexParam v) const {
+        return adj.contains(v);
+    }
+
+    /**
+     * @brief Checks if the directed edge u -> v exists
+     * @param u Source vertex
+     * @param v Target vertex
+     * @return true if the edge exists, false otherwise
+     * @note Complexity: O(1) amortized
+     */
+    bool containsEdge(const VertexParam u, const VertexParam v) const {
+        auto it = adj.find(u);
+        return (it != adj.end()) && it->second.out.contains(v);
+    }
+
+    /**
+     * @brief Returns the number of edges leaving a vertex
+     * @param v The vertex to check
+     * @return The out-degree of v, or 0 if v is not in the graph
+     * @note Complexity: O(1) amortized
+     */
+    size_t outDegree(const VertexParam v) const {
+        auto it = adj.find(v);
+        return (it != adj.end()) ? it->second.out.size() : 0;
+    }
+
+    /**
+     * @brief Returns the number of edges entering a vertex
+     * @param v The vertex to check
+     * @return The in-degree of v, or 0 if v is not in the graph
+     * @note Requires the in-edge index
+     * @note Complexity: O(1) amortized
+     */
+    size_t inDegree(const VertexParam v) const requires InEdges {
+        auto it = adj.find(v);
+        return (it != adj.end()) ? it->second.in.size() : 0;
+    }
+
+    /**
+     * @brief Returns the targets of the edges leaving a vertex
+     * @param v The vertex to check
+     * @return The set of out-neighbors, empty if v is not in the graph
+     * @note Complexity: O(1)
+     */
+    const AdjSet& outNeighbors(const VertexParam v) const {
+        static const AdjSet empty;
+        auto it = adj.find(v);
+        return (it != adj.end()) ? it->second.out : empty;
+    }
+
+    /**
+     * @brief Returns the sources of the edges entering a vertex
+     * @param v The vertex to check
+     * @return The set of in-neighbors, empty if v is not in the graph
+     * @note Requires the in-edge index
+     * @note Complexity: O(1)
+     */
+    const AdjSet& inNeighbors(const VertexParam v) const requires InEdges {
+        static const AdjSet empty;
+        auto it = adj.find(v);
+        return (it != adj.end()) ? it->second.in : empty;
+    }
+
+    /**
+     * @brief Returns the number of vertices in the graph
+     * @return The number of vertices
+     * @note Complexity: O(1)
+     */
+    size_t countVertices() const {
+        return adj.size();
+    }
+
+    /**
+     * @brief Returns the number of directed edges in the graph
+     * @return The number of edges
+     * @note Complexity: O(n) where n is the number of vertices
+     */
+    size_t countEdges() const {
+        size_t total = 0;
+        for (const auto& [_, entry] : adj) total += entry.out.size();
+        return total;
+    }
+
+    /**
+     * @brief Removes the directed edge u -> v
+     * @param u Source vertex
+     * @param v Target vertex
+     * @note If the edge does not exist, the operation has no effect
+     * @note Complexity: O(1) amortized
+     */
+    void removeEdge(const VertexParam u, const VertexParam v) {
+        auto itU = adj.find(u);
+        if (itU == adj.end() || !itU->second.out.erase(v)) return;
+        if constexpr (InEdges) adj.find(v)->second.in.erase(u);
+    }
+
+    /**
+     * @brief Removes a vertex from the graph and all edges entering or leaving it
+     * @param v The vertex to remove
+     * @note If the vertex does not exist, the operation has no effect
+     * @note Complexity: O(d_in + d_out) with the in-edge index, O(n) without
+     */
+    void removeVertex(const VertexParam v) {
+        auto it = adj.find(v);
+        if (it == adj.end()) return;
+
+        if constexpr (InEdges) {
+            for (const Vertex& w : it->second.out) adj.find(w)->second.in.erase(v);
+            for (const Vertex& w : it->second.in) adj.find(w)->second.out.erase(v);
+        } else {
+            // Without the index, any vertex may point to v
+            for (auto& [_, entry] : adj) entry.out.erase(v);
+        }
+        adj.erase(it);
+    }
+
+    /**
+     * @brief Removes all vertices and edges from the graph
+     * @note Complexity: O(n + m)
+     */
+    void clear() {
+        adj.clear();
+    }
+
+    /**
+     * @brief Returns the set of all directed edges in the graph
+     * @return An unordered_set of (source, target) pairs
+     * @note Complexity: O(m)
+     */
+    std::unordered_set<std::pair<Vertex, Vertex>> edges() const {
+        std::unordered_set<std::pair<Vertex, Vertex>> res;
+        for (const auto& [u, entry] : adj) {
+            for (const Vertex& v : entry.out) res.emplace(u, v);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Performs a BFS from a vertex, following edges in their direction
+     * @param v The starting vertex
+     * @param maxv Maximum number of vertices to visit (0 for unlimited)
+     * @return A vector of vertices reachable from v, in BFS order
+     * @note Complexity: O(V + E) where V is visited vertices and E visited edges
+     */
+    std::vector<Vertex> bfs(const VertexParam v, size_t maxv = 0) const {
+        std::vector<Vertex> result;
+        auto start = adj.find(v);
+        if (start == adj.end()) return result;
+        if (maxv > 0) result.reserve(maxv);
+
+        // Optimization: queue entries instead of vertices, so expanding a
+        // vertex does not look it up again
+        std::unordered_set<Vertex, Hash> seen;
+        std::queue<const typename decltype(adj)::value_type*> pending;
+        pending.push(&*start);
+        seen.insert(v);
+
+        while (!pending.empty()) {
+            if (maxv > 0 && result.size() >= maxv) break;
+            const auto* current = pending.front();
+            pending.pop();
+            result.emplace_back(current->first);
+            for (const Vertex& next : current->second.out) {
+                if (seen.insert(next).second) pending.push(&*adj.find(next));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calculates the length of the shortest directed path u -> v
+     * @param u Start vertex
+     * @param v End vertex
+     * @return The distance if v is reachable from u, std::nullopt otherwise
+     * @note Complexity: O(V + E) for BFS traversal
+     */
+    std::optional<int> distance(const VertexParam u, const VertexParam v) const {
+        if (!containsVertex(u) || !containsVertex(v)) return std::nullopt;
+        if (u == v) return 0;
+
+        std::unordered_set<Vertex, Hash> seen;
+        std::vector<Vertex> level{u}, next;
+        seen.insert(u);
+        for (int depth = 1; !level.empty(); depth++) {
+            next.clear();
+            for (const Vertex& current : level) {
+                for (const Vertex& w : adj.find(current)->second.out) {
+                    if (w == v) return depth;
+                    if (seen.insert(w).second) next.push_back(w);
+                }
+            }
+            std::swap(level, next);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Computes the strongly connected components
+     * @return The components, each listing its vertices, in reverse
+     *         topological order: no edge leaves a component towards a later one
+     * @note Iterative version of Tarjan's algorithm with an explicit stack,
+     *       so long paths cannot overflow the call stack; it only follows
+     *       out-edges and works without the in-edge index
+     * @note Here i used https://en.wikipedia.org/wiki/Tarjan%27s_strongly_connected_components_algorithm as a reference
+     * @note Complexity: O(n + m)
+     */
+    std::vector<std::vector<Vertex>> stronglyConnectedComponents() const {
+        using Id = std::uint32_t;
+        constexpr Id unvisited = static_cast<Id>(-1);
+        using Entry = typename decltype(adj)::value_type;
+
+        // Dense ids, so the per-vertex state lives in flat arrays
+        std::vector<const Entry*> entries;
+        std::unordered_map<Vertex, Id, Hash> ids;
+        entries.reserve(adj.size());
+        ids.reserve(adj.size());
+        for (const auto& entry : adj) {
+            ids.emplace(entry.first, static_cast<Id>(entries.size()));
+            entries.push_back(&entry);
+        }
+
+        const size_t n = entries.size();
+        std::vector<Id> index(n, unvisited), low(n);
+        std::vector<bool> onStack(n, false);
+        std::vector<Id> stack;
+        Id counter = 0;
+
+        // One frame per vertex on the DFS path, with the next out-edge to follow
+        struct Frame {
+            Id v;
+            typename AdjSet::const_iterator next;
+        };
+        std::vector<Frame> path;
+        std::vector<std::vector<Vertex>> components;
+
+        auto visit = [&](Id v) {
+            index[v] = low[v] = counter++;
+            stack.push_back(v);
+            onStack[v] = true;
+            path.push_back({v, entries[v]->second.out.begin()});
+        };
+
+        for (Id root = 0; root < n; root++) {
+            if (index[root] != unvisited) continue;
+            visit(root);
+            while (!path.empty()) {
+                Frame& top = path.back();
+                const Id v = top.v;
+                if (top.next != entries[v]->second.out.end()) {
+                    const Id w = ids.find(*top.next++)->second;
+                    if (index[w] == unvisited) {
+                        visit(w); // Invalidates top
+                    } else if (onStack[w]) {
+                        low[v] = std::min(low[v], index[w]);
+                    }
+                    continue;
+                }
+
+                path.pop_back();
+                if (!path.empty()) low[path.back().v] = std::min(low[path.back().v], low[v]);
+                if (low[v] != index[v]) continue;
+
+                // v is the root of a component: everything above it on the stack
+                auto& component = components.emplace_back();
+                Id w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    component.push_back(entries[w]->first);
+                } while (w != v);
+            }
+        }
+        return components;
+    }
+
+    /**
+     * @brief Iterator over the vertices of the graph
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Vertex;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Vertex*;
+        using reference = const Vertex&;
+
+    private:
+        typename std::unordered_map<Vertex, Adjacency, Hash>::const_iterator it;
+
+    public:
+        iterator(typename std::unordered_map<Vertex, Adjacency, Hash>::const_iterator i) : it(i) {}
+
+        reference operator*() const { return it->first; }
+        pointer operator->() const { return &(it->first); }
+
+        iterator& operator++() { ++it; return *this; }
+
+        iterator operator++(int) {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const { return it == other.it; }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+    };
+
+    iterator begin() const { return iterator(adj.begin()); }
+    iterator end() const { return iterator(adj.end()); }
+};
+
+#endif
@@ -0,0 +1,343 @@
+/**
+ * @file graphlib/distance_oracle.hpp
+ * @brief Precomputed distance oracles: landmark bounds and pruned landmark labeling
+ *
+ * Graph::distance() runs a full BFS per query. The oracles below move that
+ * work to a one-time build over a CSRGraph and then answer queries by
+ * scanning small per-vertex arrays.
+ */
+
+#ifndef GRAPHLIB_DISTANCE_ORACLE_HPP
+#define GRAPHLIB_DISTANCE_ORACLE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include "csr.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
+
+/**
+ * @brief Lower and upper bounds on a shortest path distance
+ * upper is std::nullopt when no landmark reaches both vertices
+ */
+struct DistanceBounds {
+    int lower = 0;
+    std::optional<int> upper;
+};
+
+/**
+ * @brief Approximate distance oracle based on BFS from a few landmarks
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note By the triangle inequality, for every landmark l:
+ *       |d(u, l) - d(l, v)| <= d(u, v) <= d(u, l) + d(l, v)
+ * @note Distances are stored as 16-bit values, vertex-major, so a query reads
+ *       two contiguous rows of `landmarks` entries. A vertex more than
+ *       tooFar - 1 hops from a landmark is stored as tooFar: that landmark
+ *       gives no bound for it, but still proves it is connected
+ * @note Here i used https://doi.org/10.1145/1645953.1646063 as a reference
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class LandmarkOracle {
+public:
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+    using Distance = std::uint16_t;
+
+    /// Stored for vertices a landmark cannot reach
+    static constexpr Distance unreachable = std::numeric_limits<Distance>::max();
+    /// Stored for vertices a landmark reaches in tooFar hops or more
+    static constexpr Distance tooFar = unreachable - 1;
+
+    /// How landmarks are picked
+    enum class Selection {
+        HighestDegree, ///< The k vertices with the largest degree
+        Random         ///< k distinct vertices picked uniformly
+    };
+
+private:
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+
+    const CSRGraph<Vertex, Hash>& g;
+    std::vector<Id> chosen;
+    std::vector<Distance> dist; // dist[v * chosen.size() + l]
+
+public:
+    /**
+     * @brief Picks landmarks and runs one BFS from each
+     * @param graph The graph, must outlive the oracle
+     * @param landmarks Number of landmarks (capped at the number of vertices)
+     * @param selection Landmark selection strategy
+     * @param seed Seed used by Selection::Random
+     * @param threads Number of threads running the BFS (0 for all hardware threads)
+     * @note Complexity: O(k (n + m)) time, O(k n) memory (twice that during the build)
+     */
+    LandmarkOracle(const CSRGraph<Vertex, Hash>& graph, std::size_t landmarks,
+                   Selection selection = Selection::HighestDegree,
+                   std::uint64_t seed = 0, std::size_t threads = 0) : g(graph) {
+        const std::size_t n = g.countVertices();
+        const std::size_t k = std::min(landmarks, n);
+
+        std::vector<Id> ids(n);
+        std::iota(ids.begin(), ids.end(), Id{0});
+        if (selection == Selection::HighestDegree) {
+            std::partial_sort(ids.begin(), ids.begin() + k, ids.end(), [&](Id a, Id b) {
+                return g.degree(a) > g.degree(b);
+            });
+        } else {
+            graphlib::Xoshiro256 rng(seed);
+            for (std::size_t i = 0; i < k; i++) {
+                std::swap(ids[i], ids[i + graphlib::boundedRandom(rng, n - i)]);
+            }
+        }
+        chosen.assign(ids.begin(), ids.begin() + k);
+
+        // Each BFS fills its own column, so threads never write the same
+        // cache lines; the columns are then transposed into rows
+        std::vector<Distance> columns(n * k, unreachable);
+        graphlib::parallelFor(k, threads, [&](std::size_t l, std::size_t) {
+            Distance* col = columns.data() + l * n;
+            std::vector<Id> queue;
+            queue.reserve(n);
+            queue.push_back(chosen[l]);
+            col[chosen[l]] = 0;
+            for (std::size_t head = 0; head < queue.size(); head++) {
+                const Id cur = queue[head];
+                const Distance next = col[cur] == tooFar ? tooFar : static_cast<Distance>(col[cur] + 1);
+                for (Id w : g.neighbors(cur)) {
+                    if (col[w] == unreachable) {
+                        col[w] = next;
+                        queue.push_back(w);
+                    }
+                }
+            }
+        }, 1);
+
+        dist.resize(n * k);
+        graphlib::parallelFor(n, threads, [&](std::size_t v, std::size_t) {
+            for (std::size_t l = 0; l < k; l++) dist[v * k + l] = columns[l * n + v];
+        }, 4096);
+    }
+
+    /**
+     * @brief Returns the landmark ids
+     */
+    const std::vector<Id>& landmarks() const {
+        return chosen;
+    }
+
+    /**
+     * @brief Bounds the distance between two vertex ids
+     * @return The bounds, or std::nullopt if a landmark proves that u and v
+     *         are in different components
+     * @note Complexity: O(k) where k is the number of landmarks
+     */
+    std::optional<DistanceBounds> approxDistanceById(Id u, Id v) const {
+        if (u == v) return DistanceBounds{0, 0};
+
+        const std::size_t k = chosen.size();
+        const Distance* du = dist.data() + u * k;
+        const Distance* dv = dist.data() + v * k;
+        DistanceBounds res;
+        int upper = std::numeric_limits<int>::max();
+
+        for (std::size_t l = 0; l < k; l++) {
+            const bool ru = du[l] != unreachable;
+            const bool rv = dv[l] != unreachable;
+            if (ru != rv) return std::nullopt;
+            if (!ru || du[l] == tooFar || dv[l] == tooFar) continue;
+            const int a = du[l], b = dv[l];
+            upper = std::min(upper, a + b);
+            res.lower = std::max(res.lower, a > b ? a - b : b - a);
+        }
+        // Distinct vertices are at least one hop apart
+        res.lower = std::max(res.lower, 1);
+        if (upper != std::numeric_limits<int>::max()) res.upper = upper;
+        return res;
+    }
+
+    /**
+     * @brief Bounds the shortest path distance between two vertices
+     * @param u Start vertex
+     * @param v End vertex
+     * @return The bounds, or std::nullopt if a vertex is missing or the
+     *         vertices are provably disconnected
+     * @note Complexity: O(k) where k is the number of landmarks
+     */
+    std::optional<DistanceBounds> approxDistance(const VertexParam u, const VertexParam v) const {
+        const Id iu = g.id(u), iv = g.id(v);
+        if (iu == CSRGraph<Vertex, Hash>::npos || iv == CSRGraph<Vertex, Hash>::npos) return std::nullopt;
+        return approxDistanceById(iu, iv);
+    }
+
+    /**
+     * @brief Returns the heap memory held by the distance table, in bytes
+     */
+    std::size_t memoryBytes() const {
+        return dist.capacity() * sizeof(Distance) + chosen.capacity() * sizeof(Id);
+    }
+};
+
+/**
+ * @brief Exact distance oracle based on pruned landmark labeling (2-hop cover)
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note Every vertex gets a label of (hub rank, distance) pairs such that any
+ *       shortest u-v path passes through a hub common to both labels
+ * @note Hubs are processed by decreasing degree, which keeps labels small on
+ *       social and web graphs (power-law degree distribution)
+ * @note Here i used https://doi.org/10.1145/2463676.2465315 as a reference
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class PrunedLandmarkLabeling {
+public:
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+
+private:
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+    using Distance = std::uint32_t; // As wide as Id: no path is longer than n - 1 hops
+    static constexpr Distance infinity = std::numeric_limits<Distance>::max();
+    static constexpr Id sentinel = std::numeric_limits<Id>::max();
+
+    const CSRGraph<Vertex, Hash>& g;
+
+    // Flattened labels: entries labelOffsets[v]..labelOffsets[v+1] of
+    // hubs/hubDist, sorted by hub rank and terminated by a sentinel hub
+    std::vector<std::size_t> labelOffsets;
+    std::vector<Id> hubs;
+    std::vector<Distance> hubDist;
+
+public:
+    /**
+     * @brief Builds the labeling
+     * @param graph The graph, must outlive the oracle
+     * @note Complexity: O(n * L * (L + d)) in the worst case where L is the
+     *       average label size; near-linear on graphs with a few dominant hubs
+     */
+    explicit PrunedLandmarkLabeling(const CSRGraph<Vertex, Hash>& graph) : g(graph) {
+        const std::size_t n = g.countVertices();
+
+        std::vector<Id> order(n);
+        std::iota(order.begin(), order.end(), Id{0});
+        std::stable_sort(order.begin(), order.end(), [&](Id a, Id b) {
+            return g.degree(a) > g.degree(b);
+        });
+
+        std::vector<std::vector<std::pair<Id, Distance>>> labels(n);
+        std::vector<Distance> rootLabel(n, infinity); // rootLabel[rank] = d(root, hub of that rank)
+        std::vector<Distance> level(n, infinity);
+        std::vector<Id> queue;
+        queue.reserve(n);
+
+        for (Id rank = 0; rank < n; rank++) {
+            const Id root = order[rank];
+            for (const auto& [hub, d] : labels[root]) rootLabel[hub] = d;
+
+            queue.clear();
+            queue.push_back(root);
+            level[root] = 0;
+            for (std::size_t head = 0; head < queue.size(); head++) {
+                const Id cur = queue[head];
+                const Distance d = level[cur];
+
+                // Prune if an already processed hub covers the pair (root, cur)
+                bool covered = false;
+                for (const auto& [hub, dh] : labels[cur]) {
+                    if (rootLabel[hub] != infinity && rootLabel[hub] + dh <= d) {
+                        covered = true;
+                        break;
+                    }
+                }
+                if (covered) continue;
+
+                labels[cur].emplace_back(rank, d);
+                for (Id w : g.neighbors(cur)) {
+                    if (level[w] == infinity) {
+                        level[w] = d + 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+
+            for (Id v : queue) level[v] = infinity;
+            for (const auto& [hub, d] : labels[root]) rootLabel[hub] = infinity;
+        }
+
+        labelOffsets.resize(n + 1, 0);
+        for (std::size_t v = 0; v < n; v++) labelOffsets[v + 1] = labelOffsets[v] + labels[v].size() + 1;
+        hubs.resize(labelOffsets[n]);
+        hubDist.resize(labelOffsets[n]);
+        for (std::size_t v = 0; v < n; v++) {
+            std::size_t pos = labelOffsets[v];
+            for (const auto& [hub, d] : labels[v]) {
+                hubs[pos] = hub;
+                hubDist[pos++] = d;
+            }
+            hubs[pos] = sentinel;
+            hubDist[pos] = infinity;
+            labels[v] = {};
+        }
+    }
+
+    /**
+     * @brief Returns the exact distance between two vertex ids
+     * @return The distance if a path exists, std::nullopt otherwise
+     * @note Complexity: O(|L(u)| + |L(v)|) merge of the two sorted labels
+     */
+    std::optional<int> distanceById(Id u, Id v) const {
+        if (u == v) return 0;
+        std::size_t i = labelOffsets[u], j = labelOffsets[v];
+        std::uint64_t best = std::numeric_limits<std::uint64_t>::max();
+        for (;;) {
+            const Id hu = hubs[i], hv = hubs[j];
+            if (hu == hv) {
+                if (hu == sentinel) break;
+                best = std::min<std::uint64_t>(best, std::uint64_t{hubDist[i]} + hubDist[j]);
+                i++;
+                j++;
+            } else if (hu < hv) {
+                i++;
+            } else {
+                j++;
+            }
+        }
+        if (best == std::numeric_limits<std::uint64_t>::max()) return std::nullopt;
+        return static_cast<int>(best);
+    }
+
+    /**
+     * @brief Returns the exact shortest path distance between two vertices
+     * @param u Start vertex
+     * @param v End vertex
+     * @return The distance if a path exists, std::nullopt otherwise
+     *         (same contract as Graph::distance)
+     */
+    std::optional<int> distance(const VertexParam u, const VertexParam v) const {
+        const Id iu = g.id(u), iv = g.id(v);
+        if (iu == CSRGraph<Vertex, Hash>::npos || iv == CSRGraph<Vertex, Hash>::npos) return std::nullopt;
+        return distanceById(iu, iv);
+    }
+
+    /**
+     * @brief Returns the average number of label entries per vertex
+     */
+    double averageLabelSize() const {
+        const std::size_t n = g.countVertices();
+        return n == 0 ? 0.0 : static_cast<double>(hubs.size() - n) / n;
+    }
+
+    /**
+     * @brief Returns the heap memory held by the labels, in bytes
+     */
+    std::size_t memoryBytes() const {
+        return labelOffsets.capacity() * sizeof(std::size_t)
+             + hubs.capacity() * sizeof(Id)
+             + hubDist.capacity() * sizeof(Distance);
+    }
+};
+
+#endif
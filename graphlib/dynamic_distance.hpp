@@ -0,0 +1,206 @@
+/**
+ * @file graphlib/dynamic_distance.hpp
+ * @brief Single-source BFS distances maintained incrementally under graph updates
+ */
+
+#ifndef GRAPHLIB_DYNAMIC_DISTANCE_HPP
+#define GRAPHLIB_DYNAMIC_DISTANCE_HPP
+
+#include <algorithm>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../graphlib.hpp"
+
+/**
+ * @brief Hop distances from one source vertex, kept up to date as the graph changes
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note Registers itself as an observer of the graph: every addEdge,
+ *       removeEdge, removeVertex or clear only repairs the vertices whose
+ *       distance actually changes instead of running a new BFS
+ * @note The graph must outlive this object
+ * @note Here i used Ramalingam & Reps, "On the computational complexity of
+ *       dynamic graph problems" (https://doi.org/10.1016/0304-3975(95)00079-8) as a reference
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class DynamicDistance : public GraphObserver<Vertex> {
+private:
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+
+    Graph<Vertex, Hash>& g;
+    Vertex source;
+    std::unordered_map<Vertex, int, Hash> dist; // Only reachable vertices are stored
+
+    int distanceOf(const Vertex& v) const {
+        auto it = dist.find(v);
+        return (it != dist.end()) ? it->second : -1;
+    }
+
+    // Lowers distances reachable from `start`, whose distance just decreased
+    void propagateDecrease(const Vertex& start) {
+        std::queue<Vertex> pending;
+        pending.push(start);
+        while (!pending.empty()) {
+            Vertex current = pending.front();
+            pending.pop();
+            const int next = dist[current] + 1;
+            for (const Vertex& w : g.neighbors(current)) {
+                auto it = dist.find(w);
+                if (it == dist.end()) {
+                    dist.emplace(w, next);
+                    pending.push(w);
+                } else if (it->second > next) {
+                    it->second = next;
+                    pending.push(w);
+                }
+            }
+        }
+    }
+
+    bool hasParent(const Vertex& v, int dv, const std::unordered_set<Vertex, Hash>& affected) const {
+        for (const Vertex& w : g.neighbors(v)) {
+            if (distanceOf(w) == dv - 1 && !affected.contains(w)) return true;
+        }
+        return false;
+    }
+
+    // Repairs distances after `child` lost the edge to one of its BFS parents
+    void repairIncrease(const Vertex& child) {
+        const int dc = distanceOf(child);
+        std::unordered_set<Vertex, Hash> affected;
+        if (hasParent(child, dc, affected)) return;
+
+        // Phase 1: collect vertices left without an unaffected BFS parent. The
+        // FIFO order finishes a level before checking the next one, so all
+        // affected parents of a candidate are known when it is checked.
+        std::vector<Vertex> order;
+        affected.insert(child);
+        order.push_back(child);
+        for (std::size_t head = 0; head < order.size(); head++) {
+            const Vertex current = order[head];
+            const int dnext = distanceOf(current) + 1;
+            for (const Vertex& w : g.neighbors(current)) {
+                if (distanceOf(w) == dnext && !affected.contains(w) && !hasParent(w, dnext, affected)) {
+                    affected.insert(w);
+                    order.push_back(w);
+                }
+            }
+        }
+
+        // Phase 2: seed affected vertices from their unaffected neighbors, then
+        // run a unit-weight Dijkstra (two-queue BFS) restricted to them
+        std::vector<std::pair<int, Vertex>> seeds;
+        for (const Vertex& v : order) {
+            int best = -1;
+            for (const Vertex& w : g.neighbors(v)) {
+                if (affected.contains(w)) continue;
+                const int dw = distanceOf(w);
+                if (dw >= 0 && (best < 0 || dw + 1 < best)) best = dw + 1;
+            }
+            if (best >= 0) seeds.emplace_back(best, v);
+        }
+        for (const Vertex& v : order) dist.erase(v);
+        std::sort(seeds.begin(), seeds.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::queue<std::pair<int, Vertex>> pending;
+        std::size_t nextSeed = 0;
+        while (nextSeed < seeds.size() || !pending.empty()) {
+            const bool fromSeeds = pending.empty()
+                || (nextSeed < seeds.size() && seeds[nextSeed].first <= pending.front().first);
+            const std::pair<int, Vertex> current = fromSeeds ? seeds[nextSeed++] : pending.front();
+            if (!fromSeeds) pending.pop();
+            const auto& [d, v] = current;
+            if (!dist.try_emplace(v, d).second) continue; // Already settled with a smaller distance
+            for (const Vertex& w : g.neighbors(v)) {
+                if (affected.contains(w) && !dist.contains(w)) pending.emplace(d + 1, w);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Computes distances from `src` and starts tracking updates of `graph`
+     * @param graph The graph to follow
+     * @param src The source vertex (it may be added to the graph later)
+     * @note Complexity: O(n + m) for the initial BFS
+     */
+    DynamicDistance(Graph<Vertex, Hash>& graph, const VertexParam src) : g(graph), source(src) {
+        rebuild();
+        g.attach(this);
+    }
+
+    ~DynamicDistance() override {
+        g.detach(this);
+    }
+
+    DynamicDistance(const DynamicDistance&) = delete;
+    DynamicDistance& operator=(const DynamicDistance&) = delete;
+
+    /**
+     * @brief Returns the hop distance from the source to v
+     * @param v The vertex to check
+     * @return The distance, or std::nullopt if v is unreachable or missing
+     * @note Complexity: O(1) amortized
+     */
+    std::optional<int> distanceFromSource(const VertexParam v) const {
+        auto it = dist.find(v);
+        if (it == dist.end()) return std::nullopt;
+        return it->second;
+    }
+
+    /**
+     * @brief Returns the number of vertices reachable from the source (source included)
+     * @note Complexity: O(1)
+     */
+    std::size_t countReachable() const {
+        return dist.size();
+    }
+
+    /**
+     * @brief Recomputes every distance with a full BFS
+     * @note Complexity: O(n + m)
+     */
+    void rebuild() {
+        dist.clear();
+        if (!g.containsVertex(source)) return;
+        dist.emplace(source, 0);
+        propagateDecrease(source);
+    }
+
+    void onAddVertex(const Vertex& v) override {
+        if (v == source) dist.emplace(source, 0);
+    }
+
+    void onAddEdge(const Vertex& u, const Vertex& v) override {
+        const int du = distanceOf(u), dv = distanceOf(v);
+        if (du >= 0 && (dv < 0 || du + 1 < dv)) {
+            dist[v] = du + 1;
+            propagateDecrease(v);
+        } else if (dv >= 0 && (du < 0 || dv + 1 < du)) {
+            dist[u] = dv + 1;
+            propagateDecrease(u);
+        }
+    }
+
+    void onRemoveEdge(const Vertex& u, const Vertex& v) override {
+        const int du = distanceOf(u), dv = distanceOf(v);
+        if (du < 0 || dv < 0 || du == dv) return; // Not a BFS tree edge
+        repairIncrease(du < dv ? v : u);
+    }
+
+    void onRemoveVertex(const Vertex& v) override {
+        // Incident edges have already been reported, v is isolated
+        dist.erase(v);
+    }
+
+    void onClear() override {
+        dist.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,461 @@
+/**
+ * @file graphlib/external.hpp
+ * @brief Out-of-core graph stored in a partitioned file, with semi-external BFS and connected components
+ *
+ * Only per-vertex state (a few bytes per vertex) lives in memory. Adjacency
+ * stays on disk, split into partitions of consecutive vertex ids that each
+ * fit in a fixed memory budget, and algorithms stream the partitions
+ * sequentially with one large read each.
+ */
+
+#ifndef GRAPHLIB_EXTERNAL_HPP
+#define GRAPHLIB_EXTERNAL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief I/O and time spent by an ExternalGraph
+ */
+struct IoStats {
+    std::uint64_t bytesRead = 0;      ///< Bytes read from the graph file
+    std::uint64_t bytesWritten = 0;   ///< Bytes written while building (temporary files included)
+    std::uint64_t readCalls = 0;      ///< Read requests issued
+    std::uint64_t partitionLoads = 0; ///< Partitions loaded into memory
+    std::uint64_t passes = 0;         ///< Sequential passes started over the partitions
+    double seconds = 0;               ///< Wall time of the last build or algorithm
+};
+
+/**
+ * @brief Undirected graph on vertices 0..n-1 whose adjacency lives in a file
+ * @note File layout: a header, a table with the vertex range and position of
+ *       every partition, then per partition the degrees of its vertices and
+ *       their sorted neighbor lists (32-bit ids)
+ * @note Every partition fits in the memory budget given to build(), except a
+ *       partition made of a single vertex whose list alone exceeds it
+ * @note Here i used Abello, Buchsbaum & Westbrook, "A Functional Approach to
+ *       External Graph Algorithms" (https://doi.org/10.1007/s00453-001-0088-5) as a reference
+ */
+class ExternalGraph {
+public:
+    using Id = std::uint32_t;
+
+    /// Distance of vertices not reached by bfs()
+    static constexpr Id unreachable = std::numeric_limits<Id>::max();
+
+private:
+    struct FileCloser {
+        void operator()(std::FILE* f) const { std::fclose(f); }
+    };
+    using File = std::unique_ptr<std::FILE, FileCloser>;
+
+    struct Partition {
+        Id first = 0;              // First vertex
+        Id count = 0;              // Number of vertices
+        std::uint64_t offset = 0;  // Position in the file
+        std::uint64_t entries = 0; // Neighbor entries (half-edges)
+
+        std::uint64_t bytes() const {
+            return (static_cast<std::uint64_t>(count) + entries) * sizeof(Id);
+        }
+    };
+
+    static constexpr std::uint64_t magic = 0x31424c4850524747ULL; // "GGRPHLB1"
+
+    File file;
+    std::size_t n = 0;
+    std::uint64_t halfEdges = 0;
+    std::vector<Partition> parts;
+    std::vector<Id> buffer; // Holds one partition at a time
+    mutable IoStats io;
+
+    static bool seek(std::FILE* f, std::uint64_t pos) {
+#ifdef _WIN32
+        return _fseeki64(f, static_cast<long long>(pos), SEEK_SET) == 0;
+#else
+        return fseeko(f, static_cast<off_t>(pos), SEEK_SET) == 0;
+#endif
+    }
+
+    // Size of the file in bytes, 0 if it cannot be determined
+    static std::uint64_t size(std::FILE* f) {
+#ifdef _WIN32
+        if (_fseeki64(f, 0, SEEK_END) != 0) return 0;
+        const long long end = _ftelli64(f);
+#else
+        if (fseeko(f, 0, SEEK_END) != 0) return 0;
+        const off_t end = ftello(f);
+#endif
+        return end < 0 ? 0 : static_cast<std::uint64_t>(end);
+    }
+
+    static bool writeAll(std::FILE* f, const void* data, std::size_t bytes, IoStats& stats) {
+        stats.bytesWritten += bytes;
+        return bytes == 0 || std::fwrite(data, 1, bytes, f) == bytes;
+    }
+
+    bool readAll(void* data, std::size_t bytes) {
+        io.bytesRead += bytes;
+        io.readCalls++;
+        return bytes == 0 || std::fread(data, 1, bytes, file.get()) == bytes;
+    }
+
+    // Loads partition p into buffer: degrees first, then the neighbor lists
+    bool load(std::size_t p) {
+        const Partition& part = parts[p];
+        buffer.resize(part.count + part.entries);
+        io.partitionLoads++;
+        return seek(file.get(), part.offset) && readAll(buffer.data(), part.bytes());
+    }
+
+    // Calls fn(v, neighbors) for every vertex of the partition held in buffer
+    template<typename Fn>
+    void forEachList(std::size_t p, Fn& fn) const {
+        const Partition& part = parts[p];
+        const Id* degrees = buffer.data();
+        const Id* lists = degrees + part.count;
+        for (Id k = 0; k < part.count; k++) {
+            fn(part.first + k, std::span<const Id>(lists, degrees[k]));
+            lists += degrees[k];
+        }
+    }
+
+    std::size_t partitionOf(Id v) const {
+        return std::upper_bound(parts.begin(), parts.end(), v, [](Id x, const Partition& part) {
+            return x < part.first;
+        }) - parts.begin() - 1;
+    }
+
+    ExternalGraph() = default;
+
+public:
+    ExternalGraph(ExternalGraph&&) = default;
+    ExternalGraph& operator=(ExternalGraph&&) = default;
+
+    /**
+     * @brief Writes a partitioned graph file from a stream of edges
+     * @param path Output file; temporary files "<path>.tmp<k>" are created next to it
+     * @param vertices Number of vertices n, every endpoint must be < n
+     * @param source Callable invoked as source(emit), calling emit(u, v) once
+     *        per undirected edge; it is invoked twice, so it must replay the
+     *        same edges (e.g. by re-reading an input file)
+     * @param memoryBudget Bytes of adjacency data allowed in memory at once
+     * @param stats If not null, receives the I/O of the build
+     * @return true on success, false on an I/O error
+     * @note Self-loops and duplicate edges are dropped, matching Graph::addEdge
+     * @note Memory: O(n) for the degrees plus the budget
+     * @note Complexity: two passes over the source, then O(m) I/O
+     */
+    template<typename EdgeSource>
+        requires (!std::is_convertible_v<EdgeSource, const std::vector<std::pair<std::uint32_t, std::uint32_t>>&>)
+    static bool build(const std::string& path, std::size_t vertices, EdgeSource&& source,
+                      std::size_t memoryBudget, IoStats* stats = nullptr) {
+        IoStats local;
+        IoStats& st = stats ? *stats : local;
+        st = {};
+        const auto start = std::chrono::steady_clock::now();
+
+        // Pass 1: degrees, which decide the partition boundaries
+        std::vector<std::uint64_t> degree(vertices, 0);
+        source([&](Id u, Id v) {
+            if (u == v) return;
+            degree[u]++;
+            degree[v]++;
+        });
+
+        // Temporary half-edges take 8 bytes, so a partition may hold budget / 8 of them
+        const std::uint64_t capacity = std::max<std::uint64_t>(1, memoryBudget / (2 * sizeof(Id)));
+        std::vector<Partition> parts;
+        std::vector<std::uint32_t> partOf(vertices);
+        for (std::size_t v = 0; v < vertices; v++) {
+            const std::uint64_t need = degree[v] + 1;
+            if (parts.empty() || parts.back().entries + parts.back().count + need > capacity) {
+                parts.push_back({static_cast<Id>(v), 0, 0, 0});
+            }
+            parts.back().count++;
+            parts.back().entries += degree[v];
+            partOf[v] = static_cast<std::uint32_t>(parts.size() - 1);
+        }
+        degree = {};
+
+        // Pass 2: scatter half-edges into one temporary file per partition. The
+        // files are opened only to append a full buffer, so the number of
+        // partitions is not limited by the number of open files
+        const std::size_t P = parts.size();
+        const std::size_t perBuffer = std::max<std::size_t>(64, memoryBudget / (2 * sizeof(Id)) / std::max<std::size_t>(P, 1));
+        auto tmpPath = [&](std::size_t p) { return path + ".tmp" + std::to_string(p); };
+        std::vector<std::vector<std::pair<Id, Id>>> pending(P);
+        std::vector<std::size_t> flushed(P, 0);
+        bool ok = true;
+        auto push = [&](Id u, Id v) {
+            const std::uint32_t p = partOf[u];
+            auto& buf = pending[p];
+            buf.emplace_back(u, v);
+            if (buf.size() >= perBuffer) {
+                File tmp(std::fopen(tmpPath(p).c_str(), flushed[p] ? "ab" : "wb"));
+                ok = ok && tmp && writeAll(tmp.get(), buf.data(), buf.size() * sizeof(buf[0]), st);
+                flushed[p] += buf.size();
+                buf.clear();
+            }
+        };
+        source([&](Id u, Id v) {
+            if (u == v) return;
+            push(u, v);
+            push(v, u);
+        });
+        partOf = {};
+
+        File out(std::fopen(path.c_str(), "wb"));
+        const std::uint64_t headerBytes = 4 * sizeof(std::uint64_t) + P * sizeof(Partition);
+        std::uint64_t position = headerBytes;
+        std::uint64_t totalEntries = 0;
+        ok = ok && out && seek(out.get(), headerBytes);
+
+        // Pass 3: sort and deduplicate each partition in memory, append it to the file
+        std::vector<std::pair<Id, Id>> halfs;
+        std::vector<Id> block;
+        for (std::size_t p = 0; p < P && ok; p++) {
+            Partition& part = parts[p];
+            halfs.resize(part.entries);
+            if (flushed[p]) {
+                File tmp(std::fopen(tmpPath(p).c_str(), "rb"));
+                ok = tmp && std::fread(halfs.data(), sizeof(halfs[0]), flushed[p], tmp.get()) == flushed[p];
+                st.bytesRead += flushed[p] * sizeof(halfs[0]);
+                if (!ok) break;
+            }
+            std::copy(pending[p].begin(), pending[p].end(), halfs.begin() + flushed[p]);
+            pending[p] = {};
+
+            std::sort(halfs.begin(), halfs.end());
+            halfs.erase(std::unique(halfs.begin(), halfs.end()), halfs.end());
+
+            // A spill file changed behind our back must not write out of bounds
+            block.assign(part.count, 0);
+            for (const auto& [u, v] : halfs) {
+                if (u < part.first || u - part.first >= part.count || v >= vertices) {
+                    ok = false;
+                    break;
+                }
+                block[u - part.first]++;
+            }
+            if (!ok) break;
+            for (const auto& [u, v] : halfs) block.push_back(v);
+            part.entries = halfs.size();
+            part.offset = position;
+            position += part.bytes();
+            totalEntries += part.entries;
+            ok = ok && writeAll(out.get(), block.data(), block.size() * sizeof(Id), st);
+        }
+        for (std::size_t p = 0; p < P; p++) {
+            if (flushed[p]) std::remove(tmpPath(p).c_str());
+        }
+
+        const std::uint64_t header[4] = {magic, vertices, totalEntries, P};
+        ok = ok && seek(out.get(), 0)
+                && writeAll(out.get(), header, sizeof(header), st)
+                && writeAll(out.get(), parts.data(), P * sizeof(Partition), st);
+        ok = ok && std::fflush(out.get()) == 0;
+        st.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return ok;
+    }
+
+    /**
+     * @brief Writes a partitioned graph file from an in-memory edge list
+     * @see build(path, vertices, source, memoryBudget, stats)
+     */
+    static bool build(const std::string& path, std::size_t vertices, const std::vector<std::pair<Id, Id>>& edges,
+                      std::size_t memoryBudget, IoStats* stats = nullptr) {
+        return build(path, vertices, [&](auto&& emit) {
+            for (const auto& [u, v] : edges) emit(u, v);
+        }, memoryBudget, stats);
+    }
+
+    /**
+     * @brief Opens a file written by build()
+     * @param path The graph file
+     * @return The graph, or std::nullopt if the file is missing, truncated or not a graph file
+     * @note Only the partition table is read; adjacency is loaded on demand
+     */
+    static std::optional<ExternalGraph> open(const std::string& path) {
+        ExternalGraph g;
+        g.file.reset(std::fopen(path.c_str(), "rb"));
+        if (!g.file) return std::nullopt;
+        const std::uint64_t fileBytes = size(g.file.get());
+        if (!seek(g.file.get(), 0)) return std::nullopt;
+        std::setvbuf(g.file.get(), nullptr, _IONBF, 0); // Partitions are read in one request each
+
+        std::uint64_t header[4];
+        if (!g.readAll(header, sizeof(header)) || header[0] != magic) return std::nullopt;
+        const std::uint64_t tableBytes = fileBytes - sizeof(header);
+        if (header[3] > tableBytes / sizeof(Partition)) return std::nullopt;
+        g.n = header[1];
+        g.halfEdges = header[2];
+        g.parts.resize(header[3]);
+        if (!g.readAll(g.parts.data(), g.parts.size() * sizeof(Partition))) return std::nullopt;
+
+        // Partitions must cover 0..n-1 in order and lie inside the file
+        std::uint64_t nextVertex = 0, entries = 0;
+        const std::uint64_t dataStart = sizeof(header) + g.parts.size() * sizeof(Partition);
+        for (const Partition& part : g.parts) {
+            if (part.first != nextVertex || part.offset < dataStart || part.offset > fileBytes
+                || part.entries > fileBytes / sizeof(Id) || part.bytes() > fileBytes - part.offset) {
+                return std::nullopt;
+            }
+            nextVertex += part.count;
+            entries += part.entries;
+        }
+        if (nextVertex != g.n || entries != g.halfEdges) return std::nullopt;
+        return g;
+    }
+
+    /**
+     * @brief Returns the number of vertices
+     */
+    std::size_t countVertices() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the number of undirected edges
+     */
+    std::size_t countEdges() const {
+        return halfEdges / 2;
+    }
+
+    /**
+     * @brief Returns the number of partitions in the file
+     */
+    std::size_t countPartitions() const {
+        return parts.size();
+    }
+
+    /**
+     * @brief Returns the size of the largest partition, i.e. the adjacency memory in use
+     */
+    std::size_t maxPartitionBytes() const {
+        std::uint64_t res = 0;
+        for (const auto& part : parts) res = std::max(res, part.bytes());
+        return res;
+    }
+
+    /**
+     * @brief Returns the I/O accumulated since opening or the last reset
+     */
+    const IoStats& ioStats() const {
+        return io;
+    }
+
+    void resetIoStats() {
+        io = {};
+    }
+
+    /**
+     * @brief Streams the whole graph: calls fn(v, neighbors) for every vertex in id order
+     * @param fn Callable invoked as fn(Id, std::span<const Id>); the span is
+     *        only valid during the call
+     * @return false on an I/O error
+     * @note One sequential pass, one read per partition
+     */
+    template<typename Fn>
+    bool scan(Fn&& fn) {
+        io.passes++;
+        for (std::size_t p = 0; p < parts.size(); p++) {
+            if (!load(p)) return false;
+            forEachList(p, fn);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Semi-external BFS: hop distances from a source vertex
+     * @param source A vertex id < countVertices()
+     * @return dist[v] for every vertex, unreachable if v is not connected to
+     *         the source; empty on an I/O error or an invalid source
+     * @note Memory: one distance and one bit per vertex plus one partition
+     * @note Each level is one pass that only loads the partitions holding
+     *       vertices of the current frontier
+     * @note Complexity: O(n + m) CPU, O(D * m) I/O in the worst case where
+     *       D is the eccentricity of the source
+     */
+    std::vector<Id> bfs(Id source) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Id> dist;
+        if (source >= n) return dist;
+        dist.assign(n, unreachable);
+        dist[source] = 0;
+
+        std::vector<bool> active(parts.size(), false), next(parts.size(), false);
+        active[partitionOf(source)] = true;
+        bool any = true;
+        for (Id level = 0; any; level++) {
+            any = false;
+            io.passes++;
+            auto relax = [&](Id v, std::span<const Id> nbrs) {
+                if (dist[v] != level) return;
+                for (Id w : nbrs) {
+                    if (dist[w] == unreachable) {
+                        dist[w] = level + 1;
+                        next[partitionOf(w)] = true;
+                        any = true;
+                    }
+                }
+            };
+            for (std::size_t p = 0; p < parts.size(); p++) {
+                if (!active[p]) continue;
+                if (!load(p)) return {};
+                forEachList(p, relax);
+            }
+            std::swap(active, next);
+            std::fill(next.begin(), next.end(), false);
+        }
+        io.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return dist;
+    }
+
+    /**
+     * @brief Semi-external connected components with a union-find over vertex ids
+     * @return label[v] for every vertex: the smallest vertex id of its
+     *         component; empty on an I/O error
+     * @note Memory: one parent id per vertex plus one partition
+     * @note Complexity: a single pass over the file, O(m α(n)) CPU
+     */
+    std::vector<Id> connectedComponents() {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Id> parent(n);
+        for (Id v = 0; v < n; v++) parent[v] = v;
+        auto find = [&](Id x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]]; // Path halving
+                x = parent[x];
+            }
+            return x;
+        };
+
+        const bool ok = scan([&](Id v, std::span<const Id> nbrs) {
+            for (Id w : nbrs) {
+                if (w < v) continue; // Each edge is stored twice
+                Id a = find(v), b = find(w);
+                if (a == b) continue;
+                // The smaller id becomes the root, so roots are component minimums
+                if (a < b) parent[b] = a;
+                else parent[a] = b;
+            }
+        });
+        if (!ok) return {};
+        for (Id v = 0; v < n; v++) parent[v] = find(v);
+        io.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return parent;
+    }
+};
+
+#endif
@@ -0,0 +1,666 @@
+/**
+ * @file graphlib/journal.hpp
+ * @brief Append-only write-ahead journal of Graph mutations, with snapshots, crash recovery and tailing
+ *
+ * A Journal observes a Graph and appends one small checksummed record per
+ * mutation to a log file. Records are buffered and written in groups, one
+ * write per commit. compact() folds the log into a snapshot file, so
+ * recovery loads the snapshot with one read and replays only the records
+ * written after it. A JournalFollower reads the same files to keep a
+ * replica up to date while the writer keeps appending.
+ */
+
+#ifndef GRAPHLIB_JOURNAL_HPP
+#define GRAPHLIB_JOURNAL_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "../graphlib.hpp"
+#include "mutation_batch.hpp"
+
+/**
+ * @brief Binary encoding of a vertex in journal records and snapshots
+ * @tparam Vertex Vertex type
+ * @note The default stores the bytes of trivially copyable types, so files
+ *       are only portable between machines of the same endianness;
+ *       specialize it for other vertex types
+ */
+template<typename Vertex>
+struct JournalCodec {
+    static_assert(std::is_trivially_copyable_v<Vertex>, "Specialize JournalCodec for this vertex type");
+
+    static void write(std::vector<std::uint8_t>& out, const Vertex& v) {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(&v);
+        out.insert(out.end(), bytes, bytes + sizeof(Vertex));
+    }
+
+    static bool read(const std::uint8_t*& p, const std::uint8_t* end, Vertex& v) {
+        if (static_cast<std::size_t>(end - p) < sizeof(Vertex)) return false;
+        std::memcpy(&v, p, sizeof(Vertex));
+        p += sizeof(Vertex);
+        return true;
+    }
+};
+
+/**
+ * @brief Strings are stored as a 32-bit length followed by their bytes
+ */
+template<>
+struct JournalCodec<std::string> {
+    static void write(std::vector<std::uint8_t>& out, const std::string& v) {
+        const auto len = static_cast<std::uint32_t>(v.size());
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(&len);
+        out.insert(out.end(), bytes, bytes + sizeof(len));
+        out.insert(out.end(), v.begin(), v.end());
+    }
+
+    static bool read(const std::uint8_t*& p, const std::uint8_t* end, std::string& v) {
+        std::uint32_t len;
+        if (static_cast<std::size_t>(end - p) < sizeof(len)) return false;
+        std::memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        if (static_cast<std::size_t>(end - p) < len) return false;
+        v.assign(reinterpret_cast<const char*>(p), len);
+        p += len;
+        return true;
+    }
+};
+
+/**
+ * @brief Options of a Journal
+ */
+struct JournalOptions {
+    std::size_t groupBytes = 1 << 16; ///< Buffered bytes that trigger a commit; 0 commits every record
+    bool sync = false;                ///< fsync() the log on every commit (POSIX only), not just flush it
+    std::uint64_t compactBytes = 0;   ///< Log size that triggers compact() after a commit; 0 disables it
+};
+
+/**
+ * @brief What recovery found on disk, as returned by Journal::recover()
+ */
+struct RecoveryStats {
+    std::uint64_t snapshotSequence = 0; ///< Records folded into the snapshot (0 without snapshot)
+    std::uint64_t recordsReplayed = 0;  ///< Log records applied after the snapshot
+    std::uint64_t validBytes = 0;       ///< Length of the intact prefix of the log
+    std::uint64_t discardedBytes = 0;   ///< Bytes after it: a torn or corrupted tail
+};
+
+namespace graphlib::detail {
+    // CRC-32 (IEEE 802.3, reflected), one table lookup per byte
+    inline constexpr auto crcTable = [] {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }();
+
+    inline std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; i++) crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+}
+
+/**
+ * @brief Write-ahead journal of the mutations of a Graph
+ * @tparam Vertex Vertex type, encoded with JournalCodec<Vertex>
+ * @tparam Hash Hash function (default: std::hash<Vertex>)
+ * @note Files: the log "<path>" (a header with the sequence number of its
+ *       first record, then records [length][crc32][op][vertices]) and the
+ *       snapshot "<path>.snap" (a header with the sequence number and the
+ *       counts, every vertex, then every edge as a pair of vertex indices,
+ *       then a crc32 of everything after the magic number)
+ * @note Records reach the file on commit(): when groupBytes are buffered,
+ *       on compact() and on destruction. A crash loses the records buffered
+ *       since the last commit, never earlier ones; a record torn by the
+ *       crash fails its checksum and is discarded by recovery
+ * @note removeVertex(v) is journaled as the removal of each incident edge,
+ *       then of v, the way observers see it
+ * @note Registers itself as an observer of the graph, which must outlive it
+ * @note Here i used Mohan et al., "ARIES: A Transaction Recovery Method"
+ *       (https://doi.org/10.1145/128765.128770) for the log and group commit,
+ *       and the Raft log compaction scheme (Ongaro & Ousterhout, "In Search of
+ *       an Understandable Consensus Algorithm", https://raft.github.io/raft.pdf)
+ *       for snapshots as a reference
+ */
+template<typename Vertex, typename Hash = std::hash<Vertex>>
+class Journal : public GraphObserver<Vertex> {
+public:
+    enum class Op : std::uint8_t { AddVertex = 1, AddEdge = 2, RemoveEdge = 3, RemoveVertex = 4, Clear = 5 };
+
+    static constexpr std::uint64_t logMagic = 0x314c4a4850524747ULL;      // "GGRPHJL1"
+    static constexpr std::uint64_t snapshotMagic = 0x32534a4850524747ULL; // "GGRPHJS2"
+    static constexpr std::size_t headerBytes = 2 * sizeof(std::uint64_t);
+    static constexpr std::size_t recordHeaderBytes = 2 * sizeof(std::uint32_t);
+
+private:
+    using Codec = JournalCodec<Vertex>;
+
+    struct FileCloser {
+        void operator()(std::FILE* f) const { std::fclose(f); }
+    };
+    using File = std::unique_ptr<std::FILE, FileCloser>;
+
+    Graph<Vertex, Hash>& g;
+    std::string path;
+    JournalOptions options;
+    File log;
+    std::vector<std::uint8_t> buffer; // Records not committed yet
+    std::uint64_t sequence = 0;       // Sequence number of the next record
+    std::uint64_t logBytes = 0;       // Committed size of the log file
+    bool failed = false;
+
+    Journal(Graph<Vertex, Hash>& graph, std::string file, const JournalOptions& opts)
+        : g(graph), path(std::move(file)), options(opts) {}
+
+    static std::string snapshotPath(const std::string& path) {
+        return path + ".snap";
+    }
+
+    // Appends one record framed by its length and checksum
+    template<typename... Vertices>
+    static void encode(std::vector<std::uint8_t>& out, Op op, const Vertices&... vs) {
+        const std::size_t start = out.size();
+        out.resize(start + recordHeaderBytes);
+        out.push_back(static_cast<std::uint8_t>(op));
+        (Codec::write(out, vs), ...);
+        const auto length = static_cast<std::uint32_t>(out.size() - start - recordHeaderBytes);
+        const std::uint32_t crc = graphlib::detail::crc32(out.data() + start + recordHeaderBytes, length);
+        std::memcpy(out.data() + start, &length, sizeof(length));
+        std::memcpy(out.data() + start + sizeof(length), &crc, sizeof(crc));
+    }
+
+    template<typename... Vertices>
+    void append(Op op, const Vertices&... vs) {
+        if (failed) return;
+        encode(buffer, op, vs...);
+        sequence++;
+        if (buffer.size() >= options.groupBytes) commit();
+    }
+
+    static bool writeHeader(std::FILE* f, std::uint64_t firstSequence) {
+        const std::uint64_t header[2] = {logMagic, firstSequence};
+        return std::fwrite(header, 1, headerBytes, f) == headerBytes && std::fflush(f) == 0;
+    }
+
+    static bool readFile(const std::string& file, std::vector<std::uint8_t>& out) {
+        File f(std::fopen(file.c_str(), "rb"));
+        out.clear();
+        if (!f) return false;
+        std::uint8_t chunk[1 << 16];
+        std::size_t got;
+        while ((got = std::fread(chunk, 1, sizeof(chunk), f.get())) > 0) out.insert(out.end(), chunk, chunk + got);
+        return true;
+    }
+
+public:
+    /**
+     * @brief Walks the intact records of a log buffer
+     * @param p First record, just after the header
+     * @param end End of the buffer
+     * @param fn Called as fn(op, payload, payloadEnd) for each record; returns false to stop
+     * @return Bytes consumed by intact records; scanning stops at the first
+     *         record that is incomplete or fails its checksum
+     */
+    template<typename Fn>
+    static std::size_t scanRecords(const std::uint8_t* p, const std::uint8_t* end, Fn&& fn) {
+        const std::uint8_t* start = p;
+        while (static_cast<std::size_t>(end - p) >= recordHeaderBytes) {
+            std::uint32_t length, crc;
+            std::memcpy(&length, p, sizeof(length));
+            std::memcpy(&crc, p + sizeof(length), sizeof(crc));
+            const std::uint8_t* payload = p + recordHeaderBytes;
+            if (length == 0 || static_cast<std::size_t>(end - payload) < length) break;
+            if (graphlib::detail::crc32(payload, length) != crc) break;
+            if (!fn(static_cast<Op>(payload[0]), payload + 1, payload + length)) break;
+            p = payload + length;
+        }
+        return static_cast<std::size_t>(p - start);
+    }
+
+    /**
+     * @brief Applies the payload of one record to a graph or to a MutationBatch
+     * @return false if the payload does not decode
+     * @note Op::Clear is ignored by a batch: the caller clears the batch and the graph
+     */
+    template<typename Target>
+    static bool apply(Target& target, Op op, const std::uint8_t* p, const std::uint8_t* end) {
+        Vertex u{}, v{};
+        switch (op) {
+        case Op::AddVertex:
+            if (!Codec::read(p, end, u)) return false;
+            target.addVertex(u);
+            return true;
+        case Op::AddEdge:
+            if (!Codec::read(p, end, u) || !Codec::read(p, end, v)) return false;
+            target.addEdge(u, v);
+            return true;
+        case Op::RemoveEdge:
+            if (!Codec::read(p, end, u) || !Codec::read(p, end, v)) return false;
+            target.removeEdge(u, v);
+            return true;
+        case Op::RemoveVertex:
+            if (!Codec::read(p, end, u)) return false;
+            target.removeVertex(u);
+            return true;
+        case Op::Clear:
+            if constexpr (requires { target.countEdges(); }) target.clear();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Replaces the content of a graph with the snapshot of a journal
+     * @param path The log path given to open(); the snapshot is "<path>.snap"
+     * @param target Graph to fill, cleared first
+     * @return The sequence number stored in the snapshot, 0 if there is no
+     *         snapshot, or std::nullopt if the snapshot is corrupted
+     * @note Complexity: O(n + m), one read of the whole file
+     */
+    static std::optional<std::uint64_t> loadSnapshot(const std::string& path, Graph<Vertex, Hash>& target) {
+        target.clear();
+        std::vector<std::uint8_t> data;
+        if (!readFile(snapshotPath(path), data)) return std::uint64_t{0};
+
+        constexpr std::size_t fixed = 4 * sizeof(std::uint64_t);
+        if (data.size() < fixed + sizeof(std::uint32_t)) return std::nullopt;
+        std::uint64_t header[4];
+        std::memcpy(header, data.data(), sizeof(header));
+        std::uint32_t crc;
+        std::memcpy(&crc, data.data() + data.size() - sizeof(crc), sizeof(crc));
+        const std::uint8_t* p = data.data() + fixed;
+        const std::uint8_t* end = data.data() + data.size() - sizeof(crc);
+        const std::uint8_t* covered = data.data() + sizeof(std::uint64_t); // The header is checksummed too
+        if (header[0] != snapshotMagic || graphlib::detail::crc32(covered, end - covered) != crc) return std::nullopt;
+
+        // Every vertex takes at least one byte, so a count larger than the
+        // body is corrupted, and allocating for it could throw
+        if (header[2] > static_cast<std::uint64_t>(end - p)) return std::nullopt;
+        MutationBatch<Vertex, Hash> batch;
+        std::vector<Vertex> vertices(header[2]);
+        for (auto& v : vertices) {
+            if (!Codec::read(p, end, v)) return std::nullopt;
+            batch.addVertex(v);
+        }
+        const std::size_t edgeBytes = 2 * sizeof(std::uint32_t);
+        const auto rest = static_cast<std::size_t>(end - p);
+        if (rest % edgeBytes != 0 || rest / edgeBytes != header[3]) return std::nullopt;
+        for (std::uint64_t e = 0; e < header[3]; e++) {
+            std::uint32_t ends[2];
+            std::memcpy(ends, p, sizeof(ends));
+            p += sizeof(ends);
+            if (ends[0] >= vertices.size() || ends[1] >= vertices.size()) return std::nullopt;
+            batch.addEdge(vertices[ends[0]], vertices[ends[1]]);
+        }
+        batch.applyTo(target);
+        return header[1];
+    }
+
+    /**
+     * @brief Rebuilds a graph from the snapshot and log of a journal
+     * @param path The log path given to open()
+     * @param target Graph to fill, cleared first; attach no Journal to it
+     *        before recovery, or replayed records would be journaled again
+     * @return What was found, or std::nullopt if the snapshot is corrupted,
+     *         does not match the log, or a record passes its checksum but
+     *         does not decode
+     * @note The log is read with one request and replayed from memory; the
+     *       first record that is incomplete or fails its checksum ends the
+     *       replay, so a tail torn by a crash is ignored. A record with a
+     *       valid checksum was committed: if it does not decode, the records
+     *       after it are committed too, so recovery fails rather than drop them
+     * @note Complexity: O(size of the snapshot + size of the log)
+     */
+    static std::optional<RecoveryStats> recover(const std::string& path, Graph<Vertex, Hash>& target) {
+        RecoveryStats res;
+        auto snapshot = loadSnapshot(path, target);
+        if (!snapshot) return std::nullopt;
+        res.snapshotSequence = *snapshot;
+
+        std::vector<std::uint8_t> data;
+        if (!readFile(path, data) || data.size() < headerBytes) {
+            res.discardedBytes = data.size(); // Missing log, or a crash while it was created
+            return res;
+        }
+        std::uint64_t header[2];
+        std::memcpy(header, data.data(), sizeof(header));
+        if (header[0] != logMagic || header[1] > res.snapshotSequence) return std::nullopt; // Missing snapshot
+
+        // Records already folded into the snapshot (a crash between writing
+        // the snapshot and truncating the log) are skipped
+        // The records are grouped into a MutationBatch, which applies them in
+        // one pass per adjacency set with the same result as one by one
+        std::uint64_t skip = res.snapshotSequence - header[1];
+        bool undecodable = false;
+        MutationBatch<Vertex, Hash> batch;
+        const std::size_t valid = scanRecords(data.data() + headerBytes, data.data() + data.size(),
+                                              [&](Op op, const std::uint8_t* p, const std::uint8_t* end) {
+            if (skip > 0) {
+                skip--;
+                return true;
+            }
+            if (op == Op::Clear) {
+                batch.clear();
+                target.clear();
+            } else if (!apply(batch, op, p, end)) {
+                undecodable = true;
+                return false;
+            }
+            res.recordsReplayed++;
+            return true;
+        });
+        if (undecodable) return std::nullopt;
+        if (skip > 0) return std::nullopt; // The snapshot is ahead of every intact record
+        batch.applyTo(target);
+        res.validBytes = headerBytes + valid;
+        res.discardedBytes = data.size() - res.validBytes;
+        return res;
+    }
+
+    /**
+     * @brief Recovers a graph from a journal and starts journaling its mutations
+     * @param path The log file, created if missing; the snapshot is "<path>.snap"
+     * @param graph Graph to recover into (cleared first) and then observe
+     * @param opts Group commit and compaction settings
+     * @param stats Optional output: what recovery found
+     * @return The journal, or nullptr if the files are corrupted or cannot be opened
+     * @note A torn tail is cut off the log before appending to it; a log
+     *       recover() rejects is left untouched
+     */
+    static std::unique_ptr<Journal> open(const std::string& path, Graph<Vertex, Hash>& graph,
+                                         const JournalOptions& opts = {}, RecoveryStats* stats = nullptr) {
+        auto recovered = recover(path, graph);
+        if (!recovered) return nullptr;
+        if (stats) *stats = *recovered;
+
+        std::unique_ptr<Journal> j(new Journal(graph, path, opts));
+        j->sequence = recovered->snapshotSequence + recovered->recordsReplayed;
+        if (recovered->validBytes == 0) {
+            // No usable log: start one after the snapshot
+            j->log.reset(std::fopen(path.c_str(), "wb"));
+            if (!j->log || !writeHeader(j->log.get(), j->sequence)) return nullptr;
+            j->logBytes = headerBytes;
+        } else {
+            std::error_code ec;
+            if (recovered->discardedBytes > 0) std::filesystem::resize_file(path, recovered->validBytes, ec);
+            if (ec) return nullptr;
+            j->log.reset(std::fopen(path.c_str(), "ab"));
+            if (!j->log) return nullptr;
+            j->logBytes = recovered->validBytes;
+        }
+        graph.attach(j.get());
+        return j;
+    }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    ~Journal() override {
+        commit();
+        g.detach(this);
+    }
+
+    /**
+     * @brief Writes the buffered records to the log with one write, then flushes it
+     * @return false if a write failed; the journal then stops writing
+     * @note With JournalOptions::sync, also waits for the data to reach the disk
+     * @note Complexity: O(buffered bytes)
+     */
+    bool commit() {
+        if (failed) return false;
+        if (buffer.empty()) return true;
+        if (std::fwrite(buffer.data(), 1, buffer.size(), log.get()) != buffer.size() || std::fflush(log.get()) != 0) {
+            failed = true;
+            return false;
+        }
+#if defined(__unix__) || defined(__APPLE__)
+        if (options.sync && ::fsync(fileno(log.get())) != 0) {
+            failed = true;
+            return false;
+        }
+#endif
+        logBytes += buffer.size();
+        buffer.clear();
+        if (options.compactBytes > 0 && logBytes >= options.compactBytes) return compact();
+        return true;
+    }
+
+    /**
+     * @brief Folds the log into a new snapshot of the graph, then empties the log
+     * @return false if a write failed
+     * @note The snapshot is written to "<path>.snap.tmp" and renamed over the
+     *       previous one, so a crash leaves either snapshot intact; records of
+     *       the old log that are already in the snapshot are skipped on recovery
+     * @note Complexity: O(n + m)
+     */
+    bool compact() {
+        if (!commit()) return false;
+
+        std::unordered_map<Vertex, std::uint32_t, Hash> index;
+        index.reserve(g.countVertices());
+        std::vector<std::uint8_t> out(4 * sizeof(std::uint64_t));
+        for (const Vertex& v : g) {
+            index.emplace(v, static_cast<std::uint32_t>(index.size()));
+            Codec::write(out, v);
+        }
+        std::uint64_t edges = 0;
+        for (const Vertex& v : g) {
+            const std::uint32_t i = index.find(v)->second;
+            for (const Vertex& w : g.neighbors(v)) {
+                const std::uint32_t k = index.find(w)->second;
+                if (k < i) continue;
+                const std::uint32_t ends[2] = {i, k};
+                const auto* bytes = reinterpret_cast<const std::uint8_t*>(ends);
+                out.insert(out.end(), bytes, bytes + sizeof(ends));
+                edges++;
+            }
+        }
+        const std::uint64_t header[4] = {snapshotMagic, sequence, g.countVertices(), edges};
+        std::memcpy(out.data(), header, sizeof(header));
+        const std::uint32_t crc = graphlib::detail::crc32(out.data() + sizeof(std::uint64_t), out.size() - sizeof(std::uint64_t));
+        const auto* crcBytes = reinterpret_cast<const std::uint8_t*>(&crc);
+        out.insert(out.end(), crcBytes, crcBytes + sizeof(crc));
+
+        const std::string tmp = snapshotPath(path) + ".tmp";
+        {
+            File f(std::fopen(tmp.c_str(), "wb"));
+            if (!f || std::fwrite(out.data(), 1, out.size(), f.get()) != out.size() || std::fflush(f.get()) != 0) {
+                failed = true;
+                return false;
+            }
+#if defined(__unix__) || defined(__APPLE__)
+            if (options.sync) ::fsync(fileno(f.get()));
+#endif
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, snapshotPath(path), ec);
+        if (ec) {
+            failed = true;
+            return false;
+        }
+
+        // Truncate in place, so followers holding the file see the new header
+        log.reset(std::fopen(path.c_str(), "wb"));
+        if (!log || !writeHeader(log.get(), sequence)) {
+            failed = true;
+            return false;
+        }
+        logBytes = headerBytes;
+        return true;
+    }
+
+    /**
+     * @brief Returns the sequence number of the next record, i.e. the number
+     *        of mutations journaled since the journal was first created
+     */
+    std::uint64_t sequenceNumber() const {
+        return sequence;
+    }
+
+    /**
+     * @brief Returns the number of bytes buffered and not yet committed
+     */
+    std::size_t pendingBytes() const {
+        return buffer.size();
+    }
+
+    /**
+     * @brief Returns the committed size of the log file, header included
+     */
+    std::uint64_t logSize() const {
+        return logBytes;
+    }
+
+    /**
+     * @brief Returns true once a write has failed; later mutations are no longer journaled
+     */
+    bool hasFailed() const {
+        return failed;
+    }
+
+    void onAddVertex(const Vertex& v) override { append(Op::AddVertex, v); }
+    void onAddEdge(const Vertex& u, const Vertex& v) override { append(Op::AddEdge, u, v); }
+    void onRemoveEdge(const Vertex& u, const Vertex& v) override { append(Op::RemoveEdge, u, v); }
+    void onRemoveVertex(const Vertex& v) override { append(Op::RemoveVertex, v); }
+    void onClear() override { append(Op::Clear); }
+};
+
+/**
+ * @brief Keeps a replica graph up to date by tailing the files of a Journal
+ * @tparam Vertex Vertex type
+ * @tparam Hash Hash function (default: std::hash<Vertex>)
+ * @note poll() applies the records committed since the previous call. After
+ *       the writer compacts, the follower continues from the new log if it
+ *       had read every folded record, and reloads the snapshot otherwise
+ * @note Only committed records are seen; a record being written is left
+ *       for the next poll
+ */
+template<typename Vertex, typename Hash = std::hash<Vertex>>
+class JournalFollower {
+    using J = Journal<Vertex, Hash>;
+
+    std::string path;
+    std::uint64_t sequence = 0;  // Sequence number of the next record to apply
+    std::uint64_t base = 0;      // First sequence number of the log being read
+    std::uint64_t position = 0;  // File offset of record `sequence`, 0 before the first poll
+    std::uint64_t reloads = 0;
+    std::vector<std::uint8_t> data;
+
+    // Reads the log from `from` to its end; returns its first sequence number
+    std::optional<std::uint64_t> read(std::uint64_t from) {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> f(std::fopen(path.c_str(), "rb"), &std::fclose);
+        if (!f) return std::nullopt;
+        std::uint64_t header[2];
+        if (std::fread(header, 1, J::headerBytes, f.get()) != J::headerBytes || header[0] != J::logMagic) {
+            return std::nullopt;
+        }
+        data.clear();
+#ifdef _WIN32
+        if (_fseeki64(f.get(), static_cast<long long>(from), SEEK_SET) != 0) return std::nullopt;
+#else
+        if (fseeko(f.get(), static_cast<off_t>(from), SEEK_SET) != 0) return std::nullopt;
+#endif
+        std::uint8_t chunk[1 << 16];
+        std::size_t got;
+        while ((got = std::fread(chunk, 1, sizeof(chunk), f.get())) > 0) data.insert(data.end(), chunk, chunk + got);
+        return header[1];
+    }
+
+public:
+    /**
+     * @brief Creates a follower of the journal at path; nothing is read until poll()
+     */
+    explicit JournalFollower(std::string file) : path(std::move(file)) {}
+
+    /**
+     * @brief Applies to a replica every record committed since the last call
+     * @param replica The graph to update; the first call (and any reload)
+     *        clears it and loads the snapshot
+     * @return The number of records applied, or std::nullopt if the files
+     *         are missing or corrupted (including a record that passes its
+     *         checksum but does not decode), or if compact() was truncating the
+     *         log at that moment (polling again later succeeds)
+     * @note Complexity: O(new bytes), or O(n + m) when the snapshot is reloaded
+     */
+    std::optional<std::size_t> poll(Graph<Vertex, Hash>& replica) {
+        auto first = read(position > 0 ? position : J::headerBytes);
+        if (!first) return std::nullopt;
+
+        if (position == 0 || *first != base) {
+            // First poll, or the log was compacted since the last one
+            std::uint64_t skip;
+            if (position > 0 && *first <= sequence) {
+                skip = sequence - *first;
+            } else {
+                auto snap = J::loadSnapshot(path, replica);
+                if (!snap || *snap < *first) return std::nullopt;
+                reloads += position > 0;
+                sequence = *snap;
+                skip = *snap - *first;
+            }
+            base = *first;
+            if (!read(J::headerBytes)) return std::nullopt;
+            position = J::headerBytes + J::scanRecords(data.data(), data.data() + data.size(),
+                                                       [&](typename J::Op, const std::uint8_t*, const std::uint8_t*) {
+                if (skip == 0) return false;
+                skip--;
+                return true;
+            });
+            if (skip > 0) {
+                position = 0; // Folded records not all readable yet: start over next time
+                return std::size_t{0};
+            }
+            data.erase(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(position - J::headerBytes));
+        }
+
+        std::size_t applied = 0;
+        bool undecodable = false;
+        position += J::scanRecords(data.data(), data.data() + data.size(),
+                                   [&](typename J::Op op, const std::uint8_t* p, const std::uint8_t* end) {
+            if (!J::apply(replica, op, p, end)) {
+                undecodable = true;
+                return false;
+            }
+            applied++;
+            return true;
+        });
+        sequence += applied;
+        if (undecodable) return std::nullopt;
+        return applied;
+    }
+
+    /**
+     * @brief Returns the sequence number of the next record to apply
+     */
+    std::uint64_t sequenceNumber() const {
+        return sequence;
+    }
+
+    /**
+     * @brief Returns how many times the snapshot was reloaded because
+     *        compaction folded records the follower had not read yet
+     */
+    std::uint64_t snapshotReloads() const {
+        return reloads;
+    }
+};
+
+#endif
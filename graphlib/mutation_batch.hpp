@@ -0,0 +1,268 @@
+/**
+ * @file graphlib/mutation_batch.hpp
+ * @brief Buffered graph mutations applied in one grouped, locality-friendly pass
+ */
+
+#ifndef GRAPHLIB_MUTATION_BATCH_HPP
+#define GRAPHLIB_MUTATION_BATCH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../graphlib.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief Buffers addVertex/addEdge/removeEdge/removeVertex calls and applies them at once
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note Applying a batch leaves the graph exactly as if the operations had
+ *       been called one by one, in order
+ * @note Redundant operations cancel out before touching the graph: only the
+ *       last operation on each edge survives (add-then-remove does nothing
+ *       but create the endpoints), and edges of a vertex removed later in
+ *       the batch are never inserted
+ * @note The surviving edge updates are grouped by endpoint, so each
+ *       adjacency set is looked up once and then updated in a tight loop
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class MutationBatch {
+private:
+    using VertexParam = std::conditional_t<std::is_fundamental_v<Vertex>, Vertex, const Vertex&>;
+    using Lid = std::uint32_t; // Batch-local vertex id
+    using AdjSet = typename Graph<Vertex, Hash>::NeighborSet;
+
+    enum class Kind : std::uint8_t { AddVertex, AddEdge, RemoveEdge, RemoveVertex };
+
+    struct Op {
+        Lid u, v;
+        Kind kind;
+    };
+
+    // Operations are recorded on batch-local ids so that everything below
+    // works on integers; each vertex is hashed once per operation
+    std::unordered_map<Vertex, Lid, Hash> local;
+    std::vector<Vertex> verts;
+    std::vector<Op> ops;
+
+    Lid intern(const VertexParam v) {
+        auto [it, inserted] = local.try_emplace(v, static_cast<Lid>(verts.size()));
+        if (inserted) verts.push_back(v);
+        return it->second;
+    }
+
+    // Net effect of the buffered operations, in the order it must be applied
+    struct Plan {
+        std::vector<Lid> removedVertices;
+        std::vector<std::pair<Lid, Lid>> inserts;
+        std::vector<std::pair<Lid, Lid>> removals;
+        std::vector<Lid> createdVertices;
+    };
+
+    Plan reduce() const {
+        const std::size_t n = verts.size();
+        // Sequence numbers are stored +1 so that 0 means "never"
+        std::vector<std::size_t> lastRemove(n, 0), lastCreate(n, 0);
+
+        // key = (min id << 32) | max id, order = (sequence << 1) | isRemoval;
+        // two plain integers keep the sort below cheap
+        struct EdgeOp {
+            std::uint64_t key;
+            std::uint64_t order;
+        };
+        std::vector<EdgeOp> edgeOps;
+        edgeOps.reserve(ops.size());
+
+        for (std::size_t i = 0; i < ops.size(); i++) {
+            const Op& op = ops[i];
+            switch (op.kind) {
+                case Kind::AddVertex:
+                    lastCreate[op.u] = i + 1;
+                    break;
+                case Kind::RemoveVertex:
+                    lastRemove[op.u] = i + 1;
+                    break;
+                case Kind::AddEdge:
+                    lastCreate[op.u] = lastCreate[op.v] = i + 1;
+                    [[fallthrough]];
+                case Kind::RemoveEdge: {
+                    const Lid a = std::min(op.u, op.v), b = std::max(op.u, op.v);
+                    edgeOps.push_back({(std::uint64_t{a} << 32) | b, ((i + 1) << 1) | (op.kind == Kind::RemoveEdge)});
+                    break;
+                }
+            }
+        }
+
+        // Keep only the last operation on every edge
+        std::sort(edgeOps.begin(), edgeOps.end(), [](const EdgeOp& x, const EdgeOp& y) {
+            return x.key != y.key ? x.key < y.key : x.order < y.order;
+        });
+
+        Plan plan;
+        for (std::size_t i = 0; i < edgeOps.size(); i++) {
+            if (i + 1 < edgeOps.size() && edgeOps[i + 1].key == edgeOps[i].key) continue;
+            const Lid a = static_cast<Lid>(edgeOps[i].key >> 32);
+            const Lid b = static_cast<Lid>(edgeOps[i].key);
+            const std::size_t seq = edgeOps[i].order >> 1;
+            if (edgeOps[i].order & 1) {
+                plan.removals.emplace_back(a, b);
+            } else if (seq > lastRemove[a] && seq > lastRemove[b]) {
+                // An add followed by the removal of an endpoint is void
+                plan.inserts.emplace_back(a, b);
+            }
+        }
+
+        for (Lid x = 0; x < n; x++) {
+            if (lastRemove[x]) plan.removedVertices.push_back(x);
+            if (lastCreate[x] > lastRemove[x]) plan.createdVertices.push_back(x);
+        }
+        return plan;
+    }
+
+public:
+    MutationBatch() = default;
+
+    /**
+     * @brief Buffers the insertion of a vertex
+     */
+    void addVertex(const VertexParam v) {
+        ops.push_back({intern(v), 0, Kind::AddVertex});
+    }
+
+    /**
+     * @brief Buffers the insertion of an edge
+     * @note Self-loops (u == v) are silently ignored, like Graph::addEdge
+     */
+    void addEdge(const VertexParam u, const VertexParam v) {
+        if (u == v) return;
+        ops.push_back({intern(u), intern(v), Kind::AddEdge});
+    }
+
+    /**
+     * @brief Buffers the removal of an edge
+     */
+    void removeEdge(const VertexParam u, const VertexParam v) {
+        if (u == v) return;
+        ops.push_back({intern(u), intern(v), Kind::RemoveEdge});
+    }
+
+    /**
+     * @brief Buffers the removal of a vertex and its incident edges
+     */
+    void removeVertex(const VertexParam v) {
+        ops.push_back({intern(v), 0, Kind::RemoveVertex});
+    }
+
+    /**
+     * @brief Returns the number of buffered operations
+     */
+    std::size_t size() const {
+        return ops.size();
+    }
+
+    /**
+     * @brief Checks if no operation is buffered
+     */
+    bool empty() const {
+        return ops.empty();
+    }
+
+    /**
+     * @brief Discards every buffered operation
+     */
+    void clear() {
+        local.clear();
+        verts.clear();
+        ops.clear();
+    }
+
+    /**
+     * @brief Applies the buffered operations to a graph
+     * @param g The graph to modify
+     * @param threads Number of threads updating adjacency sets (0 for all
+     *        hardware threads); each set is updated by exactly one thread
+     * @note The batch is left untouched and can be applied again or cleared
+     * @note If observers are attached to g, or GRAPHLIB_STATS is defined, the
+     *       reduced operations are replayed through the public API so that
+     *       every observer is notified and every counter updated
+     * @note Complexity: O(k log k + sum of degrees of removed vertices)
+     *       where k is the number of buffered operations
+     */
+    void applyTo(Graph<Vertex, Hash>& g, std::size_t threads = 1) const {
+        const Plan plan = reduce();
+
+        if (g.observed() || Graph<Vertex, Hash>::statsEnabled) {
+            for (Lid x : plan.removedVertices) g.removeVertex(verts[x]);
+            for (const auto& [a, b] : plan.removals) g.removeEdge(verts[a], verts[b]);
+            for (const auto& [a, b] : plan.inserts) g.addEdge(verts[a], verts[b]);
+            for (Lid x : plan.createdVertices) g.addVertex(verts[x]);
+            return;
+        }
+
+        auto& adj = g.adj;
+        const std::size_t n = verts.size();
+        if (!plan.removedVertices.empty() || !plan.removals.empty() || !plan.inserts.empty()
+            || !plan.createdVertices.empty()) {
+            g.mutations++;
+        }
+
+        // Phase 1: vertex removals (the only structural erasures of adj)
+        for (Lid x : plan.removedVertices) {
+            auto it = adj.find(verts[x]);
+            if (it == adj.end()) continue;
+            for (const Vertex& neighbor : it->second) {
+                adj.find(neighbor)->second.erase(verts[x]);
+            }
+            adj.erase(it);
+        }
+
+        // Phase 2: one lookup per touched vertex; references to the sets stay
+        // valid from here on because adj is not modified structurally anymore
+        std::vector<AdjSet*> sets(n, nullptr);
+        for (Lid x : plan.createdVertices) sets[x] = &adj[verts[x]];
+        for (Lid x = 0; x < n; x++) {
+            if (sets[x]) continue;
+            auto it = adj.find(verts[x]);
+            if (it != adj.end()) sets[x] = &it->second;
+        }
+
+        // Phase 3: group half-edges by source vertex (counting sort)
+        std::vector<std::size_t> insertStart(n + 1, 0), removeStart(n + 1, 0);
+        for (const auto& [a, b] : plan.inserts) { insertStart[a + 1]++; insertStart[b + 1]++; }
+        for (const auto& [a, b] : plan.removals) { removeStart[a + 1]++; removeStart[b + 1]++; }
+        for (std::size_t x = 0; x < n; x++) {
+            insertStart[x + 1] += insertStart[x];
+            removeStart[x + 1] += removeStart[x];
+        }
+        std::vector<Lid> insertTargets(insertStart[n]), removeTargets(removeStart[n]);
+        {
+            std::vector<std::size_t> fillI(insertStart.begin(), insertStart.end() - 1);
+            std::vector<std::size_t> fillR(removeStart.begin(), removeStart.end() - 1);
+            for (const auto& [a, b] : plan.inserts) {
+                insertTargets[fillI[a]++] = b;
+                insertTargets[fillI[b]++] = a;
+            }
+            for (const auto& [a, b] : plan.removals) {
+                removeTargets[fillR[a]++] = b;
+                removeTargets[fillR[b]++] = a;
+            }
+        }
+
+        // Phase 4: update every adjacency set in one go
+        graphlib::parallelFor(n, threads, [&](std::size_t x, std::size_t) {
+            AdjSet* set = sets[x];
+            if (!set) return;
+            for (std::size_t p = removeStart[x]; p < removeStart[x + 1]; p++) {
+                set->erase(verts[removeTargets[p]]);
+            }
+            for (std::size_t p = insertStart[x]; p < insertStart[x + 1]; p++) {
+                set->insert(verts[insertTargets[p]]);
+            }
+        });
+    }
+};
+
+#endif
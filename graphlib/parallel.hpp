@@ -0,0 +1,168 @@
+/**
+ * @file graphlib/parallel.hpp
+ * @brief Minimal thread helpers used by the parallel graph algorithms
+ */
+
+#ifndef GRAPHLIB_PARALLEL_HPP
+#define GRAPHLIB_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graphlib {
+
+/**
+ * @brief Returns the number of hardware threads, never less than 1
+ */
+inline std::size_t hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * @brief Runs fn(i, worker) for every i in [0, n) on up to `threads` threads
+ * @param n Number of work items
+ * @param threads Number of threads (0 for hardwareThreads())
+ * @param fn Callable invoked as fn(size_t index, size_t workerId)
+ * @param grain Number of consecutive items a thread claims at once
+ * @note Items are claimed dynamically through a shared atomic counter, so
+ *       uneven items do not leave threads idle. workerId is in [0, threads)
+ *       and can index per-thread scratch space.
+ * @note With a single thread (or n <= grain) everything runs on the caller
+ */
+template<typename Fn>
+void parallelFor(std::size_t n, std::size_t threads, Fn&& fn, std::size_t grain = 64) {
+    if (threads == 0) threads = hardwareThreads();
+    if (grain == 0) grain = 1;
+    threads = std::min(threads, (n + grain - 1) / grain);
+
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < n; i++) fn(i, std::size_t{0});
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&](std::size_t id) {
+        for (;;) {
+            std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= n) break;
+            std::size_t end = std::min(n, begin + grain);
+            for (std::size_t i = begin; i < end; i++) fn(i, id);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+}
+
+/**
+ * @brief How forEachVertex()/forEachEdge() split a graph into parallel tasks
+ */
+struct ParallelPolicy {
+    std::size_t threads = 0;          ///< Number of threads, 0 for hardwareThreads(), 1 runs on the caller
+    std::size_t tasksPerThread = 64;  ///< Chunks created per thread; more chunks balance better but cost more scheduling
+    std::size_t splitDegree = 4096;   ///< forEachEdge splits neighbor lists longer than this across several tasks
+};
+
+/**
+ * @brief Runs fn(task, worker) for every task in [0, tasks) on a work-stealing pool
+ * @param tasks Number of tasks, below 2^32
+ * @param threads Number of threads (0 for hardwareThreads())
+ * @param fn Callable invoked as fn(size_t task, size_t workerId)
+ * @note Every thread starts with a contiguous block of tasks and runs them in
+ *       order; a thread that runs out steals the second half of the largest
+ *       remaining block it finds, so a few expensive tasks do not leave the
+ *       other threads idle and neighboring tasks tend to run on one thread
+ * @note Here i used Blumofe & Leiserson, "Scheduling Multithreaded Computations
+ *       by Work Stealing" (https://doi.org/10.1145/324133.324234) as a reference
+ */
+template<typename Fn>
+void parallelTasks(std::size_t tasks, std::size_t threads, Fn&& fn) {
+    if (threads == 0) threads = hardwareThreads();
+    threads = std::min(threads, tasks);
+    if (threads <= 1) {
+        for (std::size_t t = 0; t < tasks; t++) fn(t, std::size_t{0});
+        return;
+    }
+
+    // Block [head, tail) of one thread, packed in one word so that the owner
+    // and thieves update it with a single compare-exchange
+    struct alignas(64) Block {
+        std::atomic<std::uint64_t> range{0};
+    };
+    auto pack = [](std::uint64_t head, std::uint64_t tail) { return (tail << 32) | head; };
+    std::vector<Block> blocks(threads);
+    for (std::size_t t = 0; t < threads; t++) {
+        blocks[t].range.store(pack(tasks * t / threads, tasks * (t + 1) / threads), std::memory_order_relaxed);
+    }
+
+    auto worker = [&](std::size_t id) {
+        std::atomic<std::uint64_t>& own = blocks[id].range;
+        for (;;) {
+            // Run the own block from its head
+            std::uint64_t cur = own.load(std::memory_order_acquire);
+            while ((cur & 0xffffffffu) < (cur >> 32)) {
+                const std::uint64_t head = cur & 0xffffffffu;
+                if (own.compare_exchange_weak(cur, pack(head + 1, cur >> 32), std::memory_order_acq_rel)) {
+                    fn(static_cast<std::size_t>(head), id);
+                    cur = own.load(std::memory_order_acquire);
+                }
+            }
+
+            // Steal the upper half of the largest block left
+            std::size_t victim = threads;
+            std::uint64_t most = 0;
+            for (std::size_t k = 1; k < threads; k++) {
+                const std::size_t v = (id + k) % threads;
+                const std::uint64_t r = blocks[v].range.load(std::memory_order_acquire);
+                const std::uint64_t left = (r >> 32) > (r & 0xffffffffu) ? (r >> 32) - (r & 0xffffffffu) : 0;
+                if (left > most) {
+                    most = left;
+                    victim = v;
+                }
+            }
+            if (victim == threads) return; // Tasks never create tasks: nothing left anywhere
+
+            std::uint64_t r = blocks[victim].range.load(std::memory_order_acquire);
+            const std::uint64_t head = r & 0xffffffffu, tail = r >> 32;
+            if (head >= tail) continue;
+            const std::uint64_t mid = head + (tail - head) / 2; // A single task goes to the thief
+            if (blocks[victim].range.compare_exchange_strong(r, pack(head, mid), std::memory_order_acq_rel)) {
+                own.store(pack(mid, tail), std::memory_order_release);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+}
+
+namespace detail {
+
+// Calls fn(args..., worker) if fn accepts a worker id, fn(args...) otherwise
+template<typename Fn, typename... Args>
+void invokeWithWorker(Fn& fn, std::size_t worker, Args&&... args) {
+    if constexpr (std::is_invocable_v<Fn&, Args..., std::size_t>) {
+        fn(std::forward<Args>(args)..., worker);
+    } else {
+        fn(std::forward<Args>(args)...);
+    }
+}
+
+} // namespace detail
+
+} // namespace graphlib
+
+#endif
@@ -0,0 +1,596 @@
+/**
+ * @file graphlib/partition.hpp
+ * @brief k-way balanced partitioning of a CSRGraph, and extraction of the
+ *        parts as standalone graphs with their halo of ghost vertices
+ *
+ * A partition assigns every vertex id to one of k parts, each holding at
+ * most (1 + imbalance) * n / k vertices, while cutting as few edges as
+ * possible. Three algorithms are offered:
+ * - LDG and Fennel stream the vertices once and place each one in the part
+ *   that already holds most of its neighbors, penalized by the part size;
+ * - Multilevel coarsens the graph by heavy-edge matching, partitions the
+ *   coarsest graph by greedy growing, then projects the parts back level by
+ *   level, refining the boundary at each level (METIS scheme).
+ */
+
+#ifndef GRAPHLIB_PARTITION_HPP
+#define GRAPHLIB_PARTITION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr.hpp"
+#include "random.hpp"
+
+/// Part of a vertex, in [0, number of parts)
+using PartId = std::uint32_t;
+
+/// Algorithms for partitionGraph()
+enum class PartitionAlgorithm {
+    LDG,       ///< Streaming, linear deterministic greedy: neighbors in the part * (1 - size / capacity)
+    Fennel,    ///< Streaming, neighbors in the part minus a convex penalty on its size
+    Multilevel ///< Coarsening, initial partition and k-way refinement
+};
+
+/**
+ * @brief Parameters of partitionGraph()
+ */
+struct PartitionOptions {
+    std::size_t parts = 2;                                    ///< Number of parts k
+    double imbalance = 0.03;                                  ///< Parts hold at most ceil((1 + imbalance) * n / k) vertices
+    PartitionAlgorithm algorithm = PartitionAlgorithm::Multilevel;
+    std::uint64_t seed = 1;                                   ///< Seed of the random choices of Multilevel
+};
+
+/**
+ * @brief A vertex-to-part assignment, as returned by partitionGraph()
+ */
+struct Partition {
+    std::size_t parts = 0;           ///< Number of parts
+    std::vector<PartId> part;        ///< part[v] for every id v
+    std::vector<std::size_t> sizes;  ///< Vertices per part
+    std::size_t cutEdges = 0;        ///< Edges whose endpoints are in different parts
+    std::size_t edges = 0;           ///< Edges of the graph
+
+    /// Fraction of the edges that are cut
+    double cutRatio() const {
+        return edges == 0 ? 0.0 : static_cast<double>(cutEdges) / static_cast<double>(edges);
+    }
+
+    /// Largest part divided by the average part size: 1 is perfect balance
+    double balance() const {
+        if (part.empty()) return 1.0;
+        const double average = static_cast<double>(part.size()) / static_cast<double>(parts);
+        return static_cast<double>(*std::max_element(sizes.begin(), sizes.end())) / average;
+    }
+};
+
+/**
+ * @brief One part extracted by extractParts()
+ * @tparam Vertex Vertex type
+ * @tparam Hash function
+ */
+template<typename Vertex, typename Hash>
+struct PartSubgraph {
+    Graph<Vertex, Hash> graph;   ///< Owned and ghost vertices, with every edge that has an owned endpoint
+    std::vector<Vertex> owned;   ///< Vertices assigned to this part
+    std::vector<Vertex> ghosts;  ///< Halo: vertices of other parts adjacent to an owned vertex
+    std::vector<PartId> ghostParts; ///< ghostParts[i] is the part owning ghosts[i]
+};
+
+namespace graphlib::detail {
+
+// Graph with vertex and edge weights, the working representation of the
+// multilevel scheme; the input graph is its first level, with unit weights
+struct WeightedGraph {
+    std::vector<std::size_t> offsets{0};
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint64_t> edgeWeights;
+    std::vector<std::uint64_t> vertexWeights;
+
+    std::size_t size() const {
+        return vertexWeights.size();
+    }
+};
+
+// State of a k-way partition of a WeightedGraph, with the scratch space
+// used to count the connectivity of a vertex to every part
+struct PartitionState {
+    std::vector<PartId> part;
+    std::vector<std::uint64_t> weight; // Per part
+    std::uint64_t capacity = 0;
+    std::vector<std::uint64_t> conn;   // Per part, reset after each use
+    std::vector<PartId> touched;
+
+    // Fills conn with the edge weight from v to every part it touches
+    void connect(const WeightedGraph& g, std::uint32_t v) {
+        for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) {
+            const PartId p = part[g.targets[s]];
+            if (conn[p] == 0) touched.push_back(p);
+            conn[p] += g.edgeWeights[s];
+        }
+    }
+
+    void release() {
+        for (PartId p : touched) conn[p] = 0;
+        touched.clear();
+    }
+
+    void move(const WeightedGraph& g, std::uint32_t v, PartId to) {
+        weight[part[v]] -= g.vertexWeights[v];
+        weight[to] += g.vertexWeights[v];
+        part[v] = to;
+    }
+
+    std::uint64_t cut(const WeightedGraph& g) const {
+        std::uint64_t res = 0;
+        for (std::uint32_t v = 0; v < g.size(); v++) {
+            for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) {
+                if (part[g.targets[s]] != part[v]) res += g.edgeWeights[s];
+            }
+        }
+        return res / 2;
+    }
+
+    std::uint64_t overweight() const {
+        std::uint64_t res = 0;
+        for (std::uint64_t w : weight) res += w > capacity ? w - capacity : 0;
+        return res;
+    }
+};
+
+inline std::vector<std::uint32_t> shuffledIds(std::size_t n, Xoshiro256& rng) {
+    std::vector<std::uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    for (std::size_t i = n; i > 1; i--) std::swap(order[i - 1], order[boundedRandom(rng, i)]);
+    return order;
+}
+
+// Heavy-edge matching: each unmatched vertex, in random order, is merged with
+// the unmatched neighbor of similar strength that maximizes w(e)^2 / w(neighbor).
+// Returns the coarse graph and the coarse id of every vertex
+inline std::pair<WeightedGraph, std::vector<std::uint32_t>> coarsen(const WeightedGraph& g, std::uint64_t maxVertexWeight,
+                                                                    Xoshiro256& rng) {
+    constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+    const std::size_t n = g.size();
+    std::vector<std::uint32_t> match(n, none);
+    std::vector<std::uint64_t> strength(n, 0); // Weighted degree
+    for (std::uint32_t v = 0; v < n; v++) {
+        for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) strength[v] += g.edgeWeights[s];
+    }
+    const std::vector<std::uint32_t> order = shuffledIds(n, rng);
+    for (std::uint32_t v : order) {
+        if (match[v] != none) continue;
+        std::uint32_t best = v;
+        double bestRating = 0;
+        for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) {
+            const std::uint32_t w = g.targets[s];
+            if (match[w] != none || g.vertexWeights[v] + g.vertexWeights[w] > maxVertexWeight) continue;
+            // A hub absorbing one of its leaves wastes part capacity: only
+            // vertices of similar strength merge, leaves wait for two-hop matching
+            if (std::max(strength[v], strength[w]) > 2 * std::min(strength[v], strength[w])) continue;
+            const auto ew = static_cast<double>(g.edgeWeights[s]);
+            const double rating = ew * ew / static_cast<double>(g.vertexWeights[w]);
+            if (rating > bestRating) {
+                best = w;
+                bestRating = rating;
+            }
+        }
+        match[v] = best;
+        match[best] = v;
+    }
+
+    // Two-hop matching: vertices left alone, typically the leaves of a hub in
+    // a power-law graph, pair up when they share their heaviest neighbor;
+    // isolated vertices pair up with each other
+    std::vector<std::uint32_t> waiting(n + 1, none); // Lone vertex waiting on a neighbor, n for isolated ones
+    for (std::uint32_t v : order) {
+        if (match[v] != v) continue;
+        std::uint32_t key = static_cast<std::uint32_t>(n);
+        std::uint64_t keyWeight = 0;
+        for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) {
+            if (g.edgeWeights[s] > keyWeight) {
+                key = g.targets[s];
+                keyWeight = g.edgeWeights[s];
+            }
+        }
+        const std::uint32_t u = waiting[key];
+        if (u != none && g.vertexWeights[u] + g.vertexWeights[v] <= maxVertexWeight) {
+            match[u] = v;
+            match[v] = u;
+            waiting[key] = none;
+        } else {
+            waiting[key] = v;
+        }
+    }
+
+    std::vector<std::uint32_t> coarseId(n), members; // members: the smaller id of each pair
+    for (std::uint32_t v = 0; v < n; v++) {
+        if (v <= match[v]) {
+            coarseId[v] = coarseId[match[v]] = static_cast<std::uint32_t>(members.size());
+            members.push_back(v);
+        }
+    }
+
+    WeightedGraph coarse;
+    coarse.vertexWeights.resize(members.size());
+    coarse.offsets.reserve(members.size() + 1);
+    constexpr std::size_t noSlot = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> slotOf(members.size(), noSlot); // Slot of a coarse neighbor in the current list
+    for (std::uint32_t c = 0; c < members.size(); c++) {
+        const std::size_t begin = coarse.targets.size();
+        const std::uint32_t pair[2] = {members[c], match[members[c]]};
+        for (std::size_t k = 0; k < (pair[0] == pair[1] ? 1u : 2u); k++) {
+            const std::uint32_t v = pair[k];
+            coarse.vertexWeights[c] += g.vertexWeights[v];
+            for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) {
+                const std::uint32_t d = coarseId[g.targets[s]];
+                if (d == c) continue;
+                if (slotOf[d] == noSlot || slotOf[d] < begin) {
+                    slotOf[d] = coarse.targets.size();
+                    coarse.targets.push_back(d);
+                    coarse.edgeWeights.push_back(g.edgeWeights[s]);
+                } else {
+                    coarse.edgeWeights[slotOf[d]] += g.edgeWeights[s];
+                }
+            }
+        }
+        coarse.offsets.push_back(coarse.targets.size());
+    }
+    return {std::move(coarse), std::move(coarseId)};
+}
+
+// Greedy graph growing: parts 0..k-2 grow one at a time from a random seed,
+// always absorbing the frontier vertex most connected to them, until they
+// reach their share of the weight; part k-1 takes what is left
+inline void growParts(const WeightedGraph& g, PartitionState& st, std::size_t k, Xoshiro256& rng) {
+    constexpr PartId none = static_cast<PartId>(-1);
+    const std::size_t n = g.size();
+    std::fill(st.part.begin(), st.part.end(), none);
+    std::fill(st.weight.begin(), st.weight.end(), 0);
+    const std::uint64_t total = std::accumulate(g.vertexWeights.begin(), g.vertexWeights.end(), std::uint64_t{0});
+    const std::vector<std::uint32_t> seeds = shuffledIds(n, rng);
+    std::vector<std::uint64_t> gain(n, 0);
+    std::size_t nextSeed = 0;
+    std::uint64_t assigned = 0;
+
+    for (PartId p = 0; p + 1 < k; p++) {
+        const std::uint64_t target = (total - assigned) / (k - p);
+        std::priority_queue<std::pair<std::uint64_t, std::uint32_t>> frontier;
+        while (st.weight[p] < target) {
+            if (frontier.empty()) {
+                // Each vertex seeds at most once, so the loop ends even when nothing fits
+                while (nextSeed < n && st.part[seeds[nextSeed]] != none) nextSeed++;
+                if (nextSeed == n) break;
+                const std::uint32_t s = seeds[nextSeed++];
+                frontier.emplace(gain[s], s);
+            }
+            const auto [g0, v] = frontier.top();
+            frontier.pop();
+            if (st.part[v] != none || g0 != gain[v]) continue; // Outdated entry
+            if (st.weight[p] + g.vertexWeights[v] > st.capacity) continue;
+            st.part[v] = p;
+            st.weight[p] += g.vertexWeights[v];
+            for (std::size_t s = g.offsets[v]; s < g.offsets[v + 1]; s++) {
+                const std::uint32_t w = g.targets[s];
+                if (st.part[w] != none) continue;
+                gain[w] += g.edgeWeights[s];
+                frontier.emplace(gain[w], w);
+            }
+        }
+        assigned += st.weight[p];
+        // Gains only count edges into the part just finished
+        std::fill(gain.begin(), gain.end(), 0);
+    }
+    const PartId last = static_cast<PartId>(k - 1);
+    for (std::uint32_t v = 0; v < n; v++) {
+        if (st.part[v] == none) {
+            st.part[v] = last;
+            st.weight[last] += g.vertexWeights[v];
+        }
+    }
+}
+
+// Moves vertices out of parts above capacity, preferring the moves that cut
+// the fewest additional edges
+inline void rebalance(const WeightedGraph& g, PartitionState& st) {
+    const std::size_t k = st.weight.size();
+    std::vector<std::pair<std::int64_t, std::uint32_t>> candidates; // (loss, vertex)
+    for (PartId p = 0; p < k; p++) {
+        if (st.weight[p] <= st.capacity) continue;
+        candidates.clear();
+        for (std::uint32_t v = 0; v < g.size(); v++) {
+            if (st.part[v] != p) continue;
+            st.connect(g, v);
+            std::uint64_t best = 0;
+            for (PartId q : st.touched) {
+                if (q != p) best = std::max(best, st.conn[q]);
+            }
+            candidates.emplace_back(static_cast<std::int64_t>(st.conn[p]) - static_cast<std::int64_t>(best), v);
+            st.release();
+        }
+        std::sort(candidates.begin(), candidates.end());
+        for (const auto& [loss, v] : candidates) {
+            if (st.weight[p] <= st.capacity) break;
+            // Best neighboring part with room, else the lightest part
+            st.connect(g, v);
+            PartId to = p;
+            std::uint64_t toConn = 0;
+            for (PartId q : st.touched) {
+                if (q != p && st.weight[q] + g.vertexWeights[v] <= st.capacity && (to == p || st.conn[q] > toConn)) {
+                    to = q;
+                    toConn = st.conn[q];
+                }
+            }
+            st.release();
+            if (to == p) {
+                for (PartId q = 0; q < k; q++) {
+                    if (q != p && (to == p || st.weight[q] < st.weight[to])) to = q;
+                }
+                if (st.weight[to] + g.vertexWeights[v] > st.capacity) continue;
+            }
+            st.move(g, v, to);
+        }
+    }
+}
+
+// Greedy k-way refinement: boundary vertices, in random order, move to the
+// neighboring part that reduces the cut most, or that keeps the cut and
+// improves balance, as long as it has room
+inline void refine(const WeightedGraph& g, PartitionState& st, Xoshiro256& rng, std::size_t passes = 8) {
+    const std::vector<std::uint32_t> order = shuffledIds(g.size(), rng);
+    for (std::size_t pass = 0; pass < passes; pass++) {
+        std::size_t moved = 0;
+        for (std::uint32_t v : order) {
+            const PartId own = st.part[v];
+            st.connect(g, v);
+            if (st.touched.size() == 1 && st.touched[0] == own) {
+                st.release();
+                continue; // Interior vertex
+            }
+            const auto internal = static_cast<std::int64_t>(st.conn[own]);
+            const std::uint64_t w = g.vertexWeights[v];
+            PartId best = own;
+            std::int64_t bestGain = 0;
+            for (PartId q : st.touched) {
+                if (q == own || st.weight[q] + w > st.capacity) continue;
+                const std::int64_t gain = static_cast<std::int64_t>(st.conn[q]) - internal;
+                const bool balances = st.weight[q] + w < st.weight[own];
+                if (gain > bestGain || (gain == bestGain && balances
+                                        && (best == own || st.weight[q] < st.weight[best]))) {
+                    best = q;
+                    bestGain = gain;
+                }
+            }
+            st.release();
+            if (best != own) {
+                st.move(g, v, best);
+                moved++;
+            }
+        }
+        if (moved == 0) break;
+    }
+}
+
+// Streaming LDG / Fennel over the ids in order
+template<typename Vertex, typename Hash>
+void streamPartition(const CSRGraph<Vertex, Hash>& g, std::size_t k, std::size_t capacity, bool fennel,
+                     std::vector<PartId>& part, std::vector<std::size_t>& sizes) {
+    constexpr PartId none = static_cast<PartId>(-1);
+    const std::size_t n = g.countVertices();
+    std::fill(part.begin(), part.end(), none);
+    // Fennel: alpha = sqrt(k) * m / n^1.5 and gamma = 1.5, the values of the paper
+    const double alpha = std::sqrt(static_cast<double>(k)) * static_cast<double>(g.countEdges())
+                         / std::pow(static_cast<double>(std::max<std::size_t>(n, 1)), 1.5);
+    std::vector<std::size_t> count(k, 0);
+    std::vector<PartId> touched;
+    for (std::uint32_t v = 0; v < n; v++) {
+        for (auto w : g.neighbors(v)) {
+            const PartId p = part[w];
+            if (p == none) continue;
+            if (count[p] == 0) touched.push_back(p);
+            count[p]++;
+        }
+        PartId best = none;
+        double bestScore = 0;
+        for (PartId p = 0; p < k; p++) {
+            if (sizes[p] >= capacity) continue;
+            const auto size = static_cast<double>(sizes[p]);
+            const double score = fennel ? static_cast<double>(count[p]) - alpha * 1.5 * std::sqrt(size)
+                                        : static_cast<double>(count[p]) * (1.0 - size / static_cast<double>(capacity));
+            if (best == none || score > bestScore || (score == bestScore && sizes[p] < sizes[best])) {
+                best = p;
+                bestScore = score;
+            }
+        }
+        part[v] = best;
+        sizes[best]++;
+        for (PartId p : touched) count[p] = 0;
+        touched.clear();
+    }
+}
+
+template<typename Vertex, typename Hash>
+void multilevelPartition(const CSRGraph<Vertex, Hash>& g, std::size_t k, std::size_t capacity, std::uint64_t seed,
+                         std::vector<PartId>& part) {
+    const std::size_t n = g.countVertices();
+    Xoshiro256 rng(seed);
+
+    WeightedGraph fine;
+    fine.offsets.reserve(n + 1);
+    for (std::uint32_t v = 0; v < n; v++) {
+        fine.targets.insert(fine.targets.end(), g.neighbors(v).begin(), g.neighbors(v).end());
+        fine.offsets.push_back(fine.targets.size());
+    }
+    fine.edgeWeights.assign(fine.targets.size(), 1);
+    fine.vertexWeights.assign(n, 1);
+    std::vector<WeightedGraph> levels;
+    levels.push_back(std::move(fine));
+
+    // Coarsen until the graph is small, or until matching stops shrinking it
+    // (stars in power-law graphs leave most leaves unmatched)
+    const std::size_t coarsestSize = std::max<std::size_t>(20 * k, 200);
+    const std::uint64_t maxVertexWeight = std::max<std::uint64_t>(1, (3 * n) / (2 * coarsestSize));
+    std::vector<std::vector<std::uint32_t>> maps;
+    while (levels.back().size() > coarsestSize) {
+        auto [coarse, map] = coarsen(levels.back(), maxVertexWeight, rng);
+        if (coarse.size() * 20 > levels.back().size() * 19) break;
+        levels.push_back(std::move(coarse));
+        maps.push_back(std::move(map));
+    }
+
+    // Initial partition: best of a few refined greedy growings
+    const WeightedGraph& coarsest = levels.back();
+    PartitionState st;
+    // Coarse levels may overshoot by their heaviest vertex, otherwise heavy
+    // vertices could never move; the finest level has unit weights
+    auto slackCapacity = [&](const WeightedGraph& level) {
+        return capacity + *std::max_element(level.vertexWeights.begin(), level.vertexWeights.end()) - 1;
+    };
+    st.capacity = slackCapacity(coarsest);
+    st.conn.assign(k, 0);
+    st.weight.assign(k, 0);
+    st.part.assign(coarsest.size(), 0);
+    std::vector<PartId> bestPart;
+    std::pair<std::uint64_t, std::uint64_t> bestScore{std::uint64_t(-1), std::uint64_t(-1)}; // (overweight, cut)
+    for (int attempt = 0; attempt < 4; attempt++) {
+        growParts(coarsest, st, k, rng);
+        rebalance(coarsest, st);
+        refine(coarsest, st, rng);
+        const std::pair<std::uint64_t, std::uint64_t> score{st.overweight(), st.cut(coarsest)};
+        if (score < bestScore) {
+            bestScore = score;
+            bestPart = st.part;
+        }
+    }
+    st.part = std::move(bestPart);
+    std::fill(st.weight.begin(), st.weight.end(), 0);
+    for (std::uint32_t v = 0; v < coarsest.size(); v++) st.weight[st.part[v]] += coarsest.vertexWeights[v];
+
+    // Project back and refine at every level
+    for (std::size_t level = levels.size() - 1; level > 0; level--) {
+        const std::vector<std::uint32_t>& map = maps[level - 1];
+        std::vector<PartId> finer(map.size());
+        for (std::size_t v = 0; v < map.size(); v++) finer[v] = st.part[map[v]];
+        st.part = std::move(finer);
+        levels.pop_back();
+        st.capacity = slackCapacity(levels[level - 1]);
+        rebalance(levels[level - 1], st);
+        refine(levels[level - 1], st, rng);
+    }
+    part = std::move(st.part);
+}
+
+} // namespace graphlib::detail
+
+/**
+ * @brief Counts the edges whose endpoints are in different parts
+ * @param g The graph
+ * @param part part[v] for every id v
+ * @note Complexity: O(n + m)
+ */
+template<typename Vertex, typename Hash>
+std::size_t edgeCut(const CSRGraph<Vertex, Hash>& g, std::span<const PartId> part) {
+    std::size_t cut = 0;
+    for (std::uint32_t v = 0; v < g.countVertices(); v++) {
+        for (auto w : g.neighbors(v)) cut += (v < w && part[v] != part[w]);
+    }
+    return cut;
+}
+
+/**
+ * @brief Splits the vertices into balanced parts, cutting few edges
+ * @param g The graph
+ * @param opts Number of parts, allowed imbalance, algorithm and seed
+ * @return The part of every id, with part sizes and cut
+ * @note Every part holds at most ceil((1 + imbalance) * n / parts) vertices.
+ *       parts == 0 is treated as 1
+ * @note LDG and Fennel read the ids in order, in one pass: feeding them a
+ *       graph whose ids follow a traversal order gives smaller cuts
+ * @note Multilevel is slower but gives much smaller cuts; its result only
+ *       depends on the seed
+ * @note Here i used Stanton & Kliot, "Streaming Graph Partitioning for Large
+ *       Distributed Graphs" (https://doi.org/10.1145/2339530.2339722), Tsourakakis
+ *       et al., "FENNEL: Streaming Graph Partitioning for Massive Scale Graphs"
+ *       (https://doi.org/10.1145/2556195.2556213) and Karypis & Kumar, "A Fast and
+ *       High Quality Multilevel Scheme for Partitioning Irregular Graphs"
+ *       (https://doi.org/10.1137/S1064827595287997) as references, and LaSalle et al.,
+ *       "Improving Graph Partitioning for Modern Graphs and Architectures" (IA3 2015)
+ *       for the two-hop matching of power-law graphs
+ * @note Complexity: O(n * k + m) for LDG and Fennel; O((n + m) * passes)
+ *       per level for Multilevel
+ */
+template<typename Vertex, typename Hash>
+Partition partitionGraph(const CSRGraph<Vertex, Hash>& g, const PartitionOptions& opts = {}) {
+    const std::size_t n = g.countVertices();
+    Partition res;
+    res.parts = std::max<std::size_t>(opts.parts, 1);
+    res.part.assign(n, 0);
+    res.sizes.assign(res.parts, 0);
+    res.edges = g.countEdges();
+    const auto capacity = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::ceil((1.0 + std::max(opts.imbalance, 0.0)) * static_cast<double>(n)
+                                              / static_cast<double>(res.parts))));
+
+    if (res.parts == 1 || n == 0) {
+        res.sizes[0] = n;
+        return res;
+    }
+    if (opts.algorithm == PartitionAlgorithm::Multilevel) {
+        graphlib::detail::multilevelPartition(g, res.parts, capacity, opts.seed, res.part);
+        for (PartId p : res.part) res.sizes[p]++;
+    } else {
+        graphlib::detail::streamPartition(g, res.parts, capacity, opts.algorithm == PartitionAlgorithm::Fennel,
+                                          res.part, res.sizes);
+    }
+    res.cutEdges = edgeCut(g, std::span<const PartId>(res.part));
+    return res;
+}
+
+/**
+ * @brief Builds one graph per part, with the ghost vertices of its halo
+ * @param g The graph
+ * @param p A partition of g, e.g. from partitionGraph()
+ * @return One PartSubgraph per part. Its graph has every owned vertex, every
+ *         edge between owned vertices, and every cut edge leading from an
+ *         owned vertex to a ghost; edges between two ghosts are left out
+ * @note A worker owning a part can run local traversals on its graph and
+ *       knows, through ghostParts, which worker to ask about each ghost
+ * @note Complexity: O(n + m) expected
+ */
+template<typename Vertex, typename Hash>
+std::vector<PartSubgraph<Vertex, Hash>> extractParts(const CSRGraph<Vertex, Hash>& g, const Partition& p) {
+    std::vector<PartSubgraph<Vertex, Hash>> res(p.parts);
+    const std::size_t n = std::min(g.countVertices(), p.part.size());
+    for (std::uint32_t v = 0; v < n; v++) {
+        auto& sub = res[p.part[v]];
+        sub.owned.push_back(g.vertex(v));
+        sub.graph.addVertex(g.vertex(v));
+    }
+    for (std::uint32_t v = 0; v < n; v++) {
+        const PartId own = p.part[v];
+        auto& sub = res[own];
+        for (auto w : g.neighbors(v)) {
+            if (w >= n) continue;
+            if (p.part[w] == own) {
+                if (v < w) sub.graph.addEdge(g.vertex(v), g.vertex(w));
+                continue;
+            }
+            if (!sub.graph.containsVertex(g.vertex(w))) {
+                sub.ghosts.push_back(g.vertex(w));
+                sub.ghostParts.push_back(p.part[w]);
+            }
+            sub.graph.addEdge(g.vertex(v), g.vertex(w));
+        }
+    }
+    return res;
+}
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file graphlib/properties.hpp
+ * @brief Typed vertex and edge property columns for CSRGraph
+ *
+ * A column is one contiguous array per property, aligned with the layout
+ * of a CSRGraph: vertex values are indexed by dense vertex id, edge values
+ * by neighbor slot. Traversals read the property of the edge they are
+ * following at the same position as its target, with no hashing and no
+ * per-entry allocation, unlike side tables keyed by std::pair.
+ */
+
+#ifndef GRAPHLIB_PROPERTIES_HPP
+#define GRAPHLIB_PROPERTIES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief One value of type T per vertex of a CSRGraph, indexed by dense id
+ * @tparam T Property type
+ * @note T = bool is rejected because std::vector<bool> is not contiguous;
+ *       use char or std::uint8_t flags instead
+ */
+template<typename T>
+class VertexColumn {
+    static_assert(!std::is_same_v<T, bool>, "Use char or std::uint8_t for flags");
+
+    std::vector<T> values;
+
+public:
+    VertexColumn() = default;
+
+    /**
+     * @brief Creates a column for every vertex of a graph
+     * @param g The graph; only its number of vertices is used
+     * @param init Initial value of every vertex
+     * @note Complexity: O(n)
+     */
+    template<typename Vertex, typename Hash>
+    explicit VertexColumn(const CSRGraph<Vertex, Hash>& g, const T& init = T{})
+        : values(g.countVertices(), init) {}
+
+    /**
+     * @brief Returns the value of a vertex
+     * @param i A valid id
+     * @note Complexity: O(1)
+     */
+    T& operator[](std::uint32_t i) { return values[i]; }
+    const T& operator[](std::uint32_t i) const { return values[i]; }
+
+    /**
+     * @brief Returns the number of values, equal to countVertices() of the graph
+     */
+    std::size_t size() const {
+        return values.size();
+    }
+
+    /**
+     * @brief Returns every value, in id order
+     */
+    std::span<T> data() { return values; }
+    std::span<const T> data() const { return values; }
+};
+
+/**
+ * @brief One value of type T per undirected edge of a CSRGraph, stored per neighbor slot
+ * @tparam T Property type
+ * @tparam Vertex Vertex type of the graph
+ * @tparam Hash Hash function of the graph
+ * @note Each undirected edge has two slots, one in each endpoint's list;
+ *       the setters write both, so both directions always read the same value
+ * @note Keeps a pointer to the graph, which must outlive the column
+ * @note T = bool is rejected because std::vector<bool> is not contiguous
+ */
+template<typename T, typename Vertex, typename Hash = std::hash<Vertex>>
+class EdgeColumn {
+    static_assert(!std::is_same_v<T, bool>, "Use char or std::uint8_t for flags");
+
+public:
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+
+private:
+    const CSRGraph<Vertex, Hash>* graph = nullptr;
+    std::vector<T> values;
+
+public:
+    EdgeColumn() = default;
+
+    /**
+     * @brief Creates a column for every edge of a graph
+     * @param g The graph, must outlive the column
+     * @param init Initial value of every edge
+     * @note Complexity: O(m)
+     */
+    explicit EdgeColumn(const CSRGraph<Vertex, Hash>& g, const T& init = T{})
+        : graph(&g), values(2 * g.countEdges(), init) {}
+
+    /**
+     * @brief Returns the value stored in a slot
+     * @param slot A slot in [0, 2 * countEdges()); slot g.offset(u) + k is
+     *        the edge to g.neighbors(u)[k]
+     * @note Writing through a slot only changes that direction; use set()
+     *       to keep both directions in sync
+     * @note Complexity: O(1)
+     */
+    T& operator[](std::size_t slot) { return values[slot]; }
+    const T& operator[](std::size_t slot) const { return values[slot]; }
+
+    /**
+     * @brief Returns the values of the edges of a vertex, aligned with g.neighbors(u)
+     * @param u A valid id
+     * @note Complexity: O(1)
+     */
+    std::span<T> of(Id u) {
+        return {values.data() + graph->offset(u), values.data() + graph->offset(u + 1)};
+    }
+
+    std::span<const T> of(Id u) const {
+        return {values.data() + graph->offset(u), values.data() + graph->offset(u + 1)};
+    }
+
+    /**
+     * @brief Returns the slot of the edge u -> v in the list of u
+     * @return The slot, or std::nullopt if there is no such edge
+     * @note Complexity: O(log d) binary search in the sorted list of u
+     */
+    std::optional<std::size_t> slot(Id u, Id v) const {
+        auto nbrs = graph->neighbors(u);
+        auto it = std::lower_bound(nbrs.begin(), nbrs.end(), v);
+        if (it == nbrs.end() || *it != v) return std::nullopt;
+        return graph->offset(u) + static_cast<std::size_t>(it - nbrs.begin());
+    }
+
+    /**
+     * @brief Returns the value of the edge {u, v}
+     * @return The value, or std::nullopt if there is no such edge
+     * @note Complexity: O(log d)
+     */
+    std::optional<T> get(Id u, Id v) const {
+        auto s = slot(u, v);
+        if (!s) return std::nullopt;
+        return values[*s];
+    }
+
+    /**
+     * @brief Sets the value of the edge {u, v}, in both of its slots
+     * @return true if the edge exists, false otherwise (nothing is written)
+     * @note Complexity: O(log d_u + log d_v)
+     */
+    bool set(Id u, Id v, const T& value) {
+        auto forward = slot(u, v);
+        if (!forward) return false;
+        values[*forward] = value;
+        values[*slot(v, u)] = value;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of slots, twice the number of edges
+     */
+    std::size_t size() const {
+        return values.size();
+    }
+};
+
+template<typename Vertex, typename Hash, typename T>
+EdgeColumn(const CSRGraph<Vertex, Hash>&, const T&) -> EdgeColumn<T, Vertex, Hash>;
+
+#endif
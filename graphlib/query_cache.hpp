@@ -0,0 +1,294 @@
+/**
+ * @file graphlib/query_cache.hpp
+ * @brief Memory-bounded cache of distance() and bfs() results, invalidated by
+ *        the graph version
+ *
+ * Every cached result records the Graph::version() it was computed at. A
+ * lookup only hits when that version is still current, so a modification
+ * of the graph invalidates every result at once without touching the
+ * cache; stale entries are the first ones evicted. Entries are spread over
+ * shards, each with its own reader-writer lock and CLOCK eviction, so
+ * concurrent readers rarely wait on each other.
+ */
+
+#ifndef GRAPHLIB_QUERY_CACHE_HPP
+#define GRAPHLIB_QUERY_CACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../graphlib.hpp"
+
+/**
+ * @brief Construction parameters of a QueryCache
+ */
+struct QueryCacheOptions {
+    std::size_t maxBytes = std::size_t{64} << 20; ///< Budget for cached entries, split evenly over the shards
+    std::size_t shards = 16;                      ///< Independently locked partitions of the cache
+};
+
+/**
+ * @brief Counters of a QueryCache, as returned by QueryCache::stats()
+ */
+struct QueryCacheStats {
+    std::size_t hits = 0;        ///< Lookups answered from the cache
+    std::size_t misses = 0;      ///< Lookups computed on the graph, stale entries included
+    std::size_t stale = 0;       ///< Misses on an entry computed at an older version
+    std::size_t evictions = 0;   ///< Entries dropped to stay within the budget
+    std::size_t entries = 0;     ///< Entries currently stored, stale ones included
+    std::size_t bytes = 0;       ///< Estimated bytes of the stored entries
+
+    double hitRate() const {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+/**
+ * @brief Caches the results of distance() and bfs() on one graph
+ * @tparam G Graph type: Graph or DenseGraph, anything with version(),
+ *         distance() and bfs()
+ * @note Any number of threads may query concurrently. Modifying the graph
+ *       must not overlap with queries, as for Graph itself; results cached
+ *       before a modification are never returned after it
+ * @note The budget counts entries, index nodes and bfs vectors, but not heap
+ *       memory owned by the vertices themselves (e.g. long std::string)
+ * @note Here i used Corbató, "A Paging Experiment with the Multics System"
+ *       (CLOCK replacement, https://dspace.mit.edu/handle/1721.1/149298) as a reference
+ */
+template<typename G>
+class QueryCache {
+public:
+    using Vertex = typename G::NeighborSet::key_type;
+
+    /// A cached BFS order, shared by every caller that gets it
+    using Order = std::shared_ptr<const std::vector<Vertex>>;
+
+private:
+    using Hash = typename G::NeighborSet::hasher;
+    using VertexEqual = typename G::NeighborSet::key_equal;
+
+    enum class Kind : std::uint8_t { Distance, Bfs };
+
+    struct Key {
+        Kind kind;
+        Vertex a;
+        Vertex b;          // Target of distance(), source again for bfs()
+        std::size_t limit; // maxv of bfs(), 0 for distance()
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = graphlib::hashMix(static_cast<std::uint64_t>(Hash{}(k.a)) + static_cast<std::uint64_t>(k.kind));
+            h = graphlib::hashMix(h + static_cast<std::uint64_t>(Hash{}(k.b)));
+            return static_cast<std::size_t>(graphlib::hashMix(h + k.limit));
+        }
+    };
+
+    struct KeyEqual {
+        bool operator()(const Key& x, const Key& y) const {
+            return x.kind == y.kind && x.limit == y.limit && VertexEqual{}(x.a, y.a) && VertexEqual{}(x.b, y.b);
+        }
+    };
+
+    struct Entry {
+        std::optional<Key> key; // Empty for a free slot
+        std::uint64_t version = 0;
+        std::optional<int> distance;
+        Order order;
+        std::size_t bytes = 0;
+        std::atomic<bool> referenced{false}; // CLOCK bit, set by readers under the shared lock
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex lock;
+        std::unordered_map<Key, std::size_t, KeyHash, KeyEqual> index; // Key -> slot
+        std::deque<Entry> slots; // A deque never moves its elements
+        std::vector<std::size_t> freeSlots;
+        std::size_t hand = 0;
+        std::size_t bytes = 0;
+        std::size_t evictions = 0;
+        std::atomic<std::size_t> hits{0}, misses{0}, stale{0};
+    };
+
+    // Estimated size of one entry: slot, index node and bucket, shared vector
+    static std::size_t entryBytes(const Order& order) {
+        std::size_t bytes = sizeof(Entry) + sizeof(Key) + 4 * sizeof(void*);
+        if (order) bytes += sizeof(std::vector<Vertex>) + 2 * sizeof(void*) + order->capacity() * sizeof(Vertex);
+        return bytes;
+    }
+
+    const G& g;
+    std::size_t shardBudget;
+    std::vector<Shard> shards;
+
+    Shard& shardOf(const Key& k) {
+        return shards[KeyHash{}(k) % shards.size()];
+    }
+
+    // Frees the first slot the CLOCK hand finds stale or unreferenced
+    void evictOne(Shard& sh, std::uint64_t current) {
+        for (;;) {
+            if (sh.hand >= sh.slots.size()) sh.hand = 0;
+            const std::size_t slot = sh.hand++;
+            Entry& e = sh.slots[slot];
+            if (!e.key) continue;
+            if (e.version == current && e.referenced.exchange(false, std::memory_order_relaxed)) continue;
+            sh.index.erase(*e.key);
+            sh.bytes -= e.bytes;
+            e.key.reset();
+            e.order.reset();
+            sh.freeSlots.push_back(slot);
+            sh.evictions++;
+            return;
+        }
+    }
+
+    // Looks k up; on a miss runs compute() without holding the lock and stores its result
+    template<typename Read, typename Compute, typename Store>
+    auto lookup(const Key& k, Read&& read, Compute&& compute, Store&& store) {
+        Shard& sh = shardOf(k);
+        const std::uint64_t current = g.version();
+        {
+            std::shared_lock<std::shared_mutex> guard(sh.lock);
+            auto it = sh.index.find(k);
+            if (it != sh.index.end()) {
+                const Entry& e = sh.slots[it->second];
+                if (e.version == current) {
+                    sh.slots[it->second].referenced.store(true, std::memory_order_relaxed);
+                    sh.hits.fetch_add(1, std::memory_order_relaxed);
+                    return read(e);
+                }
+                sh.stale.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        sh.misses.fetch_add(1, std::memory_order_relaxed);
+
+        auto result = compute();
+        Entry scratch;
+        store(scratch, result);
+        const std::size_t bytes = entryBytes(scratch.order);
+        if (bytes > shardBudget) return result;
+
+        std::unique_lock<std::shared_mutex> guard(sh.lock);
+        if (auto it = sh.index.find(k); it != sh.index.end()) {
+            // Stale entry, or another thread stored the same result meanwhile:
+            // free it so the new result goes through eviction like any insert
+            Entry& old = sh.slots[it->second];
+            sh.bytes -= old.bytes;
+            old.key.reset();
+            old.order.reset();
+            sh.freeSlots.push_back(it->second);
+            sh.index.erase(it);
+        }
+        while (sh.bytes + bytes > shardBudget) evictOne(sh, current);
+        std::size_t slot;
+        if (!sh.freeSlots.empty()) {
+            slot = sh.freeSlots.back();
+            sh.freeSlots.pop_back();
+        } else {
+            slot = sh.slots.size();
+            sh.slots.emplace_back();
+        }
+        sh.index.emplace(k, slot);
+        Entry& e = sh.slots[slot];
+        e.key = k;
+        e.version = current;
+        store(e, result);
+        e.bytes = bytes;
+        e.referenced.store(false, std::memory_order_relaxed);
+        sh.bytes += bytes;
+        return result;
+    }
+
+public:
+    /**
+     * @brief Creates an empty cache over a graph
+     * @param graph The graph, must outlive the cache
+     * @param opts Memory budget and number of shards
+     */
+    explicit QueryCache(const G& graph, const QueryCacheOptions& opts = {})
+        : g(graph), shardBudget(opts.maxBytes / std::max<std::size_t>(opts.shards, 1)),
+          shards(std::max<std::size_t>(opts.shards, 1)) {}
+
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+
+    /**
+     * @brief Returns g.distance(u, v), from the cache when possible
+     * @note distance(u, v) and distance(v, u) share one entry when vertices
+     *       are totally ordered
+     * @note Complexity: O(1) on a hit, that of Graph::distance() on a miss
+     */
+    std::optional<int> distance(Vertex u, Vertex v) {
+        if constexpr (std::totally_ordered<Vertex>) {
+            if (v < u) std::swap(u, v);
+        }
+        const Key k{Kind::Distance, u, v, 0};
+        return lookup(
+            k, [](const Entry& e) { return e.distance; }, [&] { return g.distance(u, v); },
+            [](Entry& e, const std::optional<int>& d) {
+                e.distance = d;
+                e.order.reset();
+            });
+    }
+
+    /**
+     * @brief Returns g.bfs(v, maxv), from the cache when possible
+     * @return The order, shared with the cache and other callers
+     * @note Results larger than the budget of a shard are returned but not kept
+     * @note Complexity: O(1) on a hit, that of Graph::bfs() on a miss
+     */
+    Order bfs(Vertex v, std::size_t maxv = 0) {
+        const Key k{Kind::Bfs, v, v, maxv};
+        return lookup(
+            k, [](const Entry& e) { return e.order; },
+            [&] { return Order(std::make_shared<const std::vector<Vertex>>(g.bfs(v, maxv))); },
+            [](Entry& e, const Order& order) {
+                e.order = order;
+                e.distance.reset();
+            });
+    }
+
+    /**
+     * @brief Returns the counters, summed over the shards
+     */
+    QueryCacheStats stats() const {
+        QueryCacheStats res;
+        for (const Shard& sh : shards) {
+            std::shared_lock<std::shared_mutex> guard(sh.lock);
+            res.hits += sh.hits.load(std::memory_order_relaxed);
+            res.misses += sh.misses.load(std::memory_order_relaxed);
+            res.stale += sh.stale.load(std::memory_order_relaxed);
+            res.evictions += sh.evictions;
+            res.entries += sh.index.size();
+            res.bytes += sh.bytes;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Drops every entry; the counters are kept
+     */
+    void clear() {
+        for (Shard& sh : shards) {
+            std::unique_lock<std::shared_mutex> guard(sh.lock);
+            sh.index.clear();
+            sh.slots.clear();
+            sh.freeSlots.clear();
+            sh.hand = 0;
+            sh.bytes = 0;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file graphlib/random.hpp
+ * @brief Small, fast pseudo-random utilities shared by the sampling algorithms
+ */
+
+#ifndef GRAPHLIB_RANDOM_HPP
+#define GRAPHLIB_RANDOM_HPP
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace graphlib {
+
+/**
+ * @brief SplitMix64 generator, mostly used to seed other generators
+ * @note Here i used https://prng.di.unimi.it/splitmix64.c as a reference
+ */
+class SplitMix64 {
+private:
+    std::uint64_t state;
+
+public:
+    using result_type = std::uint64_t;
+
+    explicit SplitMix64(std::uint64_t seed = 0) : state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+};
+
+/**
+ * @brief xoshiro256++ generator, satisfies UniformRandomBitGenerator
+ * @note Much cheaper than std::mt19937_64 and only 32 bytes of state,
+ *       which makes it practical to keep one per thread or per batch
+ * @note Here i used https://prng.di.unimi.it/xoshiro256plusplus.c as a reference
+ */
+class Xoshiro256 {
+private:
+    std::uint64_t s[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t seed = 0) {
+        SplitMix64 sm(seed);
+        for (auto& word : s) word = sm();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+};
+
+/**
+ * @brief Draws a uniform integer in [0, bound)
+ * @param rng Any UniformRandomBitGenerator
+ * @param bound Exclusive upper bound, must be > 0
+ * @note Uses Lemire's multiply-shift method when a 64-bit generator and
+ *       128-bit arithmetic are available, which avoids the division done
+ *       by std::uniform_int_distribution on every call
+ * @note Here i used https://arxiv.org/abs/1805.10941 as a reference
+ */
+template<typename URBG>
+std::uint64_t boundedRandom(URBG& rng, std::uint64_t bound) {
+#ifdef __SIZEOF_INT128__
+    if constexpr (URBG::min() == 0 && URBG::max() == std::numeric_limits<std::uint64_t>::max()) {
+        unsigned __int128 m = static_cast<unsigned __int128>(rng()) * bound;
+        std::uint64_t low = static_cast<std::uint64_t>(m);
+        if (low < bound) {
+            const std::uint64_t threshold = (0 - bound) % bound;
+            while (low < threshold) {
+                m = static_cast<unsigned __int128>(rng()) * bound;
+                low = static_cast<std::uint64_t>(m);
+            }
+        }
+        return static_cast<std::uint64_t>(m >> 64);
+    }
+#endif
+    return std::uniform_int_distribution<std::uint64_t>(0, bound - 1)(rng);
+}
+
+/**
+ * @brief Draws a uniform double in [0, 1)
+ * @param rng Any UniformRandomBitGenerator
+ */
+template<typename URBG>
+double uniformReal(URBG& rng) {
+    if constexpr (URBG::min() == 0 && URBG::max() == std::numeric_limits<std::uint64_t>::max()) {
+        return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+    } else {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    }
+}
+
+} // namespace graphlib
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file graphlib/sampling.hpp
+ * @brief Bounded neighbor and multi-hop neighborhood sampling (GNN-style mini-batches)
+ */
+
+#ifndef GRAPHLIB_SAMPLING_HPP
+#define GRAPHLIB_SAMPLING_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "csr.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
+
+/**
+ * @brief Samples neighbors and k-hop neighborhoods from a CSRGraph
+ * @tparam Vertex Vertex type
+ * @tparam Hash function (default: std::hash<Vertex>)
+ * @note All methods are const and the sampler holds no mutable state, so a
+ *       single instance can be shared by many threads
+ */
+template<typename Vertex, typename Hash=std::hash<Vertex>>
+class NeighborSampler {
+public:
+    using Id = typename CSRGraph<Vertex, Hash>::Id;
+
+    /**
+     * @brief Result of a k-hop sample
+     * layers[0] holds the seeds, layers[h + 1] the distinct vertices sampled
+     * at hop h + 1. edges[h] holds the sampled (src, dst) pairs of hop h + 1,
+     * with src in layers[h] and dst in layers[h + 1].
+     */
+    struct KHopSample {
+        std::vector<std::vector<Id>> layers;
+        std::vector<std::vector<std::pair<Id, Id>>> edges;
+    };
+
+private:
+    const CSRGraph<Vertex, Hash>& g;
+
+    // Below this many picks, checking duplicates by scanning the picks is
+    // faster than maintaining a hash set
+    static constexpr std::size_t linearScanLimit = 64;
+
+public:
+    /**
+     * @brief Creates a sampler over a CSR snapshot
+     * @param graph The graph to sample from, must outlive the sampler
+     */
+    explicit NeighborSampler(const CSRGraph<Vertex, Hash>& graph) : g(graph) {}
+
+    /**
+     * @brief Samples up to k distinct neighbors of a vertex, uniformly without replacement
+     * @param v A valid vertex id
+     * @param k Number of neighbors to sample
+     * @param rng Any UniformRandomBitGenerator
+     * @param out Sampled neighbor ids are appended to this vector
+     * @note If k >= degree(v) every neighbor is returned
+     * @note Here i used Floyd's algorithm (https://doi.org/10.1145/30401.315746) as a reference
+     * @note Complexity: O(k) expected, independent of the degree of v
+     */
+    template<typename URBG>
+    void sampleNeighbors(Id v, std::size_t k, URBG& rng, std::vector<Id>& out) const {
+        auto nbrs = g.neighbors(v);
+        const std::size_t d = nbrs.size();
+        if (k >= d) {
+            out.insert(out.end(), nbrs.begin(), nbrs.end());
+            return;
+        }
+
+        const std::size_t first = out.size();
+        if (k <= linearScanLimit) {
+            // Picks are positions in nbrs; the chosen ids are distinct iff positions are
+            for (std::size_t j = d - k; j < d; j++) {
+                std::size_t t = static_cast<std::size_t>(graphlib::boundedRandom(rng, j + 1));
+                Id candidate = nbrs[t];
+                bool taken = std::find(out.begin() + first, out.end(), candidate) != out.end();
+                out.push_back(taken ? nbrs[j] : candidate);
+            }
+        } else {
+            std::unordered_set<std::size_t> picked;
+            picked.reserve(k);
+            for (std::size_t j = d - k; j < d; j++) {
+                std::size_t t = static_cast<std::size_t>(graphlib::boundedRandom(rng, j + 1));
+                if (!picked.insert(t).second) picked.insert(t = j);
+                out.push_back(nbrs[t]);
+            }
+        }
+    }
+
+    /**
+     * @brief Samples up to k distinct neighbors of a vertex
+     * @param v A valid vertex id
+     * @param k Number of neighbors to sample
+     * @param rng Any UniformRandomBitGenerator
+     * @return The sampled neighbor ids
+     * @note Complexity: O(k) expected
+     */
+    template<typename URBG>
+    std::vector<Id> sampleNeighbors(Id v, std::size_t k, URBG& rng) const {
+        std::vector<Id> res;
+        res.reserve(std::min(k, g.degree(v)));
+        sampleNeighbors(v, k, rng, res);
+        return res;
+    }
+
+    /**
+     * @brief Samples a multi-hop neighborhood around a set of seeds
+     * @param seeds Seed vertex ids
+     * @param fanouts Number of neighbors sampled per vertex at each hop, e.g. {25, 10}
+     * @param rng Any UniformRandomBitGenerator
+     * @return The layered sample, with fanouts.size() hops
+     * @note Each hop samples from the distinct vertices reached at the previous hop
+     * @note Complexity: O(S log S) where S is the number of sampled edges
+     */
+    template<typename URBG>
+    KHopSample sampleKHop(std::span<const Id> seeds, std::span<const std::size_t> fanouts, URBG& rng) const {
+        KHopSample res;
+        res.layers.reserve(fanouts.size() + 1);
+        res.edges.reserve(fanouts.size());
+        res.layers.emplace_back(seeds.begin(), seeds.end());
+
+        std::vector<Id> picks;
+        for (std::size_t fanout : fanouts) {
+            const std::vector<Id>& frontier = res.layers.back();
+            std::vector<std::pair<Id, Id>> hopEdges;
+            hopEdges.reserve(frontier.size() * fanout);
+
+            for (Id src : frontier) {
+                picks.clear();
+                sampleNeighbors(src, fanout, rng, picks);
+                for (Id dst : picks) hopEdges.emplace_back(src, dst);
+            }
+
+            std::vector<Id> next;
+            next.reserve(hopEdges.size());
+            for (const auto& e : hopEdges) next.push_back(e.second);
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+
+            res.edges.push_back(std::move(hopEdges));
+            res.layers.push_back(std::move(next));
+        }
+        return res;
+    }
+
+    /**
+     * @brief Samples k-hop neighborhoods for many seed batches in parallel
+     * @param batches One seed list per mini-batch
+     * @param fanouts Number of neighbors sampled per vertex at each hop
+     * @param seed Base seed of the random generators
+     * @param threads Number of threads (0 for all hardware threads)
+     * @return One sample per batch, in the same order as batches
+     * @note Every batch gets its own Xoshiro256 generator derived from seed and
+     *       its index, so results do not depend on the thread count
+     */
+    std::vector<KHopSample> sampleKHopBatch(const std::vector<std::vector<Id>>& batches,
+                                            std::span<const std::size_t> fanouts,
+                                            std::uint64_t seed, std::size_t threads = 0) const {
+        std::vector<KHopSample> res(batches.size());
+        graphlib::parallelFor(batches.size(), threads, [&](std::size_t b, std::size_t) {
+            graphlib::Xoshiro256 rng(graphlib::SplitMix64(seed ^ (0x9e3779b97f4a7c15ULL * (b + 1)))());
+            res[b] = sampleKHop(std::span<const Id>(batches[b]), fanouts, rng);
+        }, 1);
+        return res;
+    }
+};
+
+#endif
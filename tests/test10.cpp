@@ -0,0 +1,112 @@
+/**
+ * @file test10.cpp
+ * @brief Test suite for incrementally maintained BFS distances
+ *
+ * This test validates:
+ * - Observers are notified of vertex/edge insertions and removals
+ * - Observers are not copied along with the graph
+ * - DynamicDistance matches a full recomputation after every random update
+ * - Removing and re-adding the source vertex
+ */
+
+#include <iostream>
+#include <cassert>
+#include <random>
+#include "graphlib/dynamic_distance.hpp"
+
+// Records every notification it receives
+struct CountingObserver : GraphObserver<int> {
+    int vertices = 0, edges = 0, removedEdges = 0, removedVertices = 0, clears = 0;
+    void onAddVertex(const int&) override { vertices++; }
+    void onAddEdge(const int&, const int&) override { edges++; }
+    void onRemoveEdge(const int&, const int&) override { removedEdges++; }
+    void onRemoveVertex(const int&) override { removedVertices++; }
+    void onClear() override { clears++; }
+};
+
+// Reference distances from a fresh BFS
+static bool matchesRecomputation(const Graph<int>& g, const DynamicDistance<int>& dd, int source) {
+    for (const auto& v : g) {
+        if (dd.distanceFromSource(v) != g.distance(source, v)) return false;
+    }
+    return true;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Observer notifications
+    // =========================================================================
+    Graph<int> g;
+    CountingObserver counter;
+    g.attach(&counter);
+
+    g.addVertex(1);
+    g.addVertex(1);        // Already present: no notification
+    g.addEdge(1, 2);       // Creates 2
+    g.addEdge(2, 1);       // Already present: no notification
+    g.addEdge(2, 3);
+    g.addEdge(3, 3);       // Self-loop ignored
+    g.removeEdge(1, 3);    // Missing edge: no notification
+    g.removeEdge(1, 2);
+    g.addEdge(1, 3);
+    g.removeVertex(3);     // Removes edges 1-3 and 2-3
+
+    assert(counter.vertices == 3 && "Three vertices should have been created");
+    assert(counter.edges == 3 && "Three edges should have been inserted");
+    assert(counter.removedEdges == 3 && "Three edges should have been removed");
+    assert(counter.removedVertices == 1 && "One vertex should have been removed");
+
+    Graph<int> copy = g;
+    copy.addEdge(7, 8);
+    assert(counter.edges == 3 && "Copies should not carry observers");
+
+    g.clear();
+    assert(counter.clears == 1 && "clear() should be reported");
+    g.detach(&counter);
+    g.addEdge(1, 2);
+    assert(counter.edges == 3 && "Detached observer should not be notified");
+
+    // =========================================================================
+    // TEST 2: Randomized updates against full recomputation
+    // =========================================================================
+    g.clear();
+    const int n = 60;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    for (int i = 0; i < 90; i++) g.addEdge(pick(rng), pick(rng));
+
+    DynamicDistance<int> dd(g, 0);
+    assert(matchesRecomputation(g, dd, 0) && "Initial distances should match BFS");
+
+    for (int step = 0; step < 3000; step++) {
+        int action = rng() % 10;
+        int u = pick(rng), v = pick(rng);
+        if (action < 5) {
+            g.addEdge(u, v);
+        } else if (action < 9) {
+            // Prefer removing existing edges so the graph keeps changing shape
+            const auto& nbrs = g.neighbors(u);
+            if (!nbrs.empty()) v = *nbrs.begin();
+            g.removeEdge(u, v);
+        } else if (u != 0) {
+            g.removeVertex(u);
+        }
+        assert(matchesRecomputation(g, dd, 0) && "Distances should match BFS after each update");
+    }
+
+    // =========================================================================
+    // TEST 3: Removing and re-adding the source
+    // =========================================================================
+    g.removeVertex(0);
+    assert(dd.countReachable() == 0 && "Nothing is reachable without the source");
+    g.addEdge(0, 1);
+    g.addEdge(1, 2);
+    assert(dd.distanceFromSource(0) == 0 && "Re-added source should be at distance 0");
+    assert(matchesRecomputation(g, dd, 0) && "Distances should match BFS after re-adding the source");
+
+    g.clear();
+    assert(!dd.distanceFromSource(1).has_value() && "clear() should reset distances");
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test11.cpp
+ * @brief Test suite for batched mutations
+ *
+ * This test validates:
+ * - Add-then-remove pairs cancel but still create the endpoints
+ * - Edges added before the removal of an endpoint are dropped
+ * - Random batches leave the graph exactly as one-by-one calls would
+ * - Parallel application and observed graphs give the same result
+ */
+
+#include <iostream>
+#include <cassert>
+#include <random>
+#include "graphlib/mutation_batch.hpp"
+
+static bool sameGraph(const Graph<int>& a, const Graph<int>& b) {
+    return a.vertices() == b.vertices() && a.edges() == b.edges();
+}
+
+// Counts effective edge insertions reported to observers
+struct EdgeCounter : GraphObserver<int> {
+    int added = 0;
+    void onAddEdge(const int&, const int&) override { added++; }
+};
+
+int main() {
+    // =========================================================================
+    // TEST 1: Cancellation rules
+    // =========================================================================
+    Graph<int> g;
+    g.addEdge(1, 2);
+
+    MutationBatch<int> batch;
+    batch.addEdge(3, 4);
+    batch.removeEdge(4, 3);    // Cancels the insertion, 3 and 4 still exist
+    batch.addEdge(5, 6);
+    batch.removeVertex(5);     // Edge 5-6 is void, 6 stays
+    batch.removeVertex(1);
+    batch.addEdge(1, 7);       // 1 is created again after its removal
+    batch.addEdge(8, 8);       // Self-loop ignored
+    assert(batch.size() == 6 && "Self-loop should not be buffered");
+
+    batch.applyTo(g);
+    assert(g.containsVertex(3) && g.containsVertex(4) && !g.containsEdge(3, 4) && "Add-then-remove should only create vertices");
+    assert(!g.containsVertex(5) && g.containsVertex(6) && g.degree(6) == 0 && "Removed vertex should drop its new edges");
+    assert(!g.containsEdge(1, 2) && g.containsEdge(1, 7) && "Re-created vertex should only keep later edges");
+    assert(g.degree(2) == 0 && "Neighbor of removed vertex should lose the edge");
+    assert(!g.containsVertex(8) && "Self-loop should not create a vertex");
+
+    // =========================================================================
+    // TEST 2: Random batches match one-by-one application
+    // =========================================================================
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, 79);
+
+    for (int round = 0; round < 50; round++) {
+        Graph<int> reference;
+        for (int i = 0; i < 120; i++) reference.addEdge(pick(rng), pick(rng));
+        Graph<int> serial = reference, parallel = reference, observed = reference;
+
+        MutationBatch<int> mixed;
+        for (int i = 0; i < 400; i++) {
+            int u = pick(rng), v = pick(rng);
+            switch (rng() % 10) {
+                case 0:             reference.addVertex(u);     mixed.addVertex(u);     break;
+                case 1: case 2:
+                case 3: case 4:     reference.addEdge(u, v);    mixed.addEdge(u, v);    break;
+                case 5: case 6:
+                case 7: case 8:     reference.removeEdge(u, v); mixed.removeEdge(u, v); break;
+                default:            reference.removeVertex(u);  mixed.removeVertex(u);  break;
+            }
+        }
+
+        mixed.applyTo(serial);
+        mixed.applyTo(parallel, 4);
+        EdgeCounter counter;
+        observed.attach(&counter);
+        mixed.applyTo(observed);
+        observed.detach(&counter);
+
+        assert(sameGraph(reference, serial) && "Batch should match one-by-one application");
+        assert(sameGraph(reference, parallel) && "Parallel batch should match one-by-one application");
+        assert(sameGraph(reference, observed) && "Observed batch should match one-by-one application");
+    }
+
+    // =========================================================================
+    // TEST 3: clear()
+    // =========================================================================
+    batch.clear();
+    assert(batch.empty() && "Cleared batch should be empty");
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test12.cpp
+ * @brief Test suite for traversal statistics, with GRAPHLIB_STATS disabled
+ *
+ * This test validates:
+ * - The disabled build adds no member to Graph and exposes no counters
+ * - bfs/distance overloads taking TraversalStats return the same results
+ *   as the plain ones and report the expected work
+ * - The plain bfs and distance return exactly what the original,
+ *   uninstrumented algorithms return
+ */
+
+#include <iostream>
+#include <cassert>
+#include "graphlib.hpp"
+
+// The BFS as it was before instrumentation, used as a reference
+static std::vector<int> referenceBfs(const Graph<int>& g, int v) {
+    std::vector<int> result;
+    std::unordered_set<int> seen;
+    std::queue<int> pending;
+    pending.push(v);
+    seen.insert(v);
+    while (!pending.empty()) {
+        int current = pending.front();
+        pending.pop();
+        result.emplace_back(current);
+        for (int next : g.neighbors(current)) {
+            if (seen.insert(next).second) pending.push(next);
+        }
+    }
+    return result;
+}
+
+// The distance as it was before instrumentation, used as a reference
+static std::optional<int> referenceDistance(const Graph<int>& g, int u, int v) {
+    if (!g.containsVertex(u) || !g.containsVertex(v)) return std::nullopt;
+    if (u == v) return 0;
+    std::unordered_set<int> seen;
+    std::queue<int> level;
+    level.push(u);
+    seen.insert(u);
+    for (int depth = 1; !level.empty(); depth++) {
+        for (std::size_t i = level.size(); i > 0; i--) {
+            int current = level.front();
+            level.pop();
+            for (int next : g.neighbors(current)) {
+                if (next == v) return depth;
+                if (seen.insert(next).second) level.push(next);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Zero cost when disabled
+    // =========================================================================
+    static_assert(!Graph<int>::statsEnabled, "GRAPHLIB_STATS must not be defined in this test");
+    static_assert(sizeof(Graph<int>) == sizeof(std::unordered_map<int, std::unordered_set<int>>)
+                                        + sizeof(std::vector<GraphObserver<int>*>) + sizeof(std::uint64_t),
+                  "Graph must not carry counters when GRAPHLIB_STATS is disabled");
+    std::cout << "TEST 1 PASSED: No counters in the disabled build" << std::endl;
+
+    // =========================================================================
+    // TEST 2: BFS statistics on a small tree
+    // =========================================================================
+    // Tree rooted at 0: 0 -> {1, 2, 3}, 1 -> {4, 5}, 3 -> {6}, 6 -> {7}
+    Graph<int> g;
+    g.addEdge(0, 1); g.addEdge(0, 2); g.addEdge(0, 3);
+    g.addEdge(1, 4); g.addEdge(1, 5); g.addEdge(3, 6); g.addEdge(6, 7);
+
+    TraversalStats stats;
+    auto order = g.bfs(0, 0, stats);
+    assert(order == g.bfs(0) && "Instrumented BFS must visit the same vertices in the same order");
+    assert(stats.verticesExpanded == 8 && "Every vertex should be expanded");
+    assert(stats.edgesScanned == 2 * g.countEdges() && "Every adjacency entry should be read once");
+    assert((stats.frontierSizes == std::vector<size_t>{1, 3, 3, 1}) && "Frontiers should be 1, 3, 3, 1");
+
+    g.bfs(0, 4, stats);
+    assert(stats.verticesExpanded == 4 && "A bounded BFS expands at most maxv vertices");
+    assert((stats.frontierSizes == std::vector<size_t>{1, 3, 3}) && "Depth 3 is never reached");
+
+    g.bfs(42, 0, stats);
+    assert(stats.verticesExpanded == 0 && stats.frontierSizes.empty() && "Missing start vertex: no work");
+    std::cout << "TEST 2 PASSED: BFS statistics" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Distance statistics
+    // =========================================================================
+    assert(g.distance(0, 7, stats) == g.distance(0, 7) && "Instrumented distance must match");
+    assert(*g.distance(0, 7, stats) == 3 && "Distance 0 -> 7 should be 3");
+    assert(stats.frontierSizes.size() == 4 && stats.frontierSizes.back() == 1 && "Search stops at depth 3");
+    assert(stats.verticesExpanded >= 5 && stats.verticesExpanded <= 7 && "7 is found while expanding 6, at depth 2");
+
+    g.addVertex(99);
+    assert(!g.distance(0, 99, stats) && "Unreachable vertex has no distance");
+    assert(stats.verticesExpanded == 8 && stats.edgesScanned == 2 * g.countEdges() && "Whole component scanned");
+    std::cout << "TEST 3 PASSED: Distance statistics" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Plain bfs and distance match the uninstrumented algorithms
+    // =========================================================================
+    Graph<int> big;
+    for (int i = 0; i < 200000; i++) {
+        big.addEdge(i, (i + 1) % 200000);
+        big.addEdge(i, static_cast<int>((i * 7919LL) % 200000));
+    }
+    big.addVertex(-1);
+    assert(big.bfs(0).size() + 1 == big.countVertices() && "The traversal should reach the whole component");
+    for (int source : {0, 1, 12345, 199999, -1}) {
+        assert(big.bfs(source) == referenceBfs(big, source) && "Plain bfs must visit in the reference order");
+    }
+    for (int target : {0, 1, 2, 7919, 100000, 199999, -1, 400000}) {
+        assert(big.distance(0, target) == referenceDistance(big, 0, target) && "Plain distance must match the reference");
+        assert(big.distance(target, 54321) == referenceDistance(big, target, 54321) && "Plain distance must match the reference");
+    }
+    std::cout << "TEST 4 PASSED: Plain bfs and distance match the reference" << std::endl;
+
+    std::cout << "\n=== All traversal statistics tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file test13.cpp
+ * @brief Test suite for graph-level counters, with GRAPHLIB_STATS enabled
+ *
+ * This test validates:
+ * - Insert and removal counters ignore duplicates, self-loops and missing elements
+ * - Rehashes and allocated bytes grow with the graph
+ * - clear() and removeVertex() count the edges they drop
+ * - MutationBatch updates are counted like individual calls
+ */
+
+#define GRAPHLIB_STATS
+
+#include <iostream>
+#include <cassert>
+#include "graphlib/mutation_batch.hpp"
+
+int main() {
+    static_assert(Graph<int>::statsEnabled, "GRAPHLIB_STATS should be enabled in this test");
+
+    // =========================================================================
+    // TEST 1: Insert and removal counters
+    // =========================================================================
+    Graph<int> g;
+    g.addVertex(1);
+    g.addVertex(1);     // Duplicate
+    g.addEdge(1, 2);    // Creates 2
+    g.addEdge(2, 1);    // Duplicate
+    g.addEdge(3, 3);    // Self-loop
+    g.addEdge(2, 3);
+    g.addEdge(3, 4);
+    g.removeEdge(1, 4); // Missing
+    g.removeEdge(3, 4);
+
+    const GraphCounters& c = g.counters();
+    assert(c.vertexInserts == 4 && "Vertices 1, 2, 3 and 4 should be counted once");
+    assert(c.edgeInserts == 3 && "Only new edges should be counted");
+    assert(c.edgeRemovals == 1 && "Only existing edges should be counted");
+
+    g.removeVertex(2);  // Drops 1-2 and 2-3
+    assert(c.vertexRemovals == 1 && c.edgeRemovals == 3 && "Incident edges count as removals");
+
+    g.addEdge(1, 3);
+    g.clear();
+    assert(c.vertexRemovals == 4 && c.edgeRemovals == 4 && "clear() drops 3 vertices and 1 edge");
+    std::cout << "TEST 1 PASSED: Insert and removal counters" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Rehashes and allocations
+    // =========================================================================
+    g.resetCounters();
+    assert(c.vertexInserts == 0 && c.rehashes == 0 && c.bytesAllocated == 0 && "Counters should reset");
+    for (int i = 0; i < 10000; i++) g.addEdge(0, i + 1);
+    assert(c.edgeInserts == 10000 && c.vertexInserts == 10001 && "Star with 10000 leaves");
+    assert(c.rehashes >= 20 && "adj and the hub's set grow many times");
+    assert(c.bytesAllocated >= 2 * 10000 * sizeof(int) && "Nodes of adj and of the sets are accounted for");
+    std::cout << "TEST 2 PASSED: Rehashes and allocations" << std::endl;
+
+    // =========================================================================
+    // TEST 3: MutationBatch is counted like individual calls
+    // =========================================================================
+    Graph<int> individual, batched;
+    MutationBatch<int> batch;
+    for (int i = 0; i < 100; i++) {
+        individual.addEdge(i, (i * 37) % 100);
+        batch.addEdge(i, (i * 37) % 100);
+        if (i % 10 == 0) {
+            individual.removeVertex(i / 2);
+            batch.removeVertex(i / 2);
+        }
+    }
+    batch.applyTo(batched);
+    assert(batched.countEdges() == individual.countEdges() && "Batch should match individual calls");
+    assert(batched.counters().edgeInserts <= individual.counters().edgeInserts && "Cancelled edges are never inserted");
+    assert(batched.counters().edgeInserts - batched.counters().edgeRemovals == batched.countEdges()
+           && "Counted inserts minus removals should equal the edge count");
+    std::cout << "TEST 3 PASSED: MutationBatch counters" << std::endl;
+
+    std::cout << "\n=== All graph counter tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file test14.cpp
+ * @brief Test suite for memory accounting
+ *
+ * This test validates:
+ * - memoryUsage() matches the bytes actually allocated, measured by a
+ *   counting global operator new, for int and std::string vertices
+ * - The breakdown adds up and payload counts n + 2m values
+ * - shrinkToFit() releases bucket arrays after heavy removals, reports
+ *   what it released and leaves the graph unchanged
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "graphlib.hpp"
+
+// Counting allocator: every global allocation stores its size in a header
+static long long liveBytes = 0;
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size + 16);
+    if (!p) throw std::bad_alloc();
+    *static_cast<std::size_t*>(p) = size;
+    liveBytes += static_cast<long long>(size);
+    return static_cast<char*>(p) + 16;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    void* base = static_cast<char*>(p) - 16;
+    liveBytes -= static_cast<long long>(*static_cast<std::size_t*>(base));
+    std::free(base);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+// Checks that an estimate is within 1% of a measurement
+static bool close(std::size_t estimate, long long measured) {
+    long long diff = static_cast<long long>(estimate) - measured;
+    if (diff < 0) diff = -diff;
+    return diff * 100 <= measured;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Estimates match allocations for integer vertices
+    // =========================================================================
+    {
+        const long long before = liveBytes;
+        Graph<int> g;
+        unsigned x = 1;
+        for (int i = 0; i < 20000; i++) {
+            x = x * 1103515245u + 12345u;
+            g.addEdge(i % 5000, static_cast<int>((x >> 8) % 5000));
+        }
+        g.addVertex(-1); // Isolated vertex: empty set, no bucket array
+
+        const long long measured = liveBytes - before;
+        const MemoryUsage usage = g.memoryUsage();
+        std::cout << "int graph: estimated " << usage.total() << " bytes, measured " << measured << std::endl;
+        assert(close(usage.total(), measured) && "Estimate should match the counting allocator");
+        assert(usage.payload == (g.countVertices() + 2 * g.countEdges()) * sizeof(int) && "Payload is n + 2m values");
+        assert(usage.vertexTable > 0 && usage.adjacencyBuckets > 0 && usage.adjacencyNodes > 0 && "Every part is used");
+        assert(usage.total() == usage.vertexTable + usage.adjacencyBuckets + usage.adjacencyNodes + usage.payload
+               && "total() sums the breakdown");
+    }
+    std::cout << "TEST 1 PASSED: Integer vertices" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Estimates match allocations for string vertices (cached hashes)
+    // =========================================================================
+    {
+        std::vector<std::string> names;
+        for (int i = 0; i < 3000; i++) names.push_back(std::string("v").append(std::to_string(i))); // Short strings, no heap buffer
+
+        const long long before = liveBytes;
+        Graph<std::string> g;
+        for (int i = 0; i < 3000; i++) {
+            g.addEdge(names[i], names[(i * 17 + 1) % 3000]);
+            g.addEdge(names[i], names[(i * 31 + 7) % 3000]);
+        }
+        const long long measured = liveBytes - before;
+        const MemoryUsage usage = g.memoryUsage();
+        std::cout << "string graph: estimated " << usage.total() << " bytes, measured " << measured << std::endl;
+        assert(close(usage.total(), measured) && "Estimate should match the counting allocator");
+    }
+    std::cout << "TEST 2 PASSED: String vertices" << std::endl;
+
+    // =========================================================================
+    // TEST 3: shrinkToFit after heavy churn
+    // =========================================================================
+    {
+        const long long before = liveBytes;
+        Graph<int> g;
+        for (int u = 0; u < 200; u++) {
+            for (int v = u + 1; v < 200; v++) g.addEdge(u, v);
+        }
+        for (int v = 0; v < 3000; v++) g.addVertex(1000 + v);
+
+        // Keep a sparse ring among the first 200 vertices, drop the added vertices
+        for (int u = 0; u < 200; u++) {
+            for (int v = u + 2; v < 200; v++) {
+                if (!(u == 0 && v == 199)) g.removeEdge(u, v);
+            }
+        }
+        for (int v = 0; v < 3000; v++) g.removeVertex(1000 + v);
+        assert(g.countEdges() == 200 && "A ring of 200 edges should remain");
+
+        const long long churned = liveBytes - before;
+        assert(close(g.memoryUsage().total(), churned) && "Estimate should match before shrinking");
+
+        auto edgesBefore = g.edges();
+        const long long beforeShrink = liveBytes;
+        const std::size_t released = g.shrinkToFit();
+        const long long shrunk = churned - (beforeShrink - liveBytes);
+        std::cout << "churned graph: " << churned << " bytes, after shrinkToFit " << shrunk
+                  << " bytes (" << released << " reported)" << std::endl;
+
+        assert(shrunk < churned / 4 && "Most of the bucket memory should be released");
+        assert(static_cast<long long>(released) == beforeShrink - liveBytes && "Released bytes should be reported exactly");
+        assert(close(g.memoryUsage().total(), shrunk) && "Estimate should match after shrinking");
+        assert(g.edges() == edgesBefore && g.countVertices() == 200 && "Graph content must not change");
+        assert(g.shrinkToFit() == 0 && "A second call has nothing left to release");
+    }
+    std::cout << "TEST 3 PASSED: shrinkToFit" << std::endl;
+
+    std::cout << "\n=== All memory accounting tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test15.cpp
+ * @brief Test suite for the compressed graph representation
+ *
+ * This test validates:
+ * - Degrees, neighbor lists (iterator and forEachNeighbor) and containsEdge
+ *   match the CSRGraph the compressed graph is built from
+ * - Lists spanning many blocks, gaps needing 1 to 3 bytes and isolated vertices
+ * - bfs() follows the same contract as Graph::bfs
+ * - Compression actually saves memory on a local graph
+ */
+
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <string>
+#include "graphlib/compressed.hpp"
+
+template<typename V>
+static bool sameAdjacency(const CSRGraph<V>& csr, const CompressedGraph<V>& cg) {
+    using Id = typename CSRGraph<V>::Id;
+    if (csr.countVertices() != cg.countVertices() || csr.countEdges() != cg.countEdges()) return false;
+    for (Id i = 0; i < csr.countVertices(); i++) {
+        auto expected = csr.neighbors(i);
+        if (cg.degree(i) != expected.size() || cg.neighbors(i).size() != expected.size()) return false;
+
+        std::vector<Id> iterated(cg.neighbors(i).begin(), cg.neighbors(i).end());
+        std::vector<Id> visited;
+        cg.forEachNeighbor(i, [&](Id w) { visited.push_back(w); });
+        if (!std::equal(expected.begin(), expected.end(), iterated.begin(), iterated.end())) return false;
+        if (visited != iterated) return false;
+    }
+    return true;
+}
+
+int main() {
+    using Id = CSRGraph<int>::Id;
+
+    // =========================================================================
+    // TEST 1: Random graph with a hub spanning many blocks
+    // =========================================================================
+    const Id n = 200000;
+    std::vector<std::pair<Id, Id>> edges;
+    unsigned x = 7;
+    auto next = [&] { x = x * 1103515245u + 12345u; return (x >> 4) % n; };
+    for (int i = 0; i < 300000; i++) edges.emplace_back(next(), next()); // Gaps of 1 to 3 bytes
+    for (Id v = 1; v < 2000; v++) edges.emplace_back(0, v);              // Dense run of 1-byte gaps
+    for (Id v = 0; v < n; v += 97) edges.emplace_back(1, v);             // Hub with ~2000 neighbors
+    edges.emplace_back(5, 5);                                            // Self-loop dropped
+
+    auto csr = CSRGraph<int>::fromEdgeList(n + 10, edges); // Ids n..n+9 are isolated
+    CompressedGraph<int> cg(csr);
+    assert(sameAdjacency(csr, cg) && "Compressed lists should decode to the CSR lists");
+    assert(cg.degree(n + 3) == 0 && cg.neighbors(n + 3).empty() && "Isolated vertices have no neighbors");
+    assert(cg.degree(1) > 10 * CompressedGraph<int>::blockSize && "Hub should span many blocks");
+    std::cout << "TEST 1 PASSED: Lists match the CSR snapshot" << std::endl;
+
+    // =========================================================================
+    // TEST 2: containsEdge on hits, misses and block boundaries
+    // =========================================================================
+    for (Id u : {Id{0}, Id{1}, Id{2}, Id{12345}, n + 1}) {
+        for (Id v = 0; v < n + 10; v += (u <= 1 ? 1 : 13)) {
+            assert(cg.containsEdge(u, v) == csr.containsEdge(u, v) && "containsEdge must match the CSR");
+        }
+    }
+    for (int i = 0; i < 100000; i++) {
+        const Id u = next(), v = next();
+        assert(cg.containsEdge(u, v) == csr.containsEdge(u, v) && "containsEdge must match the CSR");
+    }
+    for (const auto& [u, v] : edges) {
+        if (u != v) assert(cg.containsEdge(u, v) && cg.containsEdge(v, u) && "Every input edge must be found");
+    }
+    std::cout << "TEST 2 PASSED: containsEdge" << std::endl;
+
+    // =========================================================================
+    // TEST 3: BFS from Graph, with custom vertex types
+    // =========================================================================
+    Graph<std::string> g;
+    g.addEdge("a", "b"); g.addEdge("a", "c"); g.addEdge("b", "d"); g.addEdge("c", "d"); g.addEdge("d", "e");
+    g.addVertex("lonely");
+    CompressedGraph<std::string> cs(g);
+    auto order = cs.bfs("a");
+    assert(order.size() == 5 && order.front() == "a" && order.back() == "e" && "BFS should reach the component");
+    auto expected = g.bfs("a");
+    std::sort(order.begin(), order.end());
+    std::sort(expected.begin(), expected.end());
+    assert(order == expected && "Same vertices as Graph::bfs");
+    assert(cs.bfs("a", 2).size() == 2 && "maxv limits the visit");
+    assert(cs.bfs("missing").empty() && "Missing start vertex gives an empty result");
+    assert(cs.id("lonely") != CompressedGraph<std::string>::npos && cs.degree(cs.id("lonely")) == 0);
+    assert(cs.containsEdge(cs.id("a"), cs.id("b")) && !cs.containsEdge(cs.id("a"), cs.id("e")));
+
+    auto full = cg.bfsById(0);
+    std::vector<bool> seen(cg.countVertices(), false);
+    for (Id v : full) {
+        assert(!seen[v] && "BFS must not visit a vertex twice");
+        seen[v] = true;
+    }
+    assert(!seen[n + 1] && "Isolated vertices are not reached");
+    std::cout << "TEST 3 PASSED: BFS" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Memory footprint on a local graph
+    // =========================================================================
+    std::vector<std::pair<Id, Id>> grid;
+    const Id side = 300;
+    for (Id y = 0; y < side; y++) {
+        for (Id xx = 0; xx < side; xx++) {
+            if (xx + 1 < side) grid.emplace_back(y * side + xx, y * side + xx + 1);
+            if (y + 1 < side) grid.emplace_back(y * side + xx, (y + 1) * side + xx);
+        }
+    }
+    auto gridCsr = CSRGraph<int>::fromEdgeList(side * side, grid);
+    auto gridCg = CompressedGraph<int>::fromEdgeList(side * side, grid);
+    assert(sameAdjacency(gridCsr, gridCg) && "Grid lists should decode to the CSR lists");
+    std::cout << "grid: " << gridCg.bytesPerEdge() << " bytes/edge compressed" << std::endl;
+    assert(gridCg.memoryBytes() < gridCsr.memoryBytes() && "Compression should shrink the footprint");
+    assert(gridCg.bytesPerEdge() < 2 * sizeof(Id) && "Less than the CSR neighbor entries alone");
+    std::cout << "TEST 4 PASSED: Memory footprint" << std::endl;
+
+    std::cout << "\n=== All compressed graph tests passed ===" << std::endl;
+    return 0;
+}
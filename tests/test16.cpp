@@ -0,0 +1,143 @@
+/**
+ * @file test16.cpp
+ * @brief Test suite for the out-of-core graph
+ *
+ * This test validates:
+ * - Building a partitioned file under an artificially low memory budget
+ * - Streaming every neighbor list back, deduplicated and sorted
+ * - Semi-external BFS distances match Graph::distance
+ * - Semi-external connected components match a BFS labeling
+ * - I/O statistics reflect partition skipping and single-pass components
+ * - A lost spill file fails the build, a truncated file fails to open
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include "graphlib.hpp"
+#include "graphlib/external.hpp"
+
+int main() {
+    using Id = ExternalGraph::Id;
+    const std::string path = "build/test16.graph";
+
+    // Three components: a random graph on 0..5999, a path on 6000..6999,
+    // and isolated vertices 7000..7099
+    const Id n = 7100;
+    std::vector<std::pair<Id, Id>> edges;
+    unsigned x = 3;
+    auto next = [&](Id bound) { x = x * 1103515245u + 12345u; return (x >> 8) % bound; };
+    for (int i = 0; i < 30000; i++) edges.emplace_back(next(6000), next(6000));
+    for (Id v = 6000; v + 1 < 7000; v++) edges.emplace_back(v, v + 1);
+    edges.emplace_back(4, 4);         // Self-loop dropped
+    edges.emplace_back(6001, 6000);   // Duplicate dropped
+
+    Graph<int> reference;
+    for (Id v = 0; v < n; v++) reference.addVertex(static_cast<int>(v));
+    for (const auto& [u, v] : edges) reference.addEdge(static_cast<int>(u), static_cast<int>(v));
+
+    // =========================================================================
+    // TEST 1: Build with a 32 KB budget
+    // =========================================================================
+    const std::size_t budget = 32 * 1024;
+    IoStats buildStats;
+    assert(ExternalGraph::build(path, n, edges, budget, &buildStats) && "Build should succeed");
+    auto opened = ExternalGraph::open(path);
+    assert(opened && "The file should open");
+    ExternalGraph& g = *opened;
+
+    assert(g.countVertices() == n && g.countEdges() == reference.countEdges() && "Sizes should match Graph");
+    assert(g.countPartitions() > 10 && "A low budget should create many partitions");
+    assert(g.maxPartitionBytes() <= budget && "Every partition should fit the budget");
+    assert(buildStats.bytesWritten > 0 && buildStats.bytesRead > 0 && "Temporary files should have been used");
+    assert(!std::fopen((path + ".tmp0").c_str(), "rb") && "Temporary files should be removed");
+    assert(!ExternalGraph::open("build/missing.graph") && "Missing files are reported");
+    std::cout << "TEST 1 PASSED: Build under a " << budget << " byte budget, "
+              << g.countPartitions() << " partitions" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Streaming neighbor lists
+    // =========================================================================
+    Id expectedVertex = 0;
+    bool listsMatch = true;
+    assert(g.scan([&](Id v, std::span<const Id> nbrs) {
+        listsMatch = listsMatch && v == expectedVertex++ && nbrs.size() == reference.degree(static_cast<int>(v))
+                  && std::is_sorted(nbrs.begin(), nbrs.end());
+        for (Id w : nbrs) listsMatch = listsMatch && reference.containsEdge(static_cast<int>(v), static_cast<int>(w));
+    }) && "Scan should succeed");
+    assert(listsMatch && expectedVertex == n && "Every list should match Graph, sorted and in vertex order");
+    std::cout << "TEST 2 PASSED: Streaming scan" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Semi-external BFS
+    // =========================================================================
+    g.resetIoStats();
+    auto dist = g.bfs(6000);
+    assert(dist.size() == n && "One distance per vertex");
+    for (Id v = 0; v < n; v++) {
+        auto d = reference.distance(6000, static_cast<int>(v));
+        assert((d ? static_cast<Id>(*d) : ExternalGraph::unreachable) == dist[v] && "Distances should match Graph");
+    }
+    // The path component lives in few partitions: most are never loaded
+    const IoStats bfsStats = g.ioStats();
+    assert(bfsStats.passes == 1000 && "One pass per level of the 1000-vertex path");
+    assert(bfsStats.partitionLoads < bfsStats.passes * g.countPartitions() / 4 && "Inactive partitions are skipped");
+
+    dist = g.bfs(17);
+    for (Id v = 0; v < 6000; v += 7) {
+        auto d = reference.distance(17, static_cast<int>(v));
+        assert((d ? static_cast<Id>(*d) : ExternalGraph::unreachable) == dist[v] && "Distances should match Graph");
+    }
+    assert(g.bfs(n).empty() && "Invalid source gives an empty result");
+    std::cout << "TEST 3 PASSED: Semi-external BFS (" << bfsStats.bytesRead << " bytes read)" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Semi-external connected components
+    // =========================================================================
+    g.resetIoStats();
+    auto label = g.connectedComponents();
+    assert(g.ioStats().passes == 1 && g.ioStats().partitionLoads == g.countPartitions() && "Exactly one pass");
+    for (Id v = 0; v < n; v++) {
+        Id expected = v;
+        for (int w : reference.bfs(static_cast<int>(v), 0)) expected = std::min(expected, static_cast<Id>(w));
+        assert(label[v] == expected && "Label should be the smallest id of the component");
+        if (v == 50) v = 5990; // The random component is checked on a sample
+    }
+    assert(label[6500] == 6000 && label[7050] == 7050 && "Path and isolated vertices labeled correctly");
+    std::cout << "TEST 4 PASSED: Connected components" << std::endl;
+
+    // =========================================================================
+    // TEST 5: I/O failures are reported
+    // =========================================================================
+    // The second pass over the source runs after the spill files were
+    // written; losing one must fail the build instead of corrupting the file
+    int passes = 0;
+    const std::string lost = "build/test16_lost.graph";
+    bool built = ExternalGraph::build(lost, n, [&](auto&& emit) {
+        for (const auto& [u, v] : edges) emit(u, v);
+        if (++passes == 2) std::remove((lost + ".tmp0").c_str());
+    }, budget);
+    assert(passes == 2 && !built && "A missing spill file fails the build");
+    std::remove(lost.c_str());
+
+    // Every prefix of a valid file is rejected
+    std::FILE* whole = std::fopen(path.c_str(), "rb");
+    std::vector<char> bytes(1 << 20);
+    bytes.resize(std::fread(bytes.data(), 1, bytes.size(), whole));
+    std::fclose(whole);
+    assert(bytes.size() < (1 << 20) && "The whole file should have been read");
+    const std::string truncated = "build/test16_truncated.graph";
+    for (std::size_t keep : {std::size_t{0}, std::size_t{20}, std::size_t{40}, bytes.size() / 2, bytes.size() - 1}) {
+        std::FILE* f = std::fopen(truncated.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, keep, f);
+        std::fclose(f);
+        assert(!ExternalGraph::open(truncated) && "A truncated file fails to open");
+    }
+    std::remove(truncated.c_str());
+    std::cout << "TEST 5 PASSED: I/O failures are reported" << std::endl;
+
+    std::remove(path.c_str());
+    std::cout << "\n=== All out-of-core graph tests passed ===" << std::endl;
+    return 0;
+}
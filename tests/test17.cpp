@@ -0,0 +1,168 @@
+/**
+ * @file test17.cpp
+ * @brief Test suite for the directed graph
+ *
+ * This test validates:
+ * - Directed edges, out/in neighbors and degrees, removals keeping both
+ *   directions consistent
+ * - The variant without in-edge index behaves the same and allocates less
+ * - Directed bfs and distance only follow edges forward
+ * - Iterative SCC matches mutual reachability and survives a long path
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <set>
+#include "graphlib/digraph.hpp"
+
+// Counting allocator: every global allocation stores its size in a header
+static long long liveBytes = 0;
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size + 16);
+    if (!p) throw std::bad_alloc();
+    *static_cast<std::size_t*>(p) = size;
+    liveBytes += static_cast<long long>(size);
+    return static_cast<char*>(p) + 16;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    void* base = static_cast<char*>(p) - 16;
+    liveBytes -= static_cast<long long>(*static_cast<std::size_t*>(base));
+    std::free(base);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+// Canonical form of a component list, for comparisons
+static std::set<std::set<int>> canonical(const std::vector<std::vector<int>>& components) {
+    std::set<std::set<int>> res;
+    for (const auto& c : components) res.emplace(c.begin(), c.end());
+    return res;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Directed edges and both adjacency directions
+    // =========================================================================
+    DiGraph<int> g;
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(3, 2);
+    g.addEdge(1, 2);   // Duplicate ignored
+    g.addEdge(4, 4);   // Self-loop ignored
+    assert(g.containsEdge(1, 2) && !g.containsEdge(2, 1) && "Edges are directed");
+    assert(g.countVertices() == 3 && g.countEdges() == 3 && "Self-loops create no vertex, edges are counted once");
+    assert(g.outDegree(1) == 2 && g.inDegree(1) == 0 && "Vertex 1 is a source");
+    assert(g.inDegree(2) == 2 && g.outDegree(2) == 0 && "Vertex 2 is a sink");
+    assert((g.inNeighbors(2) == std::unordered_set<int>{1, 3}) && "In-neighbors of 2");
+    assert(g.outNeighbors(42).empty() && g.inNeighbors(42).empty() && "Missing vertex has no neighbors");
+
+    g.addEdge(2, 1);
+    assert(g.containsEdge(1, 2) && g.containsEdge(2, 1) && "Opposite edges are distinct");
+    g.removeEdge(1, 2);
+    assert(!g.containsEdge(1, 2) && g.containsEdge(2, 1) && g.inDegree(2) == 1 && "Only 1 -> 2 removed");
+    g.removeVertex(3);
+    assert(!g.containsVertex(3) && g.outDegree(1) == 0 && g.inDegree(2) == 0 && "Edges of 3 removed both ways");
+    assert((g.edges() == std::unordered_set<std::pair<int, int>>{{2, 1}}) && "Only 2 -> 1 is left");
+    std::cout << "TEST 1 PASSED: Directed edges, in/out adjacency" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Without in-edge index
+    // =========================================================================
+    unsigned x = 5;
+    auto next = [&] { x = x * 1103515245u + 12345u; return static_cast<int>((x >> 8) % 3000); };
+    std::vector<std::pair<int, int>> edges(30000);
+    for (auto& e : edges) e = {next(), next()};
+
+    long long before = liveBytes;
+    auto* both = new DiGraph<int>;
+    for (const auto& [u, v] : edges) both->addEdge(u, v);
+    const long long bothBytes = liveBytes - before;
+    before = liveBytes;
+    auto* outOnly = new DiGraph<int, std::hash<int>, false>;
+    for (const auto& [u, v] : edges) outOnly->addEdge(u, v);
+    const long long outBytes = liveBytes - before;
+
+    assert(both->edges() == outOnly->edges() && "Both variants store the same edges");
+    assert(outBytes * 10 < bothBytes * 7 && "Dropping the in-edge index should save at least 30%");
+    for (int v = 0; v < 3000; v += 10) {
+        both->removeVertex(v);
+        outOnly->removeVertex(v);
+    }
+    assert(both->edges() == outOnly->edges() && "removeVertex should also match");
+    for (const auto& [u, v] : both->edges()) {
+        assert(both->inNeighbors(v).contains(u) && "In-edge index should stay consistent");
+    }
+    std::cout << "TEST 2 PASSED: Out-only variant (" << outBytes << " vs " << bothBytes << " bytes)" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Directed traversals
+    // =========================================================================
+    // 0 -> 1 -> 2 -> 3, 0 -> 4 -> 3, 5 -> 0
+    DiGraph<int, std::hash<int>, false> d;
+    d.addEdge(0, 1); d.addEdge(1, 2); d.addEdge(2, 3);
+    d.addEdge(0, 4); d.addEdge(4, 3); d.addEdge(5, 0);
+    assert(d.distance(0, 3) == 2 && "Shortest path 0 -> 4 -> 3");
+    assert(!d.distance(3, 0) && "No path against the edges");
+    assert(d.distance(5, 3) == 3 && d.distance(2, 2) == 0 && "Distances from 5 and to itself");
+    auto order = d.bfs(0);
+    assert(order.size() == 5 && order[0] == 0 && "5 is not reachable from 0");
+    assert(std::set<int>(order.begin() + 1, order.begin() + 3) == std::set<int>({1, 4}) && "Depth 1 first");
+    assert(d.bfs(0, 2).size() == 2 && d.bfs(42).empty() && "Bounded and missing-start BFS");
+    std::cout << "TEST 3 PASSED: Directed BFS and distance" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Strongly connected components
+    // =========================================================================
+    // Cycles {0, 1, 2} and {3, 4}, linked 2 -> 3, plus the single vertex 5
+    DiGraph<int> s;
+    s.addEdge(0, 1); s.addEdge(1, 2); s.addEdge(2, 0);
+    s.addEdge(2, 3); s.addEdge(3, 4); s.addEdge(4, 3);
+    s.addVertex(5);
+    auto comps = s.stronglyConnectedComponents();
+    assert(canonical(comps) == std::set<std::set<int>>({{0, 1, 2}, {3, 4}, {5}}) && "Three components");
+    std::size_t first = 0, second = 0;
+    for (std::size_t i = 0; i < comps.size(); i++) {
+        if (comps[i][0] == 3 || comps[i][0] == 4) first = i;
+        if (comps[i].size() == 3) second = i;
+    }
+    assert(first < second && "Reverse topological order: {3, 4} before {0, 1, 2}");
+
+    // Against mutual reachability on a random graph
+    DiGraph<int> r;
+    for (int i = 0; i < 300; i++) r.addEdge(next() % 120, next() % 120);
+    std::vector<std::set<int>> reach(120);
+    for (int v = 0; v < 120; v++) {
+        for (int w : r.bfs(v)) reach[v].insert(w);
+    }
+    std::size_t covered = 0;
+    for (const auto& c : r.stronglyConnectedComponents()) {
+        covered += c.size();
+        for (int u : c) {
+            for (int v : c) assert(reach[u].contains(v) && "Vertices of a component reach each other");
+            for (int v : reach[u]) {
+                if (reach[v].contains(u)) assert(std::find(c.begin(), c.end(), v) != c.end() && "Components are maximal");
+            }
+        }
+    }
+    assert(covered == r.countVertices() && "Every vertex is in exactly one component");
+
+    // A 10^6 vertex cycle: one component, found without recursion
+    DiGraph<int, std::hash<int>, false> cycle;
+    const int len = 1000000;
+    for (int i = 0; i < len; i++) cycle.addEdge(i, (i + 1) % len);
+    auto big = cycle.stronglyConnectedComponents();
+    assert(big.size() == 1 && big[0].size() == static_cast<std::size_t>(len) && "The cycle is one component");
+    std::cout << "TEST 4 PASSED: Strongly connected components" << std::endl;
+
+    delete both;
+    delete outOnly;
+    std::cout << "\n=== All directed graph tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file test18.cpp
+ * @brief Test suite for vertex and edge property columns
+ *
+ * This test validates:
+ * - VertexColumn holds one value per dense id
+ * - EdgeColumn keeps both slots of an edge in sync and reports missing edges
+ * - of(u) is aligned with neighbors(u), so a traversal filtered on an edge
+ *   property matches a BFS on the graph with the filtered edges removed
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "graphlib/properties.hpp"
+
+int main() {
+    using Id = CSRGraph<int>::Id;
+
+    // =========================================================================
+    // TEST 1: Vertex columns
+    // =========================================================================
+    Graph<std::string> named;
+    named.addEdge("a", "b");
+    named.addEdge("b", "c");
+    CSRGraph<std::string> csr(named);
+    VertexColumn<std::string> label(csr, "none");
+    assert(label.size() == 3 && label[csr.id("a")] == "none" && "One default value per vertex");
+    label[csr.id("b")] = "hub";
+    assert(label[csr.id("b")] == "hub" && label.data().size() == 3 && "Values are addressed by id");
+    std::cout << "TEST 1 PASSED: Vertex columns" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Edge columns, both directions
+    // =========================================================================
+    auto g = CSRGraph<int>::fromEdgeList(5, {{0, 1}, {0, 2}, {1, 2}, {2, 3}});
+    EdgeColumn weight(g, 1.0);
+    static_assert(std::is_same_v<decltype(weight), EdgeColumn<double, int>>, "Deduced from the graph and value");
+    assert(weight.size() == 8 && "Two slots per edge");
+    assert(weight.set(2, 0, 4.5) && "Existing edge");
+    assert(weight.get(0, 2) == 4.5 && weight.get(2, 0) == 4.5 && "Both directions see the value");
+    assert(!weight.set(0, 3, 2.0) && !weight.get(3, 4) && "Missing edges are reported");
+    assert(weight[*weight.slot(0, 2)] == 4.5 && !weight.slot(4, 0) && "Slots address values directly");
+
+    auto nbrs = g.neighbors(0);
+    auto values = weight.of(0);
+    assert(values.size() == nbrs.size() && "of(u) is aligned with neighbors(u)");
+    for (std::size_t k = 0; k < nbrs.size(); k++) {
+        assert(values[k] == (nbrs[k] == 2 ? 4.5 : 1.0) && "Value k is the edge to neighbor k");
+    }
+    std::cout << "TEST 2 PASSED: Edge columns" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Traversal filtered on an edge property
+    // =========================================================================
+    std::vector<std::pair<Id, Id>> edges;
+    unsigned x = 11;
+    auto next = [&](unsigned bound) { x = x * 1103515245u + 12345u; return (x >> 8) % bound; };
+    for (int i = 0; i < 4000; i++) edges.emplace_back(next(1000), next(1000));
+    auto big = CSRGraph<int>::fromEdgeList(1000, edges);
+    EdgeColumn<unsigned, int> timestamp(big);
+    Graph<int> recent; // Only the edges with timestamp >= 50
+    for (Id u = 0; u < 1000; u++) {
+        recent.addVertex(static_cast<int>(u));
+        for (Id v : big.neighbors(u)) {
+            if (u >= v) continue;
+            const unsigned t = next(100);
+            timestamp.set(u, v, t);
+            if (t >= 50) recent.addEdge(static_cast<int>(u), static_cast<int>(v));
+        }
+    }
+
+    std::vector<bool> seen(1000, false);
+    std::vector<Id> order{0};
+    seen[0] = true;
+    for (std::size_t head = 0; head < order.size(); head++) {
+        const Id u = order[head];
+        for (std::size_t s = big.offset(u); s < big.offset(u + 1); s++) {
+            if (timestamp[s] < 50 || seen[big.target(s)]) continue;
+            seen[big.target(s)] = true;
+            order.push_back(big.target(s));
+        }
+    }
+    assert(order.size() == recent.bfs(0).size() && "Filtered traversal reaches the same vertices");
+    for (Id v : order) assert(recent.distance(0, static_cast<int>(v)) && "Every reached vertex is connected by recent edges");
+    std::cout << "TEST 3 PASSED: Filtered traversal (" << order.size() << " vertices)" << std::endl;
+
+    std::cout << "\n=== All property column tests passed ===" << std::endl;
+    return 0;
+}
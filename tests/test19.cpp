@@ -0,0 +1,125 @@
+/**
+ * @file test19.cpp
+ * @brief Test suite for pair/integer hashing and transparent string lookups
+ *
+ * This test validates:
+ * - The pair hash spreads sequential integer pairs evenly over the buckets
+ * - IntegerHash spreads strided ids that std::hash maps to few buckets
+ * - Graph<std::string, graphlib::StringHash> answers containsVertex,
+ *   containsEdge, degree and neighbors for std::string_view and const char*
+ *   keys without allocating, and behaves like Graph<std::string> otherwise
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "graphlib.hpp"
+#include "graphlib/csr.hpp"
+#include "graphlib/mutation_batch.hpp"
+
+// Counting allocator: number of global allocations
+static long long allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// Largest number of keys sharing one bucket
+template<typename Set>
+static std::size_t maxBucket(const Set& set) {
+    std::size_t res = 0;
+    for (std::size_t b = 0; b < set.bucket_count(); b++) res = std::max(res, set.bucket_size(b));
+    return res;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Pair hash on sequential ids
+    // =========================================================================
+    // Edges of a 300 x 300 grid, as edges() returns them
+    std::unordered_set<std::pair<int, int>> grid;
+    for (int i = 0; i < 300 * 300; i++) {
+        if (i % 300 != 299) grid.emplace(i, i + 1);
+        if (i + 300 < 300 * 300) grid.emplace(i, i + 300);
+    }
+    std::size_t used = 0;
+    for (std::size_t b = 0; b < grid.bucket_count(); b++) used += grid.bucket_size(b) > 0;
+    std::cout << "grid pairs: " << grid.size() << " in " << used << " of " << grid.bucket_count()
+              << " buckets, max " << maxBucket(grid) << std::endl;
+    assert(maxBucket(grid) <= 12 && "No bucket should collect many pairs");
+    const double load = static_cast<double>(grid.size()) / grid.bucket_count();
+    const double randomUsed = grid.bucket_count() * (1 - std::exp(-load)); // Expected for a random hash
+    assert(used >= 0.95 * randomUsed && "Buckets should be used as evenly as with a random hash");
+    const std::hash<std::pair<int, int>> pairHash;
+    assert(pairHash(std::pair{1, 2}) != pairHash(std::pair{2, 1}) && "Order matters");
+    std::cout << "TEST 1 PASSED: Pair hash distribution" << std::endl;
+
+    // =========================================================================
+    // TEST 2: IntegerHash on strided ids
+    // =========================================================================
+    std::unordered_set<long long, graphlib::IntegerHash<long long>> strided;
+    strided.max_load_factor(1.0f);
+    strided.rehash(1 << 12); // Fixed bucket count, so the stride is what matters
+    for (long long i = 0; i < 4000; i++) strided.insert(i * strided.bucket_count());
+    assert(maxBucket(strided) <= 10 && "Multiples of the bucket count are spread by the mixer");
+    assert(graphlib::hashMix(1) != graphlib::hashMix(2) && graphlib::hashMix(0) == 0 && "Mixer is a bijection fixing 0");
+    Graph<int, graphlib::IntegerHash<int>> mixed;
+    mixed.addEdge(1, 2);
+    assert(mixed.containsEdge(2, 1) && mixed.degree(1) == 1 && "Graph accepts IntegerHash");
+    std::cout << "TEST 2 PASSED: IntegerHash" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Transparent string lookups
+    // =========================================================================
+    static_assert(Graph<std::string, graphlib::StringHash>::heterogeneousLookup, "StringHash is transparent");
+    static_assert(!Graph<std::string>::heterogeneousLookup, "std::hash<std::string> is not");
+    static_assert(std::is_same_v<Graph<int>::NeighborSet, std::unordered_set<int>>, "Default sets are unchanged");
+
+    Graph<std::string, graphlib::StringHash> g;
+    Graph<std::string> plain;
+    const std::string prefix = "a vertex name longer than SSO #";
+    for (int i = 0; i < 100; i++) {
+        g.addEdge(prefix + std::to_string(i), prefix + std::to_string((i + 1) % 100));
+        plain.addEdge(prefix + std::to_string(i), prefix + std::to_string((i + 1) % 100));
+    }
+    const std::string name5 = prefix + "5", name6 = prefix + "6";
+    const std::string_view v5 = name5, v6 = name6;
+
+    long long before = allocations;
+    bool ok = g.containsVertex(v5) && g.containsEdge(v5, v6) && g.containsEdge(name5, v6)
+           && g.degree(v5) == 2 && g.neighbors(v6).contains(v5) && !g.containsVertex("missing")
+           && !g.containsEdge(v5, v5) && g.degree("missing") == 0 && g.neighbors("missing").empty();
+    assert(ok && "Lookups by string_view and const char* should work");
+    assert(allocations == before && "Transparent lookups should not allocate");
+
+    before = allocations;
+    ok = plain.containsVertex(std::string(v5)) && plain.containsEdge(std::string(v5), std::string(v6));
+    assert(ok && allocations == before + 3 && "Default hash needs a std::string per key");
+
+    // The rest of the library accepts the transparent graph
+    CSRGraph<std::string, graphlib::StringHash> csr(g);
+    assert(csr.countEdges() == 100 && csr.degree(csr.id(name5)) == 2 && "CSR snapshot of a transparent graph");
+    MutationBatch<std::string, graphlib::StringHash> batch;
+    batch.removeVertex(name5);
+    batch.addEdge(name5, "x");
+    batch.applyTo(g);
+    assert(g.containsEdge("x", v5) && g.degree(v5) == 1 && g.countEdges() == 99 && "Batches apply to a transparent graph");
+    std::cout << "TEST 3 PASSED: Transparent string lookups" << std::endl;
+
+    std::cout << "\n=== All hashing tests passed ===" << std::endl;
+    return 0;
+}
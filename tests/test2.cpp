@@ -14,8 +14,13 @@
 #include <cassert>
 #include "graphlib.hpp"
 
+// Graph type under test; the Makefile also builds this file against DenseGraph
+#ifndef GRAPH_TYPE
+#define GRAPH_TYPE Graph<int>
+#endif
+
 int main() {
-    Graph<int> g;
+    GRAPH_TYPE g;
 
     // =========================================================================
     // SETUP: Build a 4x3 grid graph
@@ -54,7 +59,7 @@ int main() {
     // =========================================================================
     std::unordered_set<int> verticesFromExplicitIterator;
 
-    for (Graph<int>::iterator it = g.begin(); it != g.end(); ++it) {
+    for (GRAPH_TYPE::iterator it = g.begin(); it != g.end(); ++it) {
         verticesFromExplicitIterator.insert(*it);
     }
 
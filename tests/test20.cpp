@@ -0,0 +1,152 @@
+/**
+ * @file test20.cpp
+ * @brief Test suite for graph coloring and maximal independent sets
+ *
+ * This test validates:
+ * - Coloring orders are permutations; smallest-last is a degeneracy order
+ * - greedyColoring is proper and meets the known bounds (trees, grids,
+ *   cliques, degeneracy + 1)
+ * - parallelColoring is proper and identical for every thread count
+ * - maximalIndependentSet is independent, maximal and thread-count independent
+ */
+
+#include <iostream>
+#include <cassert>
+#include "graphlib/coloring.hpp"
+
+using Id = CSRGraph<int>::Id;
+
+static bool proper(const CSRGraph<int>& g, const std::vector<Color>& colors) {
+    for (Id v = 0; v < g.countVertices(); v++) {
+        for (Id w : g.neighbors(v)) {
+            if (colors[v] == colors[w]) return false;
+        }
+    }
+    return true;
+}
+
+static Color countColors(const std::vector<Color>& colors) {
+    return colors.empty() ? 0 : *std::max_element(colors.begin(), colors.end()) + 1;
+}
+
+// Degeneracy by repeatedly removing a vertex of minimum degree, O(n^2)
+static std::size_t naiveDegeneracy(const CSRGraph<int>& g) {
+    const std::size_t n = g.countVertices();
+    std::vector<std::size_t> degree(n);
+    std::vector<bool> gone(n, false);
+    for (Id v = 0; v < n; v++) degree[v] = g.degree(v);
+    std::size_t res = 0;
+    for (std::size_t step = 0; step < n; step++) {
+        Id best = 0;
+        for (Id v = 0; v < n; v++) {
+            if (!gone[v] && (gone[best] || degree[v] < degree[best])) best = v;
+        }
+        res = std::max(res, degree[best]);
+        gone[best] = true;
+        for (Id w : g.neighbors(best)) degree[w]--;
+    }
+    return res;
+}
+
+int main() {
+    unsigned x = 17;
+    auto next = [&](unsigned bound) { x = x * 1103515245u + 12345u; return static_cast<Id>((x >> 8) % bound); };
+
+    std::vector<std::pair<Id, Id>> randomEdges;
+    for (int i = 0; i < 6000; i++) randomEdges.emplace_back(next(1500), next(1500));
+    for (Id v = 0; v < 40; v++) {
+        for (Id w = v + 1; w < 40; w++) randomEdges.emplace_back(v, w); // A 40-clique
+    }
+    const auto g = CSRGraph<int>::fromEdgeList(1500, randomEdges);
+
+    // =========================================================================
+    // TEST 1: Coloring orders
+    // =========================================================================
+    for (auto kind : {ColoringOrder::Natural, ColoringOrder::LargestFirst, ColoringOrder::SmallestLast}) {
+        auto order = coloringOrder(g, kind);
+        std::vector<Id> sorted = order;
+        std::sort(sorted.begin(), sorted.end());
+        for (Id v = 0; v < sorted.size(); v++) assert(sorted[v] == v && "Orders are permutations");
+    }
+    auto largest = coloringOrder(g, ColoringOrder::LargestFirst);
+    for (std::size_t i = 1; i < largest.size(); i++) {
+        assert(g.degree(largest[i - 1]) >= g.degree(largest[i]) && "Largest-first sorts by decreasing degree");
+    }
+
+    // In a smallest-last order, no vertex has more than degeneracy earlier neighbors
+    auto smallest = coloringOrder(g, ColoringOrder::SmallestLast);
+    std::vector<std::size_t> rank(g.countVertices());
+    for (std::size_t i = 0; i < smallest.size(); i++) rank[smallest[i]] = i;
+    std::size_t backDegree = 0;
+    for (Id v = 0; v < g.countVertices(); v++) {
+        std::size_t earlier = 0;
+        for (Id w : g.neighbors(v)) earlier += rank[w] < rank[v];
+        backDegree = std::max(backDegree, earlier);
+    }
+    const std::size_t degeneracy = naiveDegeneracy(g);
+    assert(degeneracy == 39 && backDegree == degeneracy && "Smallest-last is a degeneracy order");
+    std::cout << "TEST 1 PASSED: Coloring orders (degeneracy " << degeneracy << ")" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Greedy coloring
+    // =========================================================================
+    for (auto kind : {ColoringOrder::Natural, ColoringOrder::LargestFirst, ColoringOrder::SmallestLast}) {
+        auto colors = greedyColoring(g, kind);
+        assert(proper(g, colors) && countColors(colors) <= g.maxDegree() + 1 && "Greedy coloring is proper");
+        assert(countColors(colors) >= 40 && "The clique needs 40 colors");
+    }
+    assert(countColors(greedyColoring(g)) == 40 && "Smallest-last uses degeneracy + 1 colors here");
+
+    std::vector<std::pair<Id, Id>> treeEdges, gridEdges;
+    for (Id v = 1; v < 1000; v++) treeEdges.emplace_back(v, next(v));
+    for (Id r = 0; r < 30; r++) {
+        for (Id c = 0; c < 30; c++) {
+            if (c + 1 < 30) gridEdges.emplace_back(r * 30 + c, r * 30 + c + 1);
+            if (r + 1 < 30) gridEdges.emplace_back(r * 30 + c, (r + 1) * 30 + c);
+        }
+    }
+    const auto tree = CSRGraph<int>::fromEdgeList(1000, treeEdges);
+    const auto grid = CSRGraph<int>::fromEdgeList(900, gridEdges);
+    assert(countColors(greedyColoring(tree)) == 2 && "Trees are 1-degenerate: 2 colors");
+    assert(countColors(greedyColoring(grid)) <= 3 && proper(grid, greedyColoring(grid)) && "Grids are 2-degenerate");
+    std::vector<Id> custom = {5, 4, 3, 2, 1, 0};
+    auto path = CSRGraph<int>::fromEdgeList(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}});
+    assert((greedyColoring(path, std::span<const Id>(custom)) == std::vector<Color>{1, 0, 1, 0, 1, 0}) && "Explicit order");
+    std::cout << "TEST 2 PASSED: Greedy coloring" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Parallel coloring
+    // =========================================================================
+    auto reference = parallelColoring(g, 7, 1);
+    assert(proper(g, reference) && countColors(reference) <= g.maxDegree() + 1 && "Jones-Plassmann is proper");
+    for (std::size_t threads : {2, 4, 8}) {
+        assert(parallelColoring(g, 7, threads) == reference && "Same coloring for every thread count");
+    }
+    assert(proper(tree, parallelColoring(tree, 1, 4)) && proper(grid, parallelColoring(grid, 1, 4)) && "Other graphs");
+    assert(parallelColoring(CSRGraph<int>::fromEdgeList(0, {}), 1, 4).empty() && "Empty graph");
+    std::cout << "TEST 3 PASSED: Parallel coloring (" << countColors(reference) << " colors)" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Maximal independent set
+    // =========================================================================
+    auto mis = maximalIndependentSet(g, 3, 1);
+    std::vector<bool> member(g.countVertices(), false);
+    for (Id v : mis) member[v] = true;
+    for (Id v = 0; v < g.countVertices(); v++) {
+        bool dominated = member[v];
+        for (Id w : g.neighbors(v)) {
+            assert(!(member[v] && member[w]) && "Independent: no edge inside the set");
+            dominated = dominated || member[w];
+        }
+        assert(dominated && "Maximal: every vertex is in the set or next to it");
+    }
+    assert(std::is_sorted(mis.begin(), mis.end()) && "Ids in increasing order");
+    for (std::size_t threads : {2, 4, 8}) {
+        assert(maximalIndependentSet(g, 3, threads) == mis && "Same set for every thread count");
+    }
+    assert(maximalIndependentSet(g, 4, 4) != mis && "The seed changes the set");
+    std::cout << "TEST 4 PASSED: Maximal independent set (" << mis.size() << " vertices)" << std::endl;
+
+    std::cout << "\n=== All coloring tests passed ===" << std::endl;
+    return 0;
+}
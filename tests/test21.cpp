@@ -0,0 +1,116 @@
+/**
+ * @file test21.cpp
+ * @brief Test suite for the work-stealing pool and parallel vertex/edge iteration
+ *
+ * This test validates:
+ * - parallelTasks runs every task exactly once, also with very uneven tasks
+ * - Graph::forEachVertex/forEachEdge visit every vertex and every edge
+ *   exactly once, hubs split across tasks included
+ * - CSRGraph::forEachVertex/forEachEdge do the same on dense ids
+ * - Callbacks with and without the worker argument are accepted
+ */
+
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include "graphlib.hpp"
+#include "graphlib/csr.hpp"
+
+int main() {
+    // =========================================================================
+    // TEST 1: Work-stealing pool
+    // =========================================================================
+    for (std::size_t threads : {1, 3, 8}) {
+        std::vector<std::atomic<int>> runs(5000);
+        std::atomic<std::size_t> maxWorker{0};
+        graphlib::parallelTasks(runs.size(), threads, [&](std::size_t t, std::size_t worker) {
+            if (t < 8) { // A few expensive tasks at the front of the first block
+                volatile std::size_t spin = 0;
+                for (std::size_t i = 0; i < 2000000; i++) spin = spin + i;
+            }
+            runs[t]++;
+            std::size_t seen = maxWorker.load();
+            while (worker > seen && !maxWorker.compare_exchange_weak(seen, worker)) {}
+        });
+        for (const auto& r : runs) assert(r == 1 && "Every task runs exactly once");
+        assert(maxWorker < threads && "Worker ids are below the thread count");
+    }
+    graphlib::parallelTasks(0, 4, [](std::size_t, std::size_t) { assert(false && "No task to run"); });
+    std::cout << "TEST 1 PASSED: Work-stealing pool" << std::endl;
+
+    // Power-law-like graph: a star with 20000 leaves plus a random part
+    Graph<int> g;
+    for (int i = 1; i <= 20000; i++) g.addEdge(0, i);
+    unsigned x = 9;
+    auto next = [&] { x = x * 1103515245u + 12345u; return static_cast<int>((x >> 8) % 30000); };
+    for (int i = 0; i < 60000; i++) g.addEdge(next(), next());
+    const auto expectedEdges = g.edges();
+
+    // =========================================================================
+    // TEST 2: Graph::forEachVertex
+    // =========================================================================
+    for (std::size_t threads : {1, 4}) {
+        std::vector<std::vector<int>> perWorker(threads);
+        g.forEachVertex({.threads = threads}, [&](int v, std::size_t worker) { perWorker[worker].push_back(v); });
+        std::vector<int> all;
+        for (const auto& list : perWorker) all.insert(all.end(), list.begin(), list.end());
+        std::sort(all.begin(), all.end());
+        assert(all.size() == g.countVertices() && std::adjacent_find(all.begin(), all.end()) == all.end() && "Each vertex once");
+        assert(std::all_of(all.begin(), all.end(), [&](int v) { return g.containsVertex(v); }) && "Only vertices");
+    }
+    std::atomic<std::size_t> degreeSum{0};
+    g.forEachVertex({.threads = 4}, [&](int v) { degreeSum += g.degree(v); });
+    assert(degreeSum == 2 * g.countEdges() && "Callback without worker id");
+    std::cout << "TEST 2 PASSED: Graph::forEachVertex" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Graph::forEachEdge, hub split across tasks
+    // =========================================================================
+    for (std::size_t splitDegree : {100, 1000000}) {
+        std::vector<std::vector<std::pair<int, int>>> perWorker(4);
+        g.forEachEdge({.threads = 4, .splitDegree = splitDegree}, [&](int u, int v, std::size_t worker) {
+            perWorker[worker].emplace_back(u, v);
+        });
+        std::size_t total = 0;
+        std::unordered_set<std::pair<int, int>> seen;
+        for (const auto& list : perWorker) {
+            for (const auto& [u, v] : list) {
+                assert(u < v && "Edges are reported with u < v");
+                seen.emplace(u, v);
+                total++;
+            }
+        }
+        assert(total == expectedEdges.size() && seen == expectedEdges && "Each edge exactly once");
+    }
+    std::cout << "TEST 3 PASSED: Graph::forEachEdge" << std::endl;
+
+    // =========================================================================
+    // TEST 4: CSRGraph on dense ids
+    // =========================================================================
+    CSRGraph<int> csr(g);
+    using Id = CSRGraph<int>::Id;
+    for (std::size_t threads : {1, 4}) {
+        std::vector<std::atomic<int>> visits(csr.countVertices());
+        csr.forEachVertex({.threads = threads, .tasksPerThread = 16}, [&](Id v) { visits[v]++; });
+        for (const auto& c : visits) assert(c == 1 && "Each id once");
+
+        std::atomic<std::size_t> edges{0};
+        std::vector<std::atomic<std::size_t>> degree(csr.countVertices());
+        csr.forEachEdge({.threads = threads}, [&](Id u, Id v, std::size_t) {
+            assert(u < v && csr.containsEdge(u, v) && "Real edges with u < v");
+            degree[u]++;
+            degree[v]++;
+            edges++;
+        });
+        assert(edges == csr.countEdges() && "Each edge once");
+        for (Id v = 0; v < csr.countVertices(); v++) assert(degree[v] == csr.degree(v) && "Degrees add up");
+    }
+    CSRGraph<int> empty;
+    empty.forEachEdge({}, [](Id, Id) { assert(false && "No edge"); });
+    empty.forEachVertex({}, [](Id) { assert(false && "No vertex"); });
+    std::cout << "TEST 4 PASSED: CSRGraph::forEachVertex/forEachEdge" << std::endl;
+
+    std::cout << "\n=== All parallel iteration tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,373 @@
+/**
+ * @file test22.cpp
+ * @brief Test suite for the mutation journal
+ *
+ * This test validates:
+ * - Recovery rebuilds the journaled graph, removeVertex and clear included
+ * - Group commit only writes when the buffer fills or on commit()
+ * - A log cut at any byte recovers exactly the records before the cut, and
+ *   reopening it appends after the intact prefix
+ * - A corrupted record ends the replay; a record that passes its checksum
+ *   but does not decode is an error and the log is left untouched
+ * - Compaction into a snapshot, including a crash before the log is truncated
+ *   and a corrupted snapshot header
+ * - A follower tailing the files stays equal to the writer across compactions
+ * - String vertices
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "graphlib.hpp"
+#include "graphlib/journal.hpp"
+
+namespace fs = std::filesystem;
+
+template<typename Vertex>
+static bool sameGraph(const Graph<Vertex>& a, const Graph<Vertex>& b) {
+    if (a.countVertices() != b.countVertices() || a.countEdges() != b.countEdges()) return false;
+    for (const Vertex& v : a) {
+        if (!b.containsVertex(v) || a.degree(v) != b.degree(v)) return false;
+        for (const Vertex& w : a.neighbors(v)) {
+            if (!b.containsEdge(v, w)) return false;
+        }
+    }
+    return true;
+}
+
+static void removeJournal(const std::string& path) {
+    fs::remove(path);
+    fs::remove(path + ".snap");
+}
+
+static std::vector<char> readBytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+static void writeBytes(const std::string& path, const std::vector<char>& bytes, std::size_t size) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(size));
+}
+
+// One mutation of the scripted workload
+struct Step {
+    int kind; // 0: addEdge, 1: removeEdge, 2: addVertex
+    int u, v;
+
+    void applyTo(Graph<int>& g) const {
+        if (kind == 0) g.addEdge(u, v);
+        else if (kind == 1) g.removeEdge(u, v);
+        else g.addVertex(u);
+    }
+};
+
+// Records every mutation reported to observers, as a Step
+struct Recorder : GraphObserver<int> {
+    std::vector<Step> ops;
+    void onAddVertex(const int& v) override { ops.push_back({2, v, v}); }
+    void onAddEdge(const int& u, const int& v) override { ops.push_back({0, u, v}); }
+    void onRemoveEdge(const int& u, const int& v) override { ops.push_back({1, u, v}); }
+};
+
+int main() {
+    using J = Journal<int>;
+    const std::string path = "build/test22.journal";
+
+    // =========================================================================
+    // TEST 1: Recovery rebuilds the graph
+    // =========================================================================
+    removeJournal(path);
+    Graph<int> expected;
+    {
+        Graph<int> g;
+        RecoveryStats stats;
+        auto journal = J::open(path, g, {}, &stats);
+        assert(journal && stats.recordsReplayed == 0 && stats.snapshotSequence == 0 && "A new journal is empty");
+        for (int i = 0; i < 500; i++) g.addEdge(i, (i * 37 + 11) % 500);
+        g.addVertex(1000);
+        g.removeEdge(3, 3 * 37 + 11);
+        g.removeVertex(7);
+        g.clear();
+        for (int i = 0; i < 300; i++) g.addEdge(i, (i * 13 + 5) % 300);
+        g.removeVertex(5);
+        g.addVertex(-1);
+        expected = g;
+    }
+    Graph<int> recovered;
+    auto stats = J::recover(path, recovered);
+    assert(stats && sameGraph(recovered, expected) && "Recovery should rebuild the graph");
+    assert(stats->discardedBytes == 0 && stats->validBytes == fs::file_size(path) && "A clean log is intact");
+    std::cout << "TEST 1 PASSED: Recovery replays " << stats->recordsReplayed << " records" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Group commit
+    // =========================================================================
+    removeJournal(path);
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g, {.groupBytes = 1000});
+        for (int i = 0; i < 10; i++) g.addEdge(i, i + 1);
+        assert(journal->pendingBytes() > 0 && fs::file_size(path) == J::headerBytes && "Records stay buffered");
+        for (int i = 10; i < 100; i++) g.addEdge(i, i + 1);
+        assert(fs::file_size(path) > J::headerBytes && journal->pendingBytes() < 1000 && "A full buffer is written");
+        assert(journal->commit() && journal->pendingBytes() == 0 && "commit() writes the rest");
+        assert(fs::file_size(path) == journal->logSize() && "The committed size is on disk");
+        assert(journal->sequenceNumber() == 100 + 101 && "One record per edge and per new vertex");
+    }
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g, {.groupBytes = 0});
+        assert(g.countEdges() == 100 && journal->sequenceNumber() == 201 && "Reopening recovers the graph");
+        g.addEdge(500, 501);
+        assert(journal->pendingBytes() == 0 && fs::file_size(path) == journal->logSize() && "groupBytes = 0 commits each record");
+    }
+    std::cout << "TEST 2 PASSED: Group commit" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Torn tails
+    // =========================================================================
+    removeJournal(path);
+    std::vector<Step> steps;
+    for (int i = 0; i < 60; i++) steps.push_back({i % 5 == 4 ? 1 : (i % 7 == 6 ? 2 : 0), i % 13, (i * 5 + 1) % 17});
+    std::vector<std::uint64_t> ends;     // Log size after each record
+    std::vector<Graph<int>> states;      // states[k] = graph after k records
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g, {.groupBytes = 0});
+        Recorder recorder;
+        g.attach(&recorder);
+        for (const Step& s : steps) s.applyTo(g);
+        g.detach(&recorder);
+        // A step may write several records: the recorder rebuilds every intermediate state,
+        // and records are [length][crc][op] followed by one or two 4-byte vertices
+        ends.push_back(J::headerBytes);
+        states.emplace_back();
+        for (const auto& [kind, u, v] : recorder.ops) {
+            ends.push_back(ends.back() + J::recordHeaderBytes + 1 + (kind == 2 ? 4 : 8));
+            Graph<int> next = states.back();
+            if (kind == 0) next.addEdge(u, v);
+            else if (kind == 1) next.removeEdge(u, v);
+            else next.addVertex(u);
+            states.push_back(std::move(next));
+        }
+        assert(ends.back() == journal->logSize() && "One record per reported mutation");
+    }
+    const auto full = readBytes(path);
+    for (std::size_t cut = 0; cut <= full.size(); cut++) {
+        writeBytes(path, full, cut);
+        Graph<int> g;
+        auto res = J::recover(path, g);
+        assert(res && "A torn log is not an error");
+        std::size_t k = 0;
+        while (k + 1 < ends.size() && ends[k + 1] <= cut) k++;
+        assert(res->recordsReplayed == k && "Exactly the records before the cut are replayed");
+        assert(res->validBytes + res->discardedBytes == cut && "The rest of the log is reported as discarded");
+        assert(sameGraph(g, states[k]) && "The graph of the intact prefix is restored");
+    }
+
+    // Reopening a torn log cuts the tail and appends after the intact prefix
+    const std::size_t cut = static_cast<std::size_t>(ends[20] + 5);
+    writeBytes(path, full, cut);
+    {
+        Graph<int> g;
+        RecoveryStats torn;
+        auto journal = J::open(path, g, {.groupBytes = 0}, &torn);
+        assert(journal && torn.recordsReplayed == 20 && torn.discardedBytes == 5 && "The torn record is dropped");
+        assert(fs::file_size(path) == ends[20] && "The tail is cut off before appending");
+        g.addEdge(900, 901);
+    }
+    {
+        Graph<int> g;
+        auto res = J::recover(path, g);
+        assert(res && res->recordsReplayed == 23 && res->discardedBytes == 0 && g.containsEdge(900, 901)
+               && "Records appended after a torn tail are recovered");
+    }
+    std::cout << "TEST 3 PASSED: Every cut of a " << full.size() << " byte log recovers its intact prefix" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Corruption
+    // =========================================================================
+    {
+        auto bytes = full;
+        bytes[static_cast<std::size_t>(ends[30]) + 10] ^= 0x40; // Inside record 31
+        writeBytes(path, bytes, bytes.size());
+        Graph<int> g;
+        auto res = J::recover(path, g);
+        assert(res && res->recordsReplayed == 30 && res->validBytes == ends[30] && "Replay stops at the bad record");
+        assert(res->discardedBytes == full.size() - ends[30] && "Everything after it is discarded");
+
+        bytes = full;
+        bytes[0] ^= 1;
+        writeBytes(path, bytes, bytes.size());
+        assert(!J::recover(path, g) && "A bad header is an error");
+
+        // A checksummed AddEdge whose second vertex is cut short, followed by committed records
+        const std::uint8_t payload[] = {2, 1, 0, 0, 0, 7};
+        const std::uint32_t frame[2] = {sizeof(payload), graphlib::detail::crc32(payload, sizeof(payload))};
+        bytes.assign(full.begin(), full.begin() + static_cast<std::ptrdiff_t>(ends[30]));
+        bytes.insert(bytes.end(), reinterpret_cast<const char*>(frame), reinterpret_cast<const char*>(frame) + sizeof(frame));
+        bytes.insert(bytes.end(), reinterpret_cast<const char*>(payload), reinterpret_cast<const char*>(payload) + sizeof(payload));
+        bytes.insert(bytes.end(), full.begin() + static_cast<std::ptrdiff_t>(ends[30]), full.end());
+        writeBytes(path, bytes, bytes.size());
+        assert(!J::recover(path, g) && "An intact record that does not decode is an error");
+        assert(!J::open(path, g) && readBytes(path) == bytes && "The committed records after it are kept");
+        Graph<int> replica;
+        assert(!JournalFollower<int>(path).poll(replica) && "The follower reports it too");
+    }
+    std::cout << "TEST 4 PASSED: Corrupted records" << std::endl;
+
+    // =========================================================================
+    // TEST 5: Compaction
+    // =========================================================================
+    removeJournal(path);
+    Graph<int> atCompaction;
+    std::vector<char> logBeforeCompaction;
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g);
+        for (int i = 0; i < 2000; i++) g.addEdge(i % 300, (i * 7 + 3) % 301);
+        for (int i = 0; i < 50; i++) g.removeVertex(i * 3);
+        journal->commit();
+        logBeforeCompaction = readBytes(path);
+        atCompaction = g;
+        assert(journal->compact() && journal->logSize() == J::headerBytes && "Compaction empties the log");
+        for (int i = 0; i < 100; i++) g.addEdge(1000 + i, 2000 + i);
+        expected = g;
+    }
+    stats = J::recover(path, recovered);
+    assert(stats && sameGraph(recovered, expected) && "Snapshot plus log rebuild the graph");
+    assert(stats->recordsReplayed == 3 * 100 && stats->snapshotSequence > 2000 && "Only new records are replayed");
+
+    // Crash after the snapshot is renamed but before the log is truncated
+    writeBytes(path, logBeforeCompaction, logBeforeCompaction.size());
+    stats = J::recover(path, recovered);
+    assert(stats && stats->recordsReplayed == 0 && sameGraph(recovered, atCompaction)
+           && "Records already in the snapshot are skipped");
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g);
+        assert(journal && sameGraph(g, atCompaction) && journal->sequenceNumber() == stats->snapshotSequence);
+        g.addEdge(-5, -6);
+    }
+    stats = J::recover(path, recovered);
+    assert(stats && stats->recordsReplayed == 3 && recovered.containsEdge(-5, -6) && "Appending after skipped records");
+
+    // Automatic compaction
+    removeJournal(path);
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g, {.groupBytes = 1024, .compactBytes = 16 * 1024});
+        for (int i = 0; i < 5000; i++) g.addEdge(i % 97, i % 89 + 100);
+        assert(fs::exists(path + ".snap") && journal->logSize() < 16 * 1024 + 1024 && "The log is compacted as it grows");
+        expected = g;
+    }
+    stats = J::recover(path, recovered);
+    assert(stats && sameGraph(recovered, expected) && stats->snapshotSequence > 0);
+
+    // A corrupted snapshot header is an error, never an exception
+    const std::vector<char> snapshot = readBytes(path + ".snap");
+    for (std::size_t at : {8, 15, 16, 23, 24, 31}) {
+        std::vector<char> corrupted = snapshot;
+        corrupted[at] ^= 0x40;
+        writeBytes(path + ".snap", corrupted, corrupted.size());
+        assert(!J::recover(path, recovered) && "The checksum covers the header");
+    }
+    std::vector<char> forged = snapshot;
+    const std::uint64_t vertices = std::uint64_t{1} << 60;
+    std::memcpy(forged.data() + 16, &vertices, sizeof(vertices));
+    const std::uint32_t crc = graphlib::detail::crc32(reinterpret_cast<const std::uint8_t*>(forged.data()) + 8,
+                                                      forged.size() - 8 - sizeof(std::uint32_t));
+    std::memcpy(forged.data() + forged.size() - sizeof(crc), &crc, sizeof(crc));
+    writeBytes(path + ".snap", forged, forged.size());
+    assert(!J::recover(path, recovered) && "A vertex count larger than the file is rejected before allocating");
+    writeBytes(path + ".snap", snapshot, snapshot.size());
+    assert(J::recover(path, recovered) && sameGraph(recovered, expected));
+
+    // A log starting after a lost snapshot is an error
+    fs::remove(path + ".snap");
+    assert(!J::recover(path, recovered) && "Records before the log are missing");
+    std::cout << "TEST 5 PASSED: Compaction into a snapshot" << std::endl;
+
+    // =========================================================================
+    // TEST 6: Tailing follower
+    // =========================================================================
+    removeJournal(path);
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g, {.groupBytes = 0});
+        Graph<int> replica;
+        JournalFollower<int> follower(path);
+        assert(follower.poll(replica) == 0u && replica.countVertices() == 0 && "Nothing to follow yet");
+
+        for (int i = 0; i < 100; i++) g.addEdge(i, i + 1);
+        assert(follower.poll(replica) == 201u && sameGraph(replica, g) && "New records are applied");
+        g.removeVertex(50);
+        assert(follower.poll(replica) == 3u && sameGraph(replica, g) && "removeVertex is followed");
+        assert(follower.poll(replica) == 0u && "Nothing new");
+
+        // Compaction while the follower is up to date: it continues from the new log
+        g.addEdge(7, 70);
+        assert(follower.poll(replica) == 1u);
+        journal->compact();
+        g.addEdge(8, 80);
+        assert(follower.poll(replica) == 1u && sameGraph(replica, g) && follower.snapshotReloads() == 0);
+
+        // Compaction while the follower is behind: it reloads the snapshot
+        for (int i = 0; i < 20; i++) g.addEdge(300 + i, 400 + i);
+        journal->compact();
+        g.clear();
+        g.addEdge(1, 2);
+        assert(follower.poll(replica) && sameGraph(replica, g) && follower.snapshotReloads() == 1);
+        assert(follower.sequenceNumber() == journal->sequenceNumber() && "Both are at the same record");
+
+        // A new follower starts from the snapshot
+        Graph<int> late;
+        JournalFollower<int> lateFollower(path);
+        assert(lateFollower.poll(late) && sameGraph(late, g) && "A late follower catches up");
+
+        // Buffered records are not visible until committed
+        journal->commit();
+    }
+    {
+        Graph<int> g;
+        auto journal = J::open(path, g, {.groupBytes = 1 << 20});
+        Graph<int> replica;
+        JournalFollower<int> follower(path);
+        follower.poll(replica);
+        g.addEdge(10, 11);
+        assert(follower.poll(replica) == 0u && !replica.containsEdge(10, 11) && "Uncommitted records are not visible");
+        journal->commit();
+        assert(follower.poll(replica) == 3u && replica.containsEdge(10, 11));
+    }
+    std::cout << "TEST 6 PASSED: Tailing follower" << std::endl;
+
+    // =========================================================================
+    // TEST 7: String vertices
+    // =========================================================================
+    removeJournal(path);
+    Graph<std::string> names;
+    {
+        Graph<std::string> g;
+        auto journal = Journal<std::string>::open(path, g);
+        g.addEdge("alice", "bob");
+        g.addEdge("bob", "a much longer name that does not fit in the small string buffer");
+        g.addVertex("");
+        journal->compact();
+        g.addEdge("carol", "alice");
+        g.removeEdge("alice", "bob");
+        names = g;
+    }
+    Graph<std::string> restored;
+    auto stringStats = Journal<std::string>::recover(path, restored);
+    assert(stringStats && sameGraph(restored, names) && restored.containsVertex("") && "Strings round-trip");
+    std::cout << "TEST 7 PASSED: String vertices" << std::endl;
+
+    removeJournal(path);
+    std::cout << "\n=== All journal tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test23.cpp
+ * @brief Test suite for DenseGraph, the array-indexed graph on ids 0..N-1
+ *
+ * This test validates:
+ * - Ids outside [0, N) are never vertices, and mutators reject them
+ * - A moved-from DenseGraph is a valid empty graph
+ * - A random sequence of mutations leaves DenseGraph and Graph equal
+ * - GraphFor picks DenseGraph only for integer ids with a bound
+ *
+ * test1 to test6 also run against DenseGraph, built by the Makefile as
+ * test1_dense to test6_dense.
+ */
+
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include "graphlib.hpp"
+#include "graphlib/dense.hpp"
+#include "graphlib/random.hpp"
+
+int main() {
+    using Dense = DenseGraph<1024>;
+
+    // =========================================================================
+    // TEST 1: Out-of-range ids
+    // =========================================================================
+    Dense d;
+    auto rejects = [](auto&& mutate) {
+        try {
+            mutate();
+        } catch (const std::out_of_range&) {
+            return true;
+        }
+        return false;
+    };
+    assert(rejects([&] { d.addVertex(1024); }) && rejects([&] { d.addVertex(-1); }) && "addVertex rejects bad ids");
+    assert(rejects([&] { d.addEdge(3, 5000); }) && rejects([&] { d.addEdge(-7, 3); }) && "addEdge rejects bad ids");
+    assert(rejects([&] { d.addEdge(-7, -7); }) && "Even for a self-loop");
+    assert(rejects([&] { d.removeEdge(0, 1024); }) && rejects([&] { d.removeVertex(-1); }) && "Removals reject bad ids");
+    assert(d.countVertices() == 0 && d.countEdges() == 0 && "A rejected mutation changes nothing");
+    assert(!d.containsVertex(-1) && !d.containsVertex(1024) && !d.containsEdge(3, 5000) && d.degree(-1) == 0);
+    assert(d.neighbors(2000).empty() && d.bfs(-3).empty() && !d.distance(0, 4096));
+    d.addEdge(0, 1023);
+    assert(d.containsEdge(1023, 0) && *d.distance(0, 1023) == 1 && "Both ends of the range are valid");
+    std::vector<int> ids(d.begin(), d.end());
+    assert((ids == std::vector<int>{0, 1023}) && "Iteration is in id order");
+
+    Dense source;
+    source.addEdge(1, 2);
+    Dense target = std::move(source);
+    assert(target.containsEdge(1, 2) && target.countVertices() == 2);
+    assert(source.countVertices() == 0 && source.countEdges() == 0 && !source.containsVertex(1) && "Moved-from graph is empty");
+    assert(source.begin() == source.end() && source.vertices().empty());
+    source.addEdge(3, 4);
+    source.clear();
+    source.addEdge(5, 6);
+    target = std::move(source);
+    assert(target.containsEdge(5, 6) && !target.containsVertex(1) && target.countEdges() == 1);
+    assert(source.countVertices() == 0 && !source.containsEdge(5, 6) && source.maxDegree() == 0);
+    source.addEdge(7, 8);
+    assert(source.countEdges() == 1 && *source.distance(7, 8) == 1 && "Moved-from graph is usable");
+    std::cout << "TEST 1 PASSED: Ids outside [0, N) and moved-from graphs" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Random mutations against Graph
+    // =========================================================================
+    Graph<int> reference;
+    Dense dense;
+    graphlib::Xoshiro256 rng(7);
+    for (int step = 0; step < 200000; step++) {
+        const int u = static_cast<int>(graphlib::boundedRandom(rng, 1024));
+        const int v = static_cast<int>(graphlib::boundedRandom(rng, 1024));
+        const auto r = graphlib::boundedRandom(rng, 1000);
+        if (r < 600) { reference.addEdge(u, v); dense.addEdge(u, v); }
+        else if (r < 950) { reference.removeEdge(u, v); dense.removeEdge(u, v); }
+        else if (r < 990) { reference.addVertex(u); dense.addVertex(u); }
+        else if (r < 999) { reference.removeVertex(u); dense.removeVertex(u); }
+        else { reference.clear(); dense.clear(); }
+
+        if (step % 20000 == 0 || step == 199999) {
+            assert(dense.countVertices() == reference.countVertices() && dense.countEdges() == reference.countEdges());
+            assert(dense.vertices() == reference.vertices() && dense.edges() == reference.edges());
+            assert(dense.maxDegree() == reference.maxDegree());
+            for (int w = 0; w < 1024; w++) {
+                assert(dense.containsVertex(w) == reference.containsVertex(w) && dense.neighbors(w) == reference.neighbors(w));
+                assert(dense.distance(u, w) == reference.distance(u, w) && "Distances should match");
+            }
+            const auto a = dense.bfs(u), b = reference.bfs(u);
+            assert(std::unordered_set<int>(a.begin(), a.end()) == std::unordered_set<int>(b.begin(), b.end()));
+            assert(dense.bfs(u, 10).size() == reference.bfs(u, 10).size());
+        }
+    }
+    Dense copy = dense;
+    copy.removeVertex(static_cast<int>(*dense.begin()));
+    assert(copy.countVertices() + 1 == dense.countVertices() && "Copies are independent");
+    std::cout << "TEST 2 PASSED: 200000 random mutations leave DenseGraph equal to Graph" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Compile-time selection
+    // =========================================================================
+    static_assert(std::is_same_v<graphlib::GraphFor<int, 1024>, DenseGraph<1024, int>>);
+    static_assert(std::is_same_v<graphlib::GraphFor<std::uint32_t, 64>, DenseGraph<64, std::uint32_t>>);
+    static_assert(std::is_same_v<graphlib::GraphFor<int>, Graph<int>>);
+    static_assert(std::is_same_v<graphlib::GraphFor<std::string, 16>, Graph<std::string>>);
+    graphlib::GraphFor<int, 16> picked;
+    picked.addEdge(1, 2);
+    assert(picked.countEdges() == 1);
+    std::cout << "TEST 3 PASSED: GraphFor selects DenseGraph for bounded integer ids" << std::endl;
+
+    std::cout << "\n=== All dense graph tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test24.cpp
+ * @brief Test suite for the adjacency bit matrix
+ *
+ * This test validates:
+ * - The K5 -> K3,2 -> K2,2 and K100 -> K50 sequences of test5
+ * - Edge tests, degrees, neighbor lists and common neighbors against Graph
+ *   on random graphs whose size is not a multiple of 64
+ * - Triangle counts against a brute-force count
+ * - Bitset BFS distances against Graph::distance, on sparse and dense graphs
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include "graphlib.hpp"
+#include "graphlib/bitmatrix.hpp"
+#include "graphlib/random.hpp"
+
+using Id = BitMatrixGraph::Id;
+
+static std::uint64_t bruteForceTriangles(const Graph<int>& g, int n) {
+    std::uint64_t count = 0;
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (!g.containsEdge(u, v)) continue;
+            for (int w = v + 1; w < n; w++) count += g.containsEdge(u, w) && g.containsEdge(v, w);
+        }
+    }
+    return count;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: The sequences of test5
+    // =========================================================================
+    BitMatrixGraph k(5);
+    for (Id i = 0; i < 5; i++) {
+        for (Id j = 0; j < 5; j++) k.addEdge(i, j);
+    }
+    assert(k.containsEdge(0, 1) && !k.containsEdge(0, 5) && k.countEdges() == 10 && k.maxDegree() == 4);
+    for (Id i = 0; i < 4; i++) {
+        for (Id j = i + 1; j < 5; j++) {
+            if (i % 2 == j % 2) k.removeEdge(i, j);
+        }
+    }
+    assert(!k.containsEdge(0, 2) && !k.containsEdge(1, 3) && k.containsEdge(0, 1));
+    assert(k.countEdges() == 6 && k.maxDegree() == 3 && "K3,2");
+    k.isolateVertex(4);
+    assert(!k.containsEdge(1, 4) && k.countEdges() == 4 && k.maxDegree() == 2 && k.degree(4) == 0 && "K2,2");
+
+    BitMatrixGraph big(100);
+    for (Id i = 0; i < 100; i++) {
+        for (Id j = 0; j < 100; j++) big.addEdge(i, j);
+    }
+    assert(big.countEdges() == 4950 && big.countTriangles() == 161700 && "K100 has C(100, 3) triangles");
+    for (Id i = 0; i < 100; i += 2) big.isolateVertex(i);
+    assert(big.countEdges() == 50 * 49 / 2 && big.maxDegree() == 49 && "K50");
+    assert(big.countTriangles() == 19600 && big.commonNeighbors(1, 3) == 48);
+    big.clear();
+    big.addEdge(1, 5);
+    big.addEdge(7, 7);
+    big.addEdge(3, 100);
+    assert(big.countEdges() == 1 && big.maxDegree() == 1 && "Self-loops and ids >= n are ignored");
+    std::cout << "TEST 1 PASSED: Complete graph sequences of test5" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Queries against Graph on random graphs
+    // =========================================================================
+    graphlib::Xoshiro256 rng(11);
+    for (int n : {1, 63, 64, 65, 200, 700}) {
+        for (int densityPercent : {2, 30, 90}) {
+            Graph<int> ref;
+            std::vector<std::pair<Id, Id>> edges;
+            for (int u = 0; u < n; u++) {
+                ref.addVertex(u);
+                for (int v = u + 1; v < n; v++) {
+                    if (graphlib::boundedRandom(rng, 100) < static_cast<std::uint64_t>(densityPercent)) {
+                        ref.addEdge(u, v);
+                        edges.emplace_back(static_cast<Id>(v), static_cast<Id>(u));
+                    }
+                }
+            }
+            auto g = BitMatrixGraph::fromEdgeList(static_cast<std::size_t>(n), edges);
+            assert(g.countVertices() == static_cast<std::size_t>(n) && g.countEdges() == ref.countEdges());
+            assert(g.maxDegree() == ref.maxDegree());
+            for (int u = 0; u < n; u++) {
+                const auto nbrs = g.neighbors(static_cast<Id>(u));
+                assert(nbrs.size() == ref.degree(u) && g.degree(static_cast<Id>(u)) == ref.degree(u));
+                assert(std::is_sorted(nbrs.begin(), nbrs.end()));
+                for (Id v : nbrs) assert(ref.containsEdge(u, static_cast<int>(v)));
+                const int v = static_cast<int>(graphlib::boundedRandom(rng, static_cast<std::uint64_t>(n)));
+                assert(g.containsEdge(static_cast<Id>(u), static_cast<Id>(v)) == ref.containsEdge(u, v));
+                std::size_t common = 0;
+                for (int w : ref.neighbors(u)) common += ref.containsEdge(v, w);
+                assert(g.commonNeighbors(static_cast<Id>(u), static_cast<Id>(v)) == common);
+            }
+            if (n <= 200) assert(g.countTriangles() == bruteForceTriangles(ref, n) && "Triangle counts should match");
+
+            // BFS from a few sources; the direction switch happens on the dense graphs
+            for (int s = 0; s < std::min(n, 5); s++) {
+                const auto dist = g.bfs(static_cast<Id>(s));
+                for (int t = 0; t < n; t++) {
+                    const auto d = ref.distance(s, t);
+                    assert((d ? static_cast<Id>(*d) : BitMatrixGraph::unreachable) == dist[static_cast<std::size_t>(t)]);
+                }
+                assert(g.distance(static_cast<Id>(s), static_cast<Id>(n - 1)) == ref.distance(s, n - 1));
+            }
+        }
+    }
+    std::cout << "TEST 2 PASSED: Edges, degrees, neighbors, triangles and BFS match Graph" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Out-of-range queries
+    // =========================================================================
+    BitMatrixGraph path(130);
+    for (Id v = 0; v + 1 < 130; v++) path.addEdge(v, v + 1);
+    assert(path.bfs(130).empty() && !path.distance(0, 130) && !path.containsEdge(129, 130));
+    assert(path.degree(500) == 0 && path.neighbors(500).empty() && path.commonNeighbors(0, 500) == 0);
+    assert(*path.distance(0, 129) == 129 && path.countTriangles() == 0);
+    std::size_t visited = 0;
+    path.forEachNeighbor(64, [&](Id v) { visited += v; });
+    assert(visited == 63 + 65 && "Neighbors across a word boundary");
+    std::cout << "TEST 3 PASSED: Out-of-range queries" << std::endl;
+
+    std::cout << "\n=== All bit matrix tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file test25.cpp
+ * @brief Test suite for the coroutine query executor
+ *
+ * This test validates:
+ * - distance() and bfs() queries return what Graph::distance() and
+ *   Graph::bfs() return, on Graph and DenseGraph, whatever yieldEvery is
+ * - Queries can be awaited from coroutines, including chained queries
+ * - Cancellation through a stop token and deadlines, before and during a query
+ * - Queries beyond the capacity are Rejected, and slots are released
+ * - A short query submitted after a long one on a single thread completes first
+ * - A query that throws ends as Failed and keeps the exception
+ * - Destroying the executor cancels the queries left
+ *
+ * Tests that act during a traversal hook into GatedGraph::neighbors() at a
+ * fixed expansion count instead of racing the executor threads.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <latch>
+#include <semaphore>
+#include <stdexcept>
+#include <vector>
+#include "graphlib.hpp"
+#include "graphlib/async.hpp"
+#include "graphlib/dense.hpp"
+#include "graphlib/random.hpp"
+
+// Fire-and-forget coroutine, enough to co_await queries in a test
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+static Detached chained(QueryExecutor& exec, const Graph<int>& g, int u, int v, std::vector<int>& out, std::latch& done) {
+    auto d = co_await exec.distance(g, u, v);
+    assert(d.ok());
+    auto reach = co_await exec.bfs(g, u, static_cast<std::size_t>(d.value.value_or(0)) + 1);
+    out = std::move(reach.value);
+    done.count_down();
+}
+
+// Completion rank of a query, taken when its continuation resumes
+static Detached ranked(Query<std::vector<int>> q, std::atomic<int>& counter, int& rank, std::size_t& size,
+                       std::latch& done) {
+    auto r = co_await q;
+    size = r.value.size();
+    rank = counter++;
+    done.count_down();
+}
+
+// Graph wrapper running `hook` when a query expands its `at`-th vertex
+struct GatedGraph {
+    using NeighborSet = Graph<int>::NeighborSet;
+
+    const Graph<int>& g;
+    std::size_t at;
+    std::function<void()> hook;
+    mutable std::atomic<std::size_t> expanded{0};
+
+    bool containsVertex(int v) const {
+        return g.containsVertex(v);
+    }
+
+    const NeighborSet& neighbors(int v) const {
+        if (++expanded == at) hook();
+        return g.neighbors(v);
+    }
+};
+
+static Graph<int> path(int n) {
+    Graph<int> g;
+    for (int v = 0; v + 1 < n; v++) g.addEdge(v, v + 1);
+    return g;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Same answers as the synchronous traversals
+    // =========================================================================
+    graphlib::Xoshiro256 rng(3);
+    Graph<int> g;
+    DenseGraph<500> dense;
+    for (int i = 0; i < 900; i++) {
+        const int u = static_cast<int>(graphlib::boundedRandom(rng, 500));
+        const int v = static_cast<int>(graphlib::boundedRandom(rng, 500));
+        g.addEdge(u, v);
+        dense.addEdge(u, v);
+    }
+    for (std::size_t yieldEvery : {1, 7, 1024}) {
+        QueryExecutor exec({.threads = 3, .queueCapacity = 4096, .yieldEvery = yieldEvery});
+        std::vector<Query<std::optional<int>>> distances, denseDistances;
+        std::vector<Query<std::vector<int>>> orders;
+        for (int i = 0; i < 300; i++) {
+            distances.push_back(exec.distance(g, i, 499 - i));
+            denseDistances.push_back(exec.distance(dense, i, 499 - i));
+            orders.push_back(exec.bfs(g, i, static_cast<std::size_t>(i % 50)));
+        }
+        for (int i = 0; i < 300; i++) {
+            assert(distances[i].get().ok() && distances[i].get().value == g.distance(i, 499 - i));
+            assert(denseDistances[i].get().value == g.distance(i, 499 - i));
+            const auto& order = orders[i].get().value;
+            const auto expected = g.bfs(i, static_cast<std::size_t>(i % 50));
+            assert(order.size() == expected.size() && (order.empty() || order[0] == i));
+        }
+        assert(!exec.distance(g, 0, 1000).get().value && exec.bfs(g, 1000).get().value.empty());
+        assert(exec.distance(g, 5, 5).get().value == 0);
+        exec.waitIdle();
+        assert(exec.pending() == 0);
+
+        // Results are published before the slot is released
+        std::vector<Query<std::vector<int>>> unread;
+        for (int i = 0; i < 200; i++) unread.push_back(exec.bfs(g, i));
+        exec.waitIdle();
+        for (const auto& q : unread) assert(q.ready() && "waitIdle() returns after every result is published");
+    }
+    std::cout << "TEST 1 PASSED: Results match Graph::distance and Graph::bfs" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Awaiting from coroutines
+    // =========================================================================
+    {
+        QueryExecutor exec({.threads = 2, .queueCapacity = 64, .yieldEvery = 5});
+        const Graph<int> line = path(200);
+        std::vector<std::vector<int>> out(10);
+        std::latch done(10);
+        for (int k = 0; k < 10; k++) chained(exec, line, 10 * k, 10 * k + 30, out[k], done);
+        done.wait();
+        for (int k = 0; k < 10; k++) {
+            assert(out[k].size() == 31 && out[k][0] == 10 * k && "Distance 30, then 31 vertices");
+        }
+    }
+    std::cout << "TEST 2 PASSED: Chained co_await" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Cancellation and deadlines
+    // =========================================================================
+    const Graph<int> longPath = path(200000);
+    {
+        QueryExecutor exec({.threads = 1, .queueCapacity = 16, .yieldEvery = 64});
+        std::stop_source before, during;
+        before.request_stop();
+        GatedGraph stopHalfway{longPath, 1000, [&] { during.request_stop(); }};
+        auto early = exec.bfs(longPath, 0, 0, {.stop = before.get_token()});
+        auto running = exec.bfs(stopHalfway, 0, 0, {.stop = during.get_token()});
+        assert(early.get().status == QueryStatus::Cancelled && early.get().value.empty());
+        assert(running.get().status == QueryStatus::Cancelled);
+        assert(stopHalfway.expanded < 1000 + 64 && "Stops at the next yield point");
+
+        auto now = std::chrono::steady_clock::now();
+        auto tightDeadline = now + std::chrono::milliseconds(1);
+        GatedGraph sleepHalfway{longPath, 1000, [&] { std::this_thread::sleep_until(tightDeadline + std::chrono::milliseconds(1)); }};
+        auto expired = exec.distance(longPath, 0, 199999, {.deadline = now});
+        auto tight = exec.distance(sleepHalfway, 0, 199999, {.deadline = tightDeadline});
+        auto loose = exec.distance(longPath, 0, 199999, {.deadline = now + std::chrono::hours(1)});
+        assert(expired.get().status == QueryStatus::DeadlineExceeded && !expired.get().value);
+        assert(tight.get().status == QueryStatus::DeadlineExceeded);
+        assert(loose.get().ok() && loose.get().value == 199999);
+    }
+    std::cout << "TEST 3 PASSED: Cancellation and deadlines" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Bounded admission
+    // =========================================================================
+    {
+        QueryExecutor exec({.threads = 1, .queueCapacity = 2, .yieldEvery = 64});
+        std::binary_semaphore release(0);
+        GatedGraph blocked{longPath, 1, [&] { release.acquire(); }};
+        std::stop_source stop;
+        auto a = exec.bfs(blocked, 0, 0, {.stop = stop.get_token()});
+        auto b = exec.bfs(longPath, 0, 0, {.stop = stop.get_token()});
+        auto c = exec.distance(g, 0, 1);
+        assert(c.ready() && c.get().status == QueryStatus::Rejected && "The executor is full");
+        assert(exec.pending() == 2);
+        stop.request_stop();
+        release.release();
+        exec.waitIdle();
+        assert(a.get().status == QueryStatus::Cancelled && b.get().status == QueryStatus::Cancelled);
+        assert(exec.distance(g, 0, 1).get().ok() && "Slots are released");
+    }
+    std::cout << "TEST 4 PASSED: Bounded admission" << std::endl;
+
+    // =========================================================================
+    // TEST 5: Yielding lets short queries overtake long ones
+    // =========================================================================
+    {
+        // The worker is held by `gate` until both queries are queued, so the
+        // long query cannot finish before the short one is submitted
+        QueryExecutor exec({.threads = 1, .queueCapacity = 16, .yieldEvery = 64});
+        std::binary_semaphore release(0);
+        GatedGraph held{g, 1, [&] { release.acquire(); }};
+        auto gate = exec.bfs(held, 0, 1);
+        std::atomic<int> counter{0};
+        int slowRank = -1, fastRank = -1;
+        std::size_t slowSize = 0, fastSize = 0;
+        std::latch done(2);
+        ranked(exec.bfs(longPath, 0), counter, slowRank, slowSize, done);
+        ranked(exec.bfs(longPath, 100, 10), counter, fastRank, fastSize, done);
+        release.release();
+        done.wait();
+        assert(gate.get().ok());
+        assert(fastRank == 0 && slowRank == 1 && "The short query completes first");
+        assert(fastSize == 10 && slowSize == 200000);
+    }
+    std::cout << "TEST 5 PASSED: Cooperative yielding" << std::endl;
+
+    // =========================================================================
+    // TEST 6: Exceptions
+    // =========================================================================
+    {
+        QueryExecutor exec({.threads = 2, .queueCapacity = 16, .yieldEvery = 64});
+        GatedGraph throwing{longPath, 500, [] { throw std::runtime_error("neighbors failed"); }};
+        auto query = exec.bfs(throwing, 0);
+        const auto& failed = query.get();
+        assert(failed.status == QueryStatus::Failed && failed.error && failed.value.empty());
+        bool rethrown = false;
+        try {
+            std::rethrow_exception(failed.error);
+        } catch (const std::runtime_error& e) {
+            rethrown = std::string(e.what()) == "neighbors failed";
+        }
+        assert(rethrown && "The original exception is kept");
+        exec.waitIdle();
+        assert(exec.pending() == 0 && "The slot is released");
+        assert(exec.distance(g, 0, 1).get().ok());
+    }
+    std::cout << "TEST 6 PASSED: Failed queries keep their exception" << std::endl;
+
+    // =========================================================================
+    // TEST 7: Shutdown
+    // =========================================================================
+    {
+        std::vector<Query<std::vector<int>>> left;
+        {
+            QueryExecutor exec({.threads = 1, .queueCapacity = 16, .yieldEvery = 64});
+            for (int i = 0; i < 4; i++) left.push_back(exec.bfs(longPath, i));
+        }
+        for (auto& q : left) assert(q.ready() && q.get().status == QueryStatus::Cancelled);
+    }
+    std::cout << "TEST 7 PASSED: The destructor cancels the queries left" << std::endl;
+
+    std::cout << "\n=== All async query tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file test26.cpp
+ * @brief Test suite for the max-flow / min-cut engine
+ *
+ * This test validates:
+ * - A hand-checked network: flow value, cut edges and source side
+ * - Push-relabel and Dinic agree with a brute-force minimum cut on small
+ *   random graphs, and with each other on larger ones
+ * - Cut edges sum to the flow value and disconnect s from t
+ * - Unit capacities give edge connectivities (cliques, grids)
+ * - The CSRGraph + EdgeColumn constructor, string vertices and edge cases
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "graphlib/flow.hpp"
+#include "graphlib/random.hpp"
+
+using Cap = std::int64_t;
+
+static Cap edgeCapacity(int u, int v) {
+    return static_cast<Cap>(graphlib::hashMix(static_cast<std::uint64_t>(std::min(u, v)) * 1000003u
+                                              + static_cast<std::uint64_t>(std::max(u, v))) % 20);
+}
+
+// Smallest cut over every vertex subset containing s and not t
+static Cap bruteForceCut(const Graph<int>& g, int n, int s, int t) {
+    Cap best = std::numeric_limits<Cap>::max();
+    for (std::uint32_t mask = 0; mask < (1u << n); mask++) {
+        if (!(mask >> s & 1) || (mask >> t & 1)) continue;
+        Cap value = 0;
+        for (int u = 0; u < n; u++) {
+            if (!(mask >> u & 1) || !g.containsVertex(u)) continue;
+            for (int v : g.neighbors(u)) {
+                if (!(mask >> v & 1)) value += edgeCapacity(u, v);
+            }
+        }
+        best = std::min(best, value);
+    }
+    return best;
+}
+
+// Checks that a cut is consistent with its value and separates s from t
+static void checkCut(const Graph<int>& g, const MinCut<int, Cap>& cut, int s, int t) {
+    Cap sum = 0;
+    Graph<int> rest = g;
+    for (const auto& [u, v] : cut.edges) {
+        sum += edgeCapacity(u, v);
+        rest.removeEdge(u, v);
+    }
+    assert(sum == cut.value && "Cut edges add up to the flow");
+    assert(!rest.distance(s, t) && "Removing the cut edges disconnects s from t");
+    assert(std::find(cut.sourceSide.begin(), cut.sourceSide.end(), s) != cut.sourceSide.end());
+    assert(std::find(cut.sourceSide.begin(), cut.sourceSide.end(), t) == cut.sourceSide.end());
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Hand-checked network
+    // =========================================================================
+    //   0 --5-- 1 --1-- 3
+    //   |       |       |
+    //   4       3       7
+    //   |       |       |
+    //   2 --2-- 4 --9-- 5
+    Graph<int> small;
+    const int caps[][3] = {{0, 1, 5}, {0, 2, 4}, {1, 3, 1}, {1, 4, 3}, {2, 4, 2}, {3, 5, 7}, {4, 5, 9}};
+    for (const auto& e : caps) small.addEdge(e[0], e[1]);
+    auto smallCap = [&](int u, int v) {
+        for (const auto& e : caps) {
+            if ((e[0] == u && e[1] == v) || (e[0] == v && e[1] == u)) return Cap{e[2]};
+        }
+        return Cap{0};
+    };
+    FlowNetwork<int> net(small, smallCap);
+    assert(net.countVertices() == 6 && net.countEdges() == 7);
+    assert(net.maxFlow(0, 5) == 6 && net.maxFlow(0, 5, FlowAlgorithm::Dinic) == 6);
+    assert(net.maxFlow(5, 0) == 6 && net.maxFlow(3, 5) == 8 && net.maxFlow(2, 0) == 6);
+    const auto cut = net.minCut(0, 5);
+    assert(cut.value == 6 && cut.edges.size() == 3 && "{1-3, 1-4, 2-4} is the cut closest to t");
+    for (const auto& [u, v] : cut.edges) assert((u == 1 && v == 3) || (u == 1 && v == 4) || (u == 2 && v == 4));
+    assert(cut.sourceSide.size() == 3);
+    std::cout << "TEST 1 PASSED: Hand-checked network" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Brute force on small random graphs
+    // =========================================================================
+    graphlib::Xoshiro256 rng(17);
+    for (int round = 0; round < 200; round++) {
+        const int n = 2 + static_cast<int>(graphlib::boundedRandom(rng, 11));
+        Graph<int> g;
+        for (int v = 0; v < n; v++) g.addVertex(v);
+        const std::size_t edges = graphlib::boundedRandom(rng, static_cast<std::uint64_t>(2 * n + 1));
+        for (std::size_t k = 0; k < edges; k++) {
+            g.addEdge(static_cast<int>(graphlib::boundedRandom(rng, n)), static_cast<int>(graphlib::boundedRandom(rng, n)));
+        }
+        FlowNetwork<int> flow(g, edgeCapacity);
+        const int s = 0, t = n - 1;
+        const Cap expected = bruteForceCut(g, n, s, t);
+        assert(flow.maxFlow(s, t) == expected && flow.maxFlow(s, t, FlowAlgorithm::Dinic) == expected);
+        checkCut(g, flow.minCut(s, t), s, t);
+        checkCut(g, flow.minCut(s, t, FlowAlgorithm::Dinic), s, t);
+    }
+    std::cout << "TEST 2 PASSED: Both algorithms match a brute-force minimum cut" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Larger random graphs, both algorithms agree
+    // =========================================================================
+    for (int round = 0; round < 20; round++) {
+        const int n = 300 + 50 * round;
+        Graph<int> g;
+        for (int k = 0; k < 3 * n; k++) {
+            g.addEdge(static_cast<int>(graphlib::boundedRandom(rng, n)), static_cast<int>(graphlib::boundedRandom(rng, n)));
+        }
+        if (!g.containsVertex(0) || !g.containsVertex(1)) continue;
+        FlowNetwork<int> flow(g, edgeCapacity);
+        const Cap value = flow.maxFlow(0, 1);
+        assert(flow.maxFlow(0, 1, FlowAlgorithm::Dinic) == value);
+        checkCut(g, flow.minCut(0, 1), 0, 1);
+    }
+    std::cout << "TEST 3 PASSED: Push-relabel and Dinic agree on larger graphs" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Edge connectivity with unit capacities
+    // =========================================================================
+    Graph<int> clique, grid;
+    for (int i = 0; i < 12; i++) {
+        for (int j = i + 1; j < 12; j++) clique.addEdge(i, j);
+    }
+    for (int x = 0; x < 30; x++) {
+        for (int y = 0; y < 30; y++) {
+            if (x + 1 < 30) grid.addEdge(30 * y + x, 30 * y + x + 1);
+            if (y + 1 < 30) grid.addEdge(30 * y + x, 30 * (y + 1) + x);
+        }
+    }
+    FlowNetwork<int> unitClique(clique), unitGrid(grid);
+    assert(unitClique.maxFlow(0, 11) == 11 && unitClique.maxFlow(3, 4, FlowAlgorithm::Dinic) == 11);
+    assert(unitGrid.maxFlow(0, 899) == 2 && "Corners have degree 2");
+    assert(unitGrid.maxFlow(31, 868) == 4 && unitGrid.maxFlow(31, 868, FlowAlgorithm::Dinic) == 4);
+    assert(unitGrid.minCut(0, 899).edges.size() == 2);
+    std::cout << "TEST 4 PASSED: Unit capacities give edge connectivity" << std::endl;
+
+    // =========================================================================
+    // TEST 5: CSRGraph with an EdgeColumn, string vertices, edge cases
+    // =========================================================================
+    CSRGraph<int> csr(small);
+    EdgeColumn<Cap, int> column(csr, 0);
+    for (const auto& e : caps) column.set(csr.id(e[0]), csr.id(e[1]), e[2]);
+    FlowNetwork<int> fromColumn(csr, column);
+    assert(fromColumn.maxFlow(0, 5) == 6 && fromColumn.minCut(0, 5).value == 6);
+
+    Graph<std::string> pods;
+    pods.addEdge("a", "b");
+    pods.addEdge("b", "c");
+    pods.addEdge("a", "c");
+    pods.addVertex("isolated");
+    FlowNetwork<std::string, std::hash<std::string>, double> named(
+        pods, [](const std::string& u, const std::string& v) { return u == "a" || v == "a" ? 2.5 : 1.0; });
+    assert(named.maxFlow("a", "c") == 3.5 && named.maxFlow("a", "isolated") == 0.0);
+    assert(named.maxFlow("a", "a") == 0.0 && named.maxFlow("a", "missing") == 0.0);
+    assert(named.minCut("a", "missing").edges.empty() && named.minCut("a", "isolated").edges.empty());
+
+    FlowNetwork<int> negative(small, [](int, int) { return Cap{-3}; });
+    assert(negative.maxFlow(0, 5) == 0 && "Negative capacities count as 0");
+    std::cout << "TEST 5 PASSED: Column constructor, string vertices and edge cases" << std::endl;
+
+    std::cout << "\n=== All flow tests passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file test27.cpp
+ * @brief Test suite for the graph version counter and QueryCache
+ *
+ * This test validates:
+ * - version() changes on every modification and only then, for Graph and
+ *   DenseGraph, copies, assignments and MutationBatch
+ * - Cached distance() and bfs() results match the graph
+ * - Every kind of modification invalidates the cached results
+ * - Eviction keeps the cache within its memory budget
+ * - Concurrent readers get correct results
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include "graphlib/dense.hpp"
+#include "graphlib/mutation_batch.hpp"
+#include "graphlib/query_cache.hpp"
+#include "graphlib/random.hpp"
+
+int main() {
+    // =========================================================================
+    // TEST 1: version() semantics
+    // =========================================================================
+    Graph<int> g;
+    assert(g.version() == 0);
+    g.addVertex(1);
+    std::uint64_t v = g.version();
+    assert(v > 0);
+    g.addVertex(1);
+    assert(g.version() == v && "Adding an existing vertex keeps the version");
+    g.addEdge(1, 2);
+    assert(g.version() > v);
+    v = g.version();
+    g.addEdge(2, 1);
+    g.removeEdge(1, 3);
+    g.removeVertex(42);
+    assert(g.version() == v && "No-op calls keep the version");
+    g.removeEdge(1, 2);
+    assert(g.version() > v);
+    v = g.version();
+    g.removeVertex(2);
+    assert(g.version() > v);
+    v = g.version();
+    g.clear();
+    assert(g.version() > v);
+    v = g.version();
+    g.clear();
+    assert(g.version() == v && "Clearing an empty graph keeps the version");
+
+    Graph<int> copy = g;
+    assert(copy.version() == g.version());
+    Graph<int> other;
+    other.addEdge(5, 6);
+    v = copy.version();
+    copy = other;
+    assert(copy.version() > v && copy.version() > other.version() && "Assignment never reuses a version");
+
+    Graph<int> source;
+    source.addEdge(1, 2);
+    QueryCache<Graph<int>> sourceCache(source);
+    assert(sourceCache.distance(1, 2) == 1);
+    v = source.version();
+    Graph<int> moved = std::move(source);
+    assert(moved.version() == v && source.version() > v && "A moved-from graph changes version");
+    assert(source.countVertices() == 0 && !source.distance(1, 2));
+    assert(!sourceCache.distance(1, 2) && "Moving out of a graph invalidates its cache");
+    DenseGraph<16> denseSource;
+    denseSource.addEdge(1, 2);
+    QueryCache<DenseGraph<16>> denseSourceCache(denseSource);
+    assert(denseSourceCache.distance(1, 2) == 1 && denseSourceCache.bfs(1)->size() == 2);
+    v = denseSource.version();
+    DenseGraph<16> denseMoved = std::move(denseSource);
+    assert(denseMoved.version() == v && denseSource.version() > v && "A moved-from DenseGraph changes version");
+    assert(denseSource.countVertices() == 0 && !denseSource.containsVertex(1) && !denseSource.distance(1, 2));
+    assert(!denseSourceCache.distance(1, 2) && denseSourceCache.bfs(1)->empty() && "Moving out of a DenseGraph invalidates its cache");
+    v = denseMoved.version();
+    denseMoved = std::move(denseSource);
+    assert(denseMoved.version() > v && denseMoved.countVertices() == 0 && "Move assignment never reuses a version");
+    v = moved.version();
+    moved = std::move(copy);
+    assert(moved.version() > v && copy.version() > 0 && "Move assignment never reuses a version");
+
+    v = g.version();
+    MutationBatch<int> batch;
+    batch.addEdge(1, 2);
+    batch.addEdge(2, 3);
+    batch.applyTo(g);
+    assert(g.version() > v && g.containsEdge(2, 3));
+    v = g.version();
+    MutationBatch<int>().applyTo(g);
+    assert(g.version() == v && "An empty batch keeps the version");
+
+    DenseGraph<16> dense;
+    assert(dense.version() == 0);
+    dense.addEdge(0, 1);
+    v = dense.version();
+    dense.addEdge(1, 0);
+    assert(dense.version() == v);
+    dense.removeEdge(0, 1);
+    assert(dense.version() > v);
+    v = dense.version();
+    dense.clear();
+    assert(dense.version() > v);
+    v = dense.version();
+    dense.clear();
+    assert(dense.version() == v && "Clearing an empty graph keeps the version");
+    std::cout << "TEST 1 PASSED: version() changes exactly when the graph does" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Cached results match the graph
+    // =========================================================================
+    graphlib::Xoshiro256 rng(5);
+    Graph<int> random;
+    for (int k = 0; k < 600; k++) {
+        random.addEdge(static_cast<int>(graphlib::boundedRandom(rng, 300)), static_cast<int>(graphlib::boundedRandom(rng, 300)));
+    }
+    QueryCache<Graph<int>> cache(random);
+    for (int round = 0; round < 2; round++) {
+        for (int u = 0; u < 40; u++) {
+            for (int w = 0; w < 40; w++) {
+                assert(cache.distance(u, w) == random.distance(u, w));
+            }
+            assert(*cache.bfs(u) == random.bfs(u));
+            assert(*cache.bfs(u, 10) == random.bfs(u, 10));
+        }
+    }
+    auto stats = cache.stats();
+    assert(stats.misses == 40 * 41 / 2 + 80 && "distance(u, v) and distance(v, u) share an entry");
+    assert(stats.hits == 2 * (40 * 40 + 80) - stats.misses && stats.stale == 0 && stats.evictions == 0);
+    assert(stats.hitRate() > 0.7 && stats.entries == stats.misses);
+    assert(cache.bfs(7) == cache.bfs(7) && "Hits share the cached order");
+    std::cout << "TEST 2 PASSED: Cached results match the graph" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Modifications invalidate cached results
+    // =========================================================================
+    Graph<std::string> path;
+    path.addEdge("a", "b");
+    path.addEdge("b", "c");
+    path.addEdge("c", "d");
+    QueryCache<Graph<std::string>> names(path, {.maxBytes = 1 << 20, .shards = 4});
+    assert(names.distance("a", "d") == 3 && names.distance("a", "d") == 3);
+    path.addEdge("a", "d");
+    assert(names.distance("a", "d") == 1 && "addEdge invalidates");
+    path.removeEdge("a", "d");
+    assert(names.distance("a", "d") == 3 && "removeEdge invalidates");
+    assert(names.bfs("a")->size() == 4);
+    path.removeVertex("c");
+    assert(!names.distance("a", "d") && names.bfs("a")->size() == 2 && "removeVertex invalidates");
+    MutationBatch<std::string> reconnect;
+    reconnect.addEdge("b", "d");
+    reconnect.applyTo(path);
+    assert(names.distance("a", "d") == 2 && "MutationBatch invalidates");
+    path.clear();
+    assert(!names.distance("a", "d") && names.bfs("a")->empty() && "clear invalidates");
+    stats = names.stats();
+    assert(stats.stale == 7 && stats.hits == 1);
+    names.clear();
+    assert(names.stats().entries == 0 && names.stats().bytes == 0 && names.stats().hits == 1);
+
+    DenseGraph<64> ring;
+    for (int i = 0; i < 64; i++) ring.addEdge(i, (i + 1) % 64);
+    QueryCache<DenseGraph<64>> denseCache(ring);
+    assert(denseCache.distance(0, 32) == 32);
+    ring.addEdge(0, 32);
+    assert(denseCache.distance(0, 32) == 1 && denseCache.distance(32, 0) == 1);
+    std::cout << "TEST 3 PASSED: Every modification invalidates cached results" << std::endl;
+
+    // =========================================================================
+    // TEST 4: The memory budget is respected
+    // =========================================================================
+    const std::size_t budget = 64 << 10;
+    QueryCache<Graph<int>> small(random, {.maxBytes = budget, .shards = 4});
+    for (int u = 0; u < 300; u++) {
+        if (!random.containsVertex(u)) continue;
+        assert(*small.bfs(u, 50) == random.bfs(u, 50));
+        for (int w = 0; w < 300; w += 7) assert(small.distance(u, w) == random.distance(u, w));
+        assert(small.stats().bytes <= budget);
+    }
+    stats = small.stats();
+    assert(stats.evictions > 0 && stats.entries > 0 && stats.bytes <= budget);
+
+    // Results larger than a shard are returned but not kept
+    QueryCache<Graph<int>> tiny(random, {.maxBytes = 1024, .shards = 1});
+    assert(*tiny.bfs(0) == random.bfs(0) && tiny.stats().entries == 0);
+
+    // After a modification, stale entries make room for the new ones
+    QueryCache<Graph<int>> clock(random, {.maxBytes = budget, .shards = 1});
+    for (int u = 0; u < 300; u++) clock.distance(0, u);
+    random.addEdge(0, 299);
+    for (int u = 0; u < 300; u++) assert(clock.distance(1, u) == random.distance(1, u));
+    assert(clock.stats().bytes <= budget);
+
+    // Stale results recomputed larger than before still go through eviction
+    Graph<int> pairs;
+    for (int i = 0; i < 200; i++) pairs.addEdge(i, 1000 + i);
+    const std::size_t growBudget = 16 << 10;
+    QueryCache<Graph<int>> grow(pairs, {.maxBytes = growBudget, .shards = 1});
+    for (int i = 0; i < 200; i++) assert(grow.bfs(i)->size() == 2);
+    for (int i = 0; i + 1 < 200; i++) pairs.addEdge(i, i + 1);
+    for (int i = 199; i >= 0; i--) {
+        assert(grow.bfs(i)->size() == 400);
+        assert(grow.stats().bytes <= growBudget);
+    }
+    assert(grow.stats().stale > 0);
+    std::cout << "TEST 4 PASSED: Eviction keeps the cache within its budget" << std::endl;
+
+    // =========================================================================
+    // TEST 5: Concurrent readers
+    // =========================================================================
+    QueryCache<Graph<int>> shared(random, {.maxBytes = 256 << 10, .shards = 8});
+    std::vector<std::thread> readers;
+    std::vector<int> errors(8, 0);
+    for (int t = 0; t < 8; t++) {
+        readers.emplace_back([&, t] {
+            graphlib::Xoshiro256 local(100 + t);
+            for (int k = 0; k < 3000; k++) {
+                const int u = static_cast<int>(graphlib::boundedRandom(local, 60));
+                const int w = static_cast<int>(graphlib::boundedRandom(local, 60));
+                if (shared.distance(u, w) != random.distance(u, w)) errors[t]++;
+                if (k % 10 == 0 && shared.bfs(u, 20)->size() != random.bfs(u, 20).size()) errors[t]++;
+            }
+        });
+    }
+    for (auto& th : readers) th.join();
+    for (int e : errors) assert(e == 0);
+    stats = shared.stats();
+    assert(stats.hits + stats.misses == 8 * 3300 && stats.hits > stats.misses);
+    std::cout << "TEST 5 PASSED: Concurrent readers" << std::endl;
+
+    std::cout << "\n=== All query cache tests passed ===" << std::endl;
+    return 0;
+}
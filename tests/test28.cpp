@@ -0,0 +1,171 @@
+/**
+ * @file test28.cpp
+ * @brief Test suite for graph partitioning and part extraction
+ *
+ * This test validates:
+ * - A hand-checked graph: two cliques joined by one edge are split on it
+ * - Every algorithm respects the balance constraint and reports its cut
+ * - Cut quality on grids and random graphs, against a hash split
+ * - Extracted parts: owned vertices, ghosts, halo edges
+ * - Edge cases: one part, more parts than vertices, empty graphs, strings
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <unordered_set>
+#include "graphlib/partition.hpp"
+
+static const PartitionAlgorithm algorithms[] = {PartitionAlgorithm::LDG, PartitionAlgorithm::Fennel,
+                                                PartitionAlgorithm::Multilevel};
+
+// Checks the invariants every partition must satisfy
+template<typename Vertex, typename Hash>
+static void checkPartition(const CSRGraph<Vertex, Hash>& g, const Partition& p, std::size_t k, double imbalance) {
+    const std::size_t n = g.countVertices();
+    assert(p.parts == k && p.part.size() == n && p.sizes.size() == k);
+    std::vector<std::size_t> sizes(k, 0);
+    for (PartId x : p.part) {
+        assert(x < k);
+        sizes[x]++;
+    }
+    assert(sizes == p.sizes);
+    const auto capacity = static_cast<std::size_t>(std::ceil((1.0 + imbalance) * static_cast<double>(n) / static_cast<double>(k)));
+    for (std::size_t s : sizes) assert(s <= std::max<std::size_t>(capacity, 1) && "Balance constraint");
+    assert(p.cutEdges == edgeCut(g, std::span<const PartId>(p.part)) && p.edges == g.countEdges());
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Two cliques joined by one edge
+    // =========================================================================
+    Graph<int> cliques;
+    for (int side = 0; side < 2; side++) {
+        for (int i = 0; i < 10; i++) {
+            for (int j = i + 1; j < 10; j++) cliques.addEdge(10 * side + i, 10 * side + j);
+        }
+    }
+    cliques.addEdge(3, 15);
+    CSRGraph<int> twoCliques(cliques);
+    const Partition split = partitionGraph(twoCliques, {.parts = 2, .imbalance = 0.0});
+    checkPartition(twoCliques, split, 2, 0.0);
+    assert(split.cutEdges == 1 && split.sizes[0] == 10 && split.cutRatio() == 1.0 / 91);
+    for (int v = 0; v < 20; v++) {
+        assert(split.part[twoCliques.id(v)] == split.part[twoCliques.id(v < 10 ? 0 : 10)]);
+    }
+    for (auto alg : algorithms) {
+        checkPartition(twoCliques, partitionGraph(twoCliques, {.parts = 2, .imbalance = 0.0, .algorithm = alg}), 2, 0.0);
+    }
+    std::cout << "TEST 1 PASSED: Two cliques are split on their bridge" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Balance and cut bookkeeping on random graphs
+    // =========================================================================
+    graphlib::Xoshiro256 rng(23);
+    for (int round = 0; round < 30; round++) {
+        const int n = 50 + 40 * round;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+        for (int e = 0; e < 4 * n; e++) {
+            edges.emplace_back(static_cast<std::uint32_t>(graphlib::boundedRandom(rng, n)),
+                               static_cast<std::uint32_t>(graphlib::boundedRandom(rng, n)));
+        }
+        const auto g = CSRGraph<int>::fromEdgeList(static_cast<std::size_t>(n), edges);
+        const std::size_t k = 2 + static_cast<std::size_t>(round % 7);
+        const double imbalance = (round % 3) * 0.05;
+        for (auto alg : algorithms) {
+            const Partition p = partitionGraph(g, {.parts = k, .imbalance = imbalance, .algorithm = alg,
+                                                   .seed = static_cast<std::uint64_t>(round)});
+            checkPartition(g, p, k, imbalance);
+        }
+    }
+    std::cout << "TEST 2 PASSED: Balance constraint and cut counts" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Cut quality
+    // =========================================================================
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> gridEdges;
+    const std::uint32_t side = 40;
+    for (std::uint32_t y = 0; y < side; y++) {
+        for (std::uint32_t x = 0; x < side; x++) {
+            if (x + 1 < side) gridEdges.emplace_back(y * side + x, y * side + x + 1);
+            if (y + 1 < side) gridEdges.emplace_back(y * side + x, (y + 1) * side + x);
+        }
+    }
+    const auto grid = CSRGraph<int>::fromEdgeList(side * side, gridEdges);
+    std::vector<PartId> hashed(grid.countVertices());
+    for (std::size_t v = 0; v < hashed.size(); v++) hashed[v] = static_cast<PartId>(graphlib::hashMix(v) % 4);
+    const std::size_t hashCut = edgeCut(grid, std::span<const PartId>(hashed));
+    const Partition gridMl = partitionGraph(grid, {.parts = 4});
+    const Partition gridLdg = partitionGraph(grid, {.parts = 4, .algorithm = PartitionAlgorithm::LDG});
+    const Partition gridFennel = partitionGraph(grid, {.parts = 4, .algorithm = PartitionAlgorithm::Fennel});
+    assert(gridMl.cutEdges <= 2 * 80 && "Optimal is 80: two straight cuts");
+    assert(gridLdg.cutEdges < hashCut / 4 && gridFennel.cutEdges < hashCut / 4);
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> randomEdges;
+    for (int e = 0; e < 20000; e++) {
+        randomEdges.emplace_back(static_cast<std::uint32_t>(graphlib::boundedRandom(rng, 5000)),
+                                 static_cast<std::uint32_t>(graphlib::boundedRandom(rng, 5000)));
+    }
+    const auto random = CSRGraph<int>::fromEdgeList(5000, randomEdges);
+    hashed.assign(random.countVertices(), 0);
+    for (std::size_t v = 0; v < hashed.size(); v++) hashed[v] = static_cast<PartId>(graphlib::hashMix(v) % 8);
+    const Partition randomMl = partitionGraph(random, {.parts = 8});
+    assert(randomMl.cutEdges < edgeCut(random, std::span<const PartId>(hashed)) * 3 / 4);
+    assert(partitionGraph(random, {.parts = 8}).part == randomMl.part && "Same seed, same partition");
+    std::cout << "TEST 3 PASSED: Cuts are far below a hash split" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Extracted parts with ghosts
+    // =========================================================================
+    const auto parts = extractParts(random, randomMl);
+    assert(parts.size() == 8);
+    std::unordered_set<int> seen;
+    std::size_t edgeSum = 0;
+    for (PartId p = 0; p < 8; p++) {
+        const auto& sub = parts[p];
+        assert(sub.owned.size() == randomMl.sizes[p] && sub.ghosts.size() == sub.ghostParts.size());
+        for (int v : sub.owned) {
+            assert(seen.insert(v).second && randomMl.part[random.id(v)] == p);
+            for (auto w : random.neighbors(random.id(v))) assert(sub.graph.containsEdge(v, random.vertex(w)));
+        }
+        for (std::size_t i = 0; i < sub.ghosts.size(); i++) {
+            assert(sub.ghostParts[i] != p && randomMl.part[random.id(sub.ghosts[i])] == sub.ghostParts[i]);
+            for (int w : sub.graph.neighbors(sub.ghosts[i])) assert(randomMl.part[random.id(w)] == p && "No ghost-ghost edges");
+        }
+        assert(sub.graph.countVertices() == sub.owned.size() + sub.ghosts.size());
+        edgeSum += sub.graph.countEdges();
+    }
+    assert(seen.size() == random.countVertices());
+    assert(edgeSum == randomMl.edges + randomMl.cutEdges && "Cut edges appear in both parts");
+    std::cout << "TEST 4 PASSED: Extracted parts with their halo" << std::endl;
+
+    // =========================================================================
+    // TEST 5: Edge cases
+    // =========================================================================
+    const Partition one = partitionGraph(random, {.parts = 1});
+    assert(one.cutEdges == 0 && one.sizes[0] == random.countVertices());
+    assert(partitionGraph(random, {.parts = 0}).parts == 1);
+    for (auto alg : algorithms) {
+        const Partition many = partitionGraph(twoCliques, {.parts = 50, .algorithm = alg});
+        checkPartition(twoCliques, many, 50, 0.03);
+        assert(many.cutEdges == twoCliques.countEdges() && "One vertex per part at most");
+    }
+    const Partition empty = partitionGraph(CSRGraph<int>(), {.parts = 4});
+    assert(empty.part.empty() && empty.cutRatio() == 0.0 && extractParts(CSRGraph<int>(), empty).size() == 4);
+
+    Graph<std::string> named;
+    for (int i = 0; i < 30; i++) named.addEdge(std::string("v").append(std::to_string(i)), std::string("v").append(std::to_string((i + 1) % 30)));
+    CSRGraph<std::string> ring(named);
+    for (auto alg : algorithms) {
+        const Partition p = partitionGraph(ring, {.parts = 3, .algorithm = alg});
+        checkPartition(ring, p, 3, 0.03);
+        const auto subs = extractParts(ring, p);
+        for (const auto& sub : subs) assert(sub.ghosts.size() >= 2 || p.cutEdges == 0);
+    }
+    assert(partitionGraph(ring, {.parts = 3}).cutEdges == 3 && "A ring splits into three arcs");
+    std::cout << "TEST 5 PASSED: Edge cases and string vertices" << std::endl;
+
+    std::cout << "\n=== All partitioning tests passed ===" << std::endl;
+    return 0;
+}
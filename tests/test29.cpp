@@ -0,0 +1,189 @@
+/**
+ * @file test29.cpp
+ * @brief Test suite for betweenness and closeness centrality
+ *
+ * This test validates:
+ * - Hand-checked values on a path, a star and a cycle
+ * - Exact betweenness against a brute-force count of shortest paths
+ * - Results do not depend on the thread count
+ * - Sampled betweenness: exact with all sources, close on the top vertices
+ * - Closeness on connected and disconnected graphs
+ * - Edge cases: empty graph, isolated vertices, string vertices
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include "graphlib/centrality.hpp"
+
+static bool near(double a, double b, double eps = 1e-9) {
+    return std::abs(a - b) <= eps * std::max(1.0, std::abs(b));
+}
+
+// Betweenness from all-pairs BFS distances and path counts, O(n^3)
+template<typename Vertex, typename Hash>
+static std::vector<double> bruteBetweenness(const CSRGraph<Vertex, Hash>& g) {
+    const std::size_t n = g.countVertices();
+    const std::uint32_t inf = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::vector<std::uint32_t>> dist(n, std::vector<std::uint32_t>(n, inf));
+    std::vector<std::vector<double>> paths(n, std::vector<double>(n, 0.0));
+    for (std::uint32_t s = 0; s < n; s++) {
+        std::vector<std::uint32_t> queue{s};
+        dist[s][s] = 0;
+        paths[s][s] = 1.0;
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            const std::uint32_t v = queue[head];
+            for (auto w : g.neighbors(v)) {
+                if (dist[s][w] == inf) {
+                    dist[s][w] = dist[s][v] + 1;
+                    queue.push_back(w);
+                }
+                if (dist[s][w] == dist[s][v] + 1) paths[s][w] += paths[s][v];
+            }
+        }
+    }
+    std::vector<double> bc(n, 0.0);
+    for (std::uint32_t s = 0; s < n; s++) {
+        for (std::uint32_t t = s + 1; t < n; t++) {
+            if (dist[s][t] == inf) continue;
+            for (std::uint32_t v = 0; v < n; v++) {
+                if (v != s && v != t && dist[s][v] != inf && dist[v][t] != inf && dist[s][v] + dist[v][t] == dist[s][t]) {
+                    bc[v] += paths[s][v] * paths[v][t] / paths[s][t];
+                }
+            }
+        }
+    }
+    return bc;
+}
+
+int main() {
+    // =========================================================================
+    // TEST 1: Path, star and cycle
+    // =========================================================================
+    Graph<int> pathGraph;
+    for (int i = 0; i < 4; i++) pathGraph.addEdge(i, i + 1);
+    CSRGraph<int> path(pathGraph);
+    const auto pathBc = betweennessCentrality(path);
+    const double pathExpected[] = {0, 3, 4, 3, 0};
+    for (int i = 0; i < 5; i++) assert(near(pathBc[path.id(i)], pathExpected[i]));
+    const auto pathCc = closenessCentrality(path);
+    assert(near(pathCc[path.id(2)], 4.0 / 6) && near(pathCc[path.id(0)], 4.0 / 10));
+
+    Graph<int> starGraph;
+    for (int i = 1; i <= 6; i++) starGraph.addEdge(0, i);
+    CSRGraph<int> star(starGraph);
+    const auto starBc = betweennessCentrality(star);
+    assert(near(starBc[star.id(0)], 15.0) && "All 6 * 5 / 2 leaf pairs go through the hub");
+    for (int i = 1; i <= 6; i++) assert(near(starBc[star.id(i)], 0.0));
+    assert(near(closenessCentrality(star)[star.id(0)], 1.0));
+
+    Graph<int> cycleGraph;
+    for (int i = 0; i < 6; i++) cycleGraph.addEdge(i, (i + 1) % 6);
+    CSRGraph<int> cycle(cycleGraph);
+    const auto cycleBc = betweennessCentrality(cycle);
+    const auto cycleCc = closenessCentrality(cycle);
+    for (int i = 0; i < 6; i++) {
+        // Neighbors at distance 2 (2 pairs, 1 path each) and the opposite vertex (2 pairs, half the paths)
+        assert(near(cycleBc[cycle.id(i)], 2.0) && near(cycleCc[cycle.id(i)], 5.0 / 9));
+    }
+    std::cout << "TEST 1 PASSED: Path, star and cycle" << std::endl;
+
+    // =========================================================================
+    // TEST 2: Exact betweenness against brute force
+    // =========================================================================
+    graphlib::Xoshiro256 rng(29);
+    for (int round = 0; round < 20; round++) {
+        const std::uint32_t n = 20 + 6 * static_cast<std::uint32_t>(round);
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+        for (std::uint32_t e = 0; e < n + n * (round % 4) / 2; e++) {
+            edges.emplace_back(static_cast<std::uint32_t>(graphlib::boundedRandom(rng, n)),
+                               static_cast<std::uint32_t>(graphlib::boundedRandom(rng, n)));
+        }
+        const auto g = CSRGraph<int>::fromEdgeList(n, edges);
+        const auto expected = bruteBetweenness(g);
+        const auto bc = betweennessCentrality(g, 1);
+        for (std::uint32_t v = 0; v < n; v++) assert(near(bc[v], expected[v]));
+    }
+    std::cout << "TEST 2 PASSED: Exact betweenness matches brute force" << std::endl;
+
+    // =========================================================================
+    // TEST 3: Thread count does not change the result
+    // =========================================================================
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> randomEdges;
+    for (int e = 0; e < 6000; e++) {
+        randomEdges.emplace_back(static_cast<std::uint32_t>(graphlib::boundedRandom(rng, 2000)),
+                                 static_cast<std::uint32_t>(graphlib::boundedRandom(rng, 2000)));
+    }
+    const auto random = CSRGraph<int>::fromEdgeList(2000, randomEdges);
+    const auto exact = betweennessCentrality(random, 1);
+    const auto closeness = closenessCentrality(random, 1);
+    for (std::size_t threads : {2, 3, 8}) {
+        const auto bc = betweennessCentrality(random, threads);
+        const auto cc = closenessCentrality(random, threads);
+        for (std::size_t v = 0; v < exact.size(); v++) assert(near(bc[v], exact[v]) && cc[v] == closeness[v]);
+    }
+    std::cout << "TEST 3 PASSED: Same result on 1, 2, 3 and 8 threads" << std::endl;
+
+    // =========================================================================
+    // TEST 4: Sampled betweenness
+    // =========================================================================
+    const auto all = approximateBetweenness(random, random.countVertices(), 5);
+    for (std::size_t v = 0; v < exact.size(); v++) assert(near(all[v], exact[v]));
+    assert(approximateBetweenness(random, 300, 5) == approximateBetweenness(random, 300, 5) && "Same seed, same sample");
+
+    std::vector<std::uint32_t> byExact(exact.size());
+    for (std::uint32_t v = 0; v < byExact.size(); v++) byExact[v] = v;
+    std::sort(byExact.begin(), byExact.end(), [&](std::uint32_t a, std::uint32_t b) { return exact[a] > exact[b]; });
+    const auto sampled = approximateBetweenness(random, 500, 7, 2);
+    double exactSum = 0, sampledSum = 0;
+    for (std::size_t i = 0; i < 20; i++) {
+        const std::uint32_t v = byExact[i];
+        assert(std::abs(sampled[v] - exact[v]) < 0.3 * exact[v] && "Top vertices are estimated within 30%");
+    }
+    for (std::size_t v = 0; v < exact.size(); v++) {
+        exactSum += exact[v];
+        sampledSum += sampled[v];
+    }
+    assert(std::abs(sampledSum - exactSum) < 0.05 * exactSum && "Total betweenness is estimated within 5%");
+    assert(approximateBetweenness(random, 0).size() == random.countVertices());
+    std::cout << "TEST 4 PASSED: Sampled betweenness converges to the exact values" << std::endl;
+
+    // =========================================================================
+    // TEST 5: Closeness on disconnected graphs
+    // =========================================================================
+    Graph<int> split;
+    split.addEdge(0, 1);
+    split.addEdge(1, 2);
+    split.addEdge(10, 11);
+    split.addVertex(20);
+    CSRGraph<int> parts(split);
+    const auto cc = closenessCentrality(parts);
+    // n = 6: the middle of the path reaches 2 vertices at distance 1
+    assert(near(cc[parts.id(1)], 2.0 / 2 * 2.0 / 5) && near(cc[parts.id(0)], 2.0 / 3 * 2.0 / 5));
+    assert(near(cc[parts.id(10)], 1.0 / 1 * 1.0 / 5) && cc[parts.id(20)] == 0.0);
+    const auto splitBc = betweennessCentrality(parts);
+    assert(near(splitBc[parts.id(1)], 1.0) && splitBc[parts.id(10)] == 0.0 && splitBc[parts.id(20)] == 0.0);
+    std::cout << "TEST 5 PASSED: Closeness on disconnected graphs" << std::endl;
+
+    // =========================================================================
+    // TEST 6: Edge cases
+    // =========================================================================
+    assert(betweennessCentrality(CSRGraph<int>()).empty() && closenessCentrality(CSRGraph<int>()).empty());
+    assert(approximateBetweenness(CSRGraph<int>(), 10).empty());
+    Graph<int> single;
+    single.addVertex(1);
+    assert(betweennessCentrality(CSRGraph<int>(single))[0] == 0.0 && closenessCentrality(CSRGraph<int>(single))[0] == 0.0);
+
+    Graph<std::string> named;
+    for (int i = 0; i < 5; i++) named.addEdge(std::string("hub"), std::string("v").append(std::to_string(i)));
+    named.addEdge(std::string("v0"), std::string("v1"));
+    CSRGraph<std::string> labelled(named);
+    const auto namedBc = betweennessCentrality(labelled, 4);
+    assert(near(namedBc[labelled.id("hub")], 9.0) && "10 leaf pairs, v0-v1 adjacent");
+    assert(near(closenessCentrality(labelled)[labelled.id("hub")], 1.0));
+    std::cout << "TEST 6 PASSED: Edge cases and string vertices" << std::endl;
+
+    std::cout << "\n=== All centrality tests passed ===" << std::endl;
+    return 0;
+}
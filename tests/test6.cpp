@@ -14,8 +14,13 @@
 #include <cassert>
 #include "graphlib.hpp"
 
+// Graph type under test; the Makefile also builds this file against DenseGraph
+#ifndef GRAPH_TYPE
+#define GRAPH_TYPE Graph<int>
+#endif
+
 int main() {
-    Graph<int> g;
+    GRAPH_TYPE g;
 
     // =========================================================================
     // SETUP: Build a 4x3 grid graph
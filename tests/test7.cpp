@@ -0,0 +1,130 @@
+/**
+ * @file test7.cpp
+ * @brief Test suite for the CSR snapshot and neighborhood sampling
+ *
+ * This test validates:
+ * - CSRGraph mirrors the vertices, degrees and edges of the source Graph
+ * - CSRGraph::fromEdgeList drops self-loops and duplicate edges
+ * - sampleNeighbors returns distinct neighbors, all of them when k >= degree
+ * - sampleNeighbors is uniform over the neighbors
+ * - sampleKHop layers and edges are consistent with the fanouts
+ * - sampleKHopBatch is deterministic regardless of the thread count
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "graphlib/sampling.hpp"
+
+int main() {
+    // =========================================================================
+    // SETUP: A star with 100 leaves plus a path hanging from leaf "L0"
+    // =========================================================================
+    Graph<std::string> g;
+    for (int i = 0; i < 100; i++) g.addEdge("hub", std::string("L").append(std::to_string(i)));
+    g.addEdge("L0", "P1");
+    g.addEdge("P1", "P2");
+
+    CSRGraph<std::string> csr(g);
+
+    // =========================================================================
+    // TEST 1: CSR snapshot mirrors the graph
+    // =========================================================================
+    assert(csr.countVertices() == g.countVertices() && "Vertex counts should match");
+    assert(csr.countEdges() == g.countEdges() && "Edge counts should match");
+    assert(csr.maxDegree() == g.maxDegree() && "Max degrees should match");
+    assert(csr.id("missing") == CSRGraph<std::string>::npos && "Unknown vertex should map to npos");
+
+    for (const auto& v : g) {
+        auto id = csr.id(v);
+        assert(csr.vertex(id) == v && "id() and vertex() should be inverse");
+        assert(csr.degree(id) == g.degree(v) && "Degrees should match");
+        auto nbrs = csr.neighbors(id);
+        for (std::size_t k = 0; k < nbrs.size(); k++) {
+            assert(g.containsEdge(v, csr.vertex(nbrs[k])) && "CSR neighbor should be a graph neighbor");
+            assert((k == 0 || nbrs[k - 1] < nbrs[k]) && "Neighbor lists should be sorted");
+            assert(csr.target(csr.offset(id) + k) == nbrs[k] && "Slots should address neighbors");
+        }
+    }
+    assert(csr.containsEdge(csr.id("P1"), csr.id("P2")) && "Edge P1-P2 should exist");
+    assert(!csr.containsEdge(csr.id("hub"), csr.id("P2")) && "Edge hub-P2 should NOT exist");
+
+    // =========================================================================
+    // TEST 2: Building from an edge list
+    // =========================================================================
+    auto fromList = CSRGraph<int>::fromEdgeList(5, {{0, 1}, {1, 0}, {1, 2}, {2, 2}, {3, 4}, {0, 1}});
+    assert(fromList.countVertices() == 5 && "Edge list graph should have 5 vertices");
+    assert(fromList.countEdges() == 3 && "Duplicates and self-loops should be dropped");
+    assert(fromList.id(3) == 3 && "Edge list graphs use identity ids");
+    assert(fromList.id(7) == CSRGraph<int>::npos && "Out of range vertex should map to npos");
+    assert(fromList.degree(1) == 2 && fromList.degree(2) == 1 && "Degrees should ignore duplicates");
+
+    // =========================================================================
+    // TEST 3: Neighbor sampling returns distinct neighbors
+    // =========================================================================
+    NeighborSampler<std::string> sampler(csr);
+    graphlib::Xoshiro256 rng(42);
+    const auto hub = csr.id("hub");
+
+    for (std::size_t k : {1, 10, 70, 99}) {
+        auto picks = sampler.sampleNeighbors(hub, k, rng);
+        assert(picks.size() == k && "Should sample exactly k neighbors");
+        std::unordered_set<CSRGraph<std::string>::Id> distinct(picks.begin(), picks.end());
+        assert(distinct.size() == k && "Sampled neighbors should be distinct");
+        for (auto p : picks) assert(csr.containsEdge(hub, p) && "Sample should be a neighbor");
+    }
+
+    auto all = sampler.sampleNeighbors(csr.id("P1"), 5, rng);
+    assert(all.size() == 2 && "k >= degree should return every neighbor");
+
+    // =========================================================================
+    // TEST 4: Neighbor sampling is uniform
+    // =========================================================================
+    std::vector<int> hits(csr.countVertices(), 0);
+    const int rounds = 20000;
+    for (int r = 0; r < rounds; r++) {
+        for (auto p : sampler.sampleNeighbors(hub, 5, rng)) hits[p]++;
+    }
+    for (auto leaf : csr.neighbors(hub)) {
+        // Expected 20000 * 5 / 100 = 1000 hits per leaf
+        assert(hits[leaf] > 800 && hits[leaf] < 1200 && "Sampling should be close to uniform");
+    }
+
+    // =========================================================================
+    // TEST 5: k-hop sampling structure
+    // =========================================================================
+    std::vector<CSRGraph<std::string>::Id> seeds = {csr.id("P2")};
+    std::vector<std::size_t> fanouts = {1, 2, 2, 25};
+    auto sample = sampler.sampleKHop(seeds, fanouts, rng);
+
+    // P2 -> {P1} -> {L0, P2} -> {hub, P1} -> 25 leaves of the hub plus {L0, P2}
+    assert(sample.layers.size() == 5 && sample.edges.size() == 4 && "One layer per hop plus seeds");
+    assert(sample.layers[1] == std::vector<CSRGraph<std::string>::Id>{csr.id("P1")} && "Only neighbor of P2 is P1");
+    assert(sample.layers[2].size() == 2 && sample.layers[3].size() == 2 && "Small degrees are taken whole");
+    assert(sample.layers[4].size() >= 25 && sample.layers[4].size() <= 27 && "Hub contributes 25 leaves");
+    for (std::size_t h = 0; h < sample.edges.size(); h++) {
+        for (const auto& [src, dst] : sample.edges[h]) {
+            assert(csr.containsEdge(src, dst) && "Sampled pairs should be edges");
+            assert(std::binary_search(sample.layers[h + 1].begin(), sample.layers[h + 1].end(), dst)
+                   && "Sampled destinations should be in the next layer");
+        }
+    }
+
+    // =========================================================================
+    // TEST 6: Batched sampling is deterministic across thread counts
+    // =========================================================================
+    std::vector<std::vector<CSRGraph<std::string>::Id>> batches;
+    for (CSRGraph<std::string>::Id i = 0; i < csr.countVertices(); i += 7) batches.push_back({i});
+    std::vector<std::size_t> twoHops = {25, 10};
+
+    auto single = sampler.sampleKHopBatch(batches, twoHops, 7, 1);
+    auto multi = sampler.sampleKHopBatch(batches, twoHops, 7, 4);
+    assert(single.size() == batches.size() && "One sample per batch");
+    for (std::size_t b = 0; b < batches.size(); b++) {
+        assert(single[b].layers == multi[b].layers && "Batch results should not depend on threads");
+        assert(single[b].edges == multi[b].edges && "Batch results should not depend on threads");
+    }
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
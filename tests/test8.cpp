@@ -0,0 +1,107 @@
+/**
+ * @file test8.cpp
+ * @brief Test suite for uniform and node2vec random walks
+ *
+ * This test validates:
+ * - Every step of a walk follows an edge of the graph
+ * - Walks reaching a vertex without neighbors are padded with npos
+ * - Walks are deterministic regardless of the thread count
+ * - Small p makes node2vec walks return to the previous vertex
+ * - Small q makes node2vec walks move away from the previous vertex
+ */
+
+#include <iostream>
+#include <cassert>
+#include "graphlib/walks.hpp"
+
+int main() {
+    using Id = CSRGraph<int>::Id;
+
+    // =========================================================================
+    // SETUP: 10x10 grid (vertex 10 * x + y) plus an isolated vertex 500
+    // =========================================================================
+    Graph<int> g;
+    for (int x = 0; x < 10; x++) {
+        for (int y = 0; y < 10; y++) {
+            if (x < 9) g.addEdge(10 * x + y, 10 * (x + 1) + y);
+            if (y < 9) g.addEdge(10 * x + y, 10 * x + y + 1);
+        }
+    }
+    g.addVertex(500);
+
+    CSRGraph<int> csr(g);
+    RandomWalker<int> walker(csr);
+    const std::size_t length = 20;
+
+    std::vector<Id> starts;
+    for (int v = 0; v < 100; v++) starts.push_back(csr.id(v));
+
+    // =========================================================================
+    // TEST 1: Uniform walks follow edges
+    // =========================================================================
+    auto walks = walker.uniformWalks(starts, length, 1);
+    assert(walks.size() == starts.size() * length && "Output should hold every walk");
+    for (std::size_t w = 0; w < starts.size(); w++) {
+        assert(walks[w * length] == starts[w] && "Walk should begin at its start vertex");
+        for (std::size_t s = 1; s < length; s++) {
+            assert(csr.containsEdge(walks[w * length + s - 1], walks[w * length + s]) && "Steps should follow edges");
+        }
+    }
+
+    // =========================================================================
+    // TEST 2: Dead ends are padded with npos
+    // =========================================================================
+    std::vector<Id> isolated = {csr.id(500)};
+    std::vector<Id> buffer(length, 0);
+    walker.uniformWalks(isolated, length, buffer, 1);
+    assert(buffer[0] == csr.id(500) && "Walk should begin at the isolated vertex");
+    for (std::size_t s = 1; s < length; s++) {
+        assert(buffer[s] == RandomWalker<int>::npos && "Dead end should be padded with npos");
+    }
+
+    // =========================================================================
+    // TEST 3: Walks do not depend on the thread count
+    // =========================================================================
+    std::vector<Id> manyStarts;
+    for (int r = 0; r < 50; r++) manyStarts.insert(manyStarts.end(), starts.begin(), starts.end());
+    assert(walker.uniformWalks(manyStarts, length, 9, 1) == walker.uniformWalks(manyStarts, length, 9, 4)
+           && "Uniform walks should be identical across thread counts");
+    assert(walker.node2vecWalks(manyStarts, length, {0.5, 2.0}, 9, 1)
+           == walker.node2vecWalks(manyStarts, length, {0.5, 2.0}, 9, 4)
+           && "node2vec walks should be identical across thread counts");
+
+    // =========================================================================
+    // TEST 4: node2vec return parameter p
+    // =========================================================================
+    auto returnRate = [&](const std::vector<Id>& res) {
+        std::size_t returns = 0, steps = 0;
+        for (std::size_t w = 0; w < manyStarts.size(); w++) {
+            for (std::size_t s = 2; s < length; s++) {
+                returns += res[w * length + s] == res[w * length + s - 2];
+                steps++;
+            }
+        }
+        return static_cast<double>(returns) / steps;
+    };
+
+    auto biased = walker.node2vecWalks(manyStarts, length, {0.01, 1.0}, 3);
+    auto uniform = walker.uniformWalks(manyStarts, length, 3);
+    assert(returnRate(biased) > 0.9 && "Small p should make walks backtrack");
+    assert(returnRate(uniform) < 0.4 && "Uniform walks on a grid backtrack about 1/3 of the time");
+
+    // =========================================================================
+    // TEST 5: node2vec in-out parameter q
+    // =========================================================================
+    // On a grid no neighbor of cur is also a neighbor of prev, so with a large
+    // 1/q every non-returning move is strongly preferred
+    auto outward = walker.node2vecWalks(manyStarts, length, {1.0, 0.01}, 3);
+    assert(returnRate(outward) < 0.01 && "Small q should make walks move outward");
+    for (std::size_t w = 0; w < manyStarts.size(); w++) {
+        for (std::size_t s = 1; s < length; s++) {
+            assert(csr.containsEdge(outward[w * length + s - 1], outward[w * length + s]) && "Steps should follow edges");
+        }
+    }
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
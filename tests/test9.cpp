@@ -0,0 +1,117 @@
+/**
+ * @file test9.cpp
+ * @brief Test suite for the landmark and pruned landmark labeling distance oracles
+ *
+ * This test validates:
+ * - Landmark bounds always enclose the BFS distance from Graph::distance
+ * - Landmark bounds are exact when one endpoint is a landmark
+ * - Disconnected and missing vertices are reported as std::nullopt
+ * - Pruned landmark labeling returns exactly Graph::distance for every pair
+ * - Paths longer than 65535 hops are neither truncated nor reported as disconnected
+ */
+
+#include <iostream>
+#include <cassert>
+#include <bit>
+#include "graphlib/distance_oracle.hpp"
+
+int main() {
+    // =========================================================================
+    // SETUP: Sparse random graph on 300 vertices plus a separate triangle
+    // =========================================================================
+    Graph<int> g;
+    graphlib::Xoshiro256 rng(5);
+    for (int i = 1; i < 300; i++) {
+        g.addEdge(i, static_cast<int>(graphlib::boundedRandom(rng, i)));  // Random spanning tree
+    }
+    for (int e = 0; e < 150; e++) {
+        g.addEdge(static_cast<int>(graphlib::boundedRandom(rng, 300)), static_cast<int>(graphlib::boundedRandom(rng, 300)));
+    }
+    g.addEdge(1000, 1001);
+    g.addEdge(1001, 1002);
+    g.addEdge(1002, 1000);
+
+    CSRGraph<int> csr(g);
+
+    // =========================================================================
+    // TEST 1: Landmark bounds enclose the exact distance
+    // =========================================================================
+    for (auto selection : {LandmarkOracle<int>::Selection::HighestDegree, LandmarkOracle<int>::Selection::Random}) {
+        LandmarkOracle<int> oracle(csr, 8, selection, 3);
+        assert(oracle.landmarks().size() == 8 && "Should pick 8 landmarks");
+
+        for (int u = 0; u < 300; u += 7) {
+            for (int v = 0; v < 300; v += 5) {
+                auto exact = g.distance(u, v);
+                auto bounds = oracle.approxDistance(u, v);
+                assert(exact && bounds && "Vertices of the random graph are connected");
+                assert(bounds->lower <= *exact && "Lower bound should not exceed the distance");
+                if (bounds->upper) assert(*exact <= *bounds->upper && "Upper bound should not be below the distance");
+            }
+        }
+
+        // Exact when an endpoint is a landmark
+        for (auto l : oracle.landmarks()) {
+            const int lv = csr.vertex(l);
+            if (lv >= 1000) continue;
+            for (int v = 0; v < 300; v += 11) {
+                auto bounds = oracle.approxDistance(lv, v);
+                assert(bounds->upper && *bounds->upper == *g.distance(lv, v) && "Landmark distances should be exact");
+            }
+        }
+    }
+
+    // =========================================================================
+    // TEST 2: Disconnected and missing vertices
+    // =========================================================================
+    LandmarkOracle<int> oracle(csr, 4);
+    assert(!oracle.approxDistance(0, 1001).has_value() && "Different components should be detected");
+    assert(!oracle.approxDistance(0, 5000).has_value() && "Missing vertex should return nullopt");
+    assert(oracle.approxDistance(42, 42)->upper == 0 && "Self distance is 0");
+
+    // =========================================================================
+    // TEST 3: Pruned landmark labeling is exact on every pair
+    // =========================================================================
+    PrunedLandmarkLabeling<int> pll(csr);
+    for (const auto& u : g) {
+        for (const auto& v : g) {
+            assert(pll.distance(u, v) == g.distance(u, v) && "PLL should match BFS distance");
+        }
+    }
+    assert(!pll.distance(0, 5000).has_value() && "Missing vertex should return nullopt");
+    assert(pll.averageLabelSize() > 0 && pll.memoryBytes() > 0 && "Labels should be populated");
+
+    // =========================================================================
+    // TEST 4: Paths longer than 65535 hops
+    // =========================================================================
+    // Path vertex i gets countr_zero(i) pendant leaves, so the degree order
+    // bisects the path recursively and PLL labels stay logarithmic
+    const int length = 70000;
+    Graph<int> longPath;
+    int leaf = length;
+    for (int i = 0; i + 1 < length; i++) longPath.addEdge(i, i + 1);
+    for (int i = 1; i < length; i++) {
+        for (int c = 0; c < std::countr_zero(static_cast<unsigned>(i)); c++) longPath.addEdge(i, leaf++);
+    }
+    CSRGraph<int> longCsr(longPath);
+
+    LandmarkOracle<int> farOracle(longCsr, 3);
+    assert(longCsr.vertex(farOracle.landmarks()[0]) == 65536 && "Highest degree is the middle of the path");
+    for (int u = 0; u < length; u += 6997) {
+        for (int v : {0, 1, 65536, length - 1}) {
+            auto bounds = farOracle.approxDistance(u, v);
+            const int exact = u > v ? u - v : v - u;
+            assert(bounds && "Vertices more than 65534 hops from a landmark are still connected");
+            assert(bounds->lower <= exact && (!bounds->upper || exact <= *bounds->upper));
+        }
+    }
+
+    PrunedLandmarkLabeling<int> farPll(longCsr);
+    assert(farPll.distance(0, length - 1) == length - 1 && "Distances beyond 16 bits are exact");
+    assert(farPll.distance(0, 65536) == 65536 && farPll.distance(1, 65537) == 65536);
+    assert(farPll.distance(leaf - 1, 2) == longPath.distance(leaf - 1, 2));
+    for (int u = 0; u < length; u += 4999) assert(farPll.distance(u, 3) == (u > 3 ? u - 3 : 3 - u));
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}